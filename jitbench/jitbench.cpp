@@ -0,0 +1,261 @@
+// jitbench.cpp : Runs the benchmark workloads and reports one JSON object per
+// workload on standard output.
+//
+
+#include "workloads.h"
+
+#include "assembler_x86.h"
+#include "jitter6502.h"
+#include "jitvm.h"
+#include "perfmap.h"
+#include "systemmemory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using std::cerr;
+using std::copy;
+using std::cout;
+using std::endl;
+using std::find;
+using std::fixed;
+using std::hex;
+using std::max;
+using std::min;
+using std::runtime_error;
+using std::setfill;
+using std::setprecision;
+using std::setw;
+using std::stoul;
+using std::string;
+using std::vector;
+
+using Clock = std::chrono::steady_clock;
+using oss = std::ostringstream;
+
+namespace
+{
+    const uint32_t CODE_CACHE_SIZE = 16 * 1024 * 1024;
+
+    // Every workload finishes far inside this; running into it means the
+    // guest has lost its way.
+    const uint64_t CYCLE_LIMIT = 4000000000ull;
+
+    struct Result
+    {
+        string status;
+        string error;
+        uint64_t instructions;
+        uint64_t cycles;
+        double seconds;
+        JitStats stats;
+    };
+
+    auto usage()->void
+    {
+        cerr
+            << "usage: jitbench [--repeat N] [--list] [--perf map|jitdump] [WORKLOAD...]\n"
+            << "\n"
+            << "  --repeat N          run each workload N times and report the fastest (default 3)\n"
+            << "  --list              list the workloads and exit\n"
+            << "  --perf map|jitdump  describe generated code to perf, as jitrun does\n";
+    }
+
+    auto jsonString(const string &text)->string
+    {
+        auto quoted = string{ "\"" };
+        for (auto ch : text) {
+            if (ch == '"' || ch == '\\') {
+                quoted += '\\';
+            }
+            quoted += ch;
+        }
+        return quoted + "\"";
+    }
+
+    // Lays the workload's segments out in one ROM image ending at the top of memory
+    auto romImage(const Workload &workload, TargetAddress *base)->vector<uint8_t>
+    {
+        auto lowest = TargetAddress{ 0xFFFF };
+        for (auto &segment : workload.segments) {
+            lowest = min(lowest, segment.base);
+        }
+        *base = static_cast<TargetAddress>(lowest & ~(SystemMemory::PAGE_SIZE - 1));
+
+        auto image = vector<uint8_t>(SystemMemory::SIZE - *base, 0xFF);
+        for (auto &segment : workload.segments) {
+            copy(segment.bytes, segment.bytes + segment.size, begin(image) + (segment.base - *base));
+        }
+        return image;
+    }
+
+    auto runWorkload(const Workload &workload)->Result
+    {
+        JitVM vm(CODE_CACHE_SIZE);
+        AssemblerX86 assembler(&vm);
+        SystemMemory memory;
+
+        auto romBase = TargetAddress{};
+        memory.installROM(romBase, romImage(workload, &romBase));
+        memory.installRAM(0, Workload::ROM_LIMIT);
+
+        Jitter6502 jitter(&vm, &assembler, &memory);
+        jitter.reset();
+
+        auto result = Result{};
+        auto start = Clock::now();
+        try {
+            switch (jitter.run(CYCLE_LIMIT)) {
+            case Trapped:
+                result.status = jitter.context().cpu.pc == workload.pass ? "pass" : "fail";
+                break;
+
+            case InvalidOpcode: {
+                auto error = oss{};
+                error << "invalid opcode at $" << setw(4) << setfill('0') << hex << std::uppercase << jitter.context().cpu.pc;
+                result.status = "error";
+                result.error = error.str();
+                break;
+            }
+
+            case CycleLimitReached:
+                result.status = "timeout";
+                break;
+            }
+        }
+        catch (const runtime_error &err) {
+            result.status = "error";
+            result.error = err.what();
+        }
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        auto &context = jitter.context();
+        result.instructions = context.instructions;
+        result.cycles = context.cpu.cycles;
+        result.stats = jitter.stats();
+        return result;
+    }
+
+    // Writes one JSON object for the workload. guest_mips is guest instructions
+    // per second of wall time, translation included; translation_bytes_per_ms
+    // is guest code translated per millisecond spent in the translator; and
+    // code_ratio is native bytes generated per guest byte translated.
+    //
+    auto report(const Workload &workload, const Result &result, unsigned repeat)->void
+    {
+        auto &stats = result.stats;
+        auto ratio = [](double num, double den) {
+            return den > 0 ? num / den : 0.0;
+        };
+        auto translationMs = stats.compileNanoseconds / 1e6;
+
+        auto line = oss{};
+        line << fixed << setprecision(3)
+            << "{\"workload\":" << jsonString(workload.name)
+            << ",\"status\":" << jsonString(result.status);
+        if (!result.error.empty()) {
+            line << ",\"error\":" << jsonString(result.error);
+        }
+        line
+            << ",\"repeat\":" << repeat
+            << ",\"seconds\":" << setprecision(6) << result.seconds << setprecision(3)
+            << ",\"instructions\":" << result.instructions
+            << ",\"cycles\":" << result.cycles
+            << ",\"guest_mips\":" << ratio(result.instructions, result.seconds * 1e6)
+            << ",\"dispatches\":" << stats.dispatches
+            << ",\"instructions_per_dispatch\":" << ratio(result.instructions, stats.dispatches)
+            << ",\"blocks\":" << stats.blocksCompiled
+            << ",\"guest_bytes\":" << stats.guestBytesCompiled
+            << ",\"native_bytes\":" << stats.nativeBytesEmitted
+            << ",\"code_ratio\":" << ratio(stats.nativeBytesEmitted, stats.guestBytesCompiled)
+            << ",\"translation_ms\":" << translationMs
+            << ",\"translation_bytes_per_ms\":" << ratio(stats.guestBytesCompiled, translationMs)
+            << "}";
+        cout << line.str() << endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    auto repeat = 3u;
+    auto list = false;
+    auto perf = 0u;
+    auto names = vector<string>{};
+
+    for (auto i = 1; i < argc; i++) {
+        auto arg = string{ argv[i] };
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = max(1u, static_cast<unsigned>(stoul(argv[++i])));
+        }
+        else if (arg == "--list") {
+            list = true;
+        }
+        else if (arg == "--perf" && i + 1 < argc) {
+            auto format = string{ argv[++i] };
+            if (format != "map" && format != "jitdump") {
+                usage();
+                return 2;
+            }
+            perf = format == "jitdump" ? PerfMap::MapFormat | PerfMap::JitDumpFormat : PerfMap::MapFormat;
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            usage();
+            return 2;
+        }
+        else {
+            names.push_back(arg);
+        }
+    }
+
+    auto selected = vector<Workload>{};
+    for (auto &workload : workloads()) {
+        if (names.empty() || find(begin(names), end(names), workload.name) != end(names)) {
+            selected.push_back(workload);
+        }
+    }
+    if (selected.size() < names.size()) {
+        cerr << "jitbench: unknown workload; use --list to see them" << endl;
+        return 2;
+    }
+
+    if (list) {
+        for (auto &workload : selected) {
+            cout << workload.name << endl;
+        }
+        return 0;
+    }
+
+    if (perf != 0) {
+        try {
+            PerfMap::enable(perf);
+        }
+        catch (const runtime_error &err) {
+            cerr << "jitbench: " << err.what() << endl;
+            return 1;
+        }
+    }
+
+    // Each repetition runs in a fresh machine, so translation is included
+    // every time; the fastest run is the least disturbed by the host.
+    auto failed = false;
+    for (auto &workload : selected) {
+        auto best = runWorkload(workload);
+        for (auto i = 1u; i < repeat && best.status == "pass"; i++) {
+            auto result = runWorkload(workload);
+            if (result.status != "pass" || result.seconds < best.seconds) {
+                best = result;
+            }
+        }
+
+        report(workload, best, repeat);
+        failed |= best.status != "pass";
+    }
+
+    return failed ? 1 : 0;
+}
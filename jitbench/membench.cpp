@@ -0,0 +1,207 @@
+// membench.cpp : Measures SystemMemory access throughput by kind of page and
+// reports one JSON object per case on standard output.
+//
+
+#include "systemmemory.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::fixed;
+using std::max;
+using std::min;
+using std::setprecision;
+using std::stoul;
+using std::string;
+using std::vector;
+
+using Clock = std::chrono::steady_clock;
+using oss = std::ostringstream;
+
+namespace
+{
+    // Each case reads this many bytes per run
+    const uint64_t ACCESSES = 16 * 1024 * 1024;
+
+    struct Case
+    {
+        const char *name;
+        const char *description;
+
+        // Sets up memory and returns the addresses to sweep
+        vector<TargetAddress>(*install)(SystemMemory *memory);
+
+        // Call each address's device binding, looked up beforehand, as
+        // translated code does, rather than going through readByte
+        bool bound;
+    };
+
+    auto sweep(TargetAddress base, uint32_t length)->vector<TargetAddress>
+    {
+        auto addresses = vector<TargetAddress>{};
+        for (auto offset = 0u; offset < length; offset++) {
+            addresses.push_back(static_cast<TargetAddress>(base + offset));
+        }
+        return addresses;
+    }
+
+    auto installRAMPages(SystemMemory *memory)->vector<TargetAddress>
+    {
+        memory->installRAM(0x0000, 0x1000);
+        return sweep(0x0000, 0x1000);
+    }
+
+    auto installROMPages(SystemMemory *memory)->vector<TargetAddress>
+    {
+        memory->installROM(0xF000, vector<uint8_t>(0x1000, 0xEA));
+        return sweep(0xF000, 0x1000);
+    }
+
+    // One page split between ROM and RAM, as around a small boot ROM
+    auto installMixedPage(SystemMemory *memory)->vector<TargetAddress>
+    {
+        memory->installROM(0xC000, vector<uint8_t>(0x80, 0xEA));
+        memory->installRAM(0xC080, 0x80);
+        return sweep(0xC000, 0x100);
+    }
+
+    // Sixteen split pages read in turn, so consecutive accesses land on
+    // different pages
+    auto installMixedPages(SystemMemory *memory)->vector<TargetAddress>
+    {
+        auto addresses = vector<TargetAddress>{};
+        for (auto page = 0; page < 16; page++) {
+            auto base = static_cast<TargetAddress>(0x4000 + page * 0x200);
+            memory->installROM(base, vector<uint8_t>(0x80, 0xEA));
+            memory->installRAM(static_cast<TargetAddress>(base + 0x80), 0x80);
+        }
+        for (auto offset = 0; offset < 0x100; offset++) {
+            for (auto page = 0; page < 16; page++) {
+                addresses.push_back(static_cast<TargetAddress>(0x4000 + page * 0x200 + offset));
+            }
+        }
+        return addresses;
+    }
+
+    // A status register, about the simplest device there is
+    class StatusRegister : public SystemMemory::IOHandler
+    {
+    public:
+        virtual auto read(TargetAddress addr)->uint8_t override
+        {
+            return value_;
+        }
+
+        virtual auto write(TargetAddress addr, uint8_t data)->void override
+        {
+            value_ = data;
+        }
+
+    private:
+        uint8_t value_ = 0x80;
+    };
+
+    StatusRegister statusRegister;
+
+    auto installVirtualDevice(SystemMemory *memory)->vector<TargetAddress>
+    {
+        memory->installIO(0xD000, 0x10, &statusRegister);
+        return sweep(0xD000, 0x10);
+    }
+
+    auto installStaticDevice(SystemMemory *memory)->vector<TargetAddress>
+    {
+        memory->installStaticIO(0xD000, 0x10, &statusRegister);
+        return sweep(0xD000, 0x10);
+    }
+
+    const Case CASES[] = {
+        { "ram", "whole RAM pages", installRAMPages, false },
+        { "rom", "whole ROM pages", installROMPages, false },
+        { "mixed", "one page of ROM and RAM", installMixedPage, false },
+        { "mixed_pages", "sixteen pages of ROM and RAM, interleaved", installMixedPages, false },
+        { "io_virtual", "a status register through the IOHandler interface", installVirtualDevice, false },
+        { "io_static", "a status register installed by type", installStaticDevice, false },
+        { "io_virtual_bound", "io_virtual, calling the device binding directly", installVirtualDevice, true },
+        { "io_static_bound", "io_static, calling the device binding directly", installStaticDevice, true },
+    };
+
+    auto runCase(const Case &test, uint32_t *checksum)->double
+    {
+        SystemMemory memory;
+        auto addresses = test.install(&memory);
+
+        auto devices = vector<const SystemMemory::DeviceBinding *>{};
+        for (auto address : addresses) {
+            devices.push_back(memory.deviceAt(address));
+        }
+
+        auto sum = uint32_t{ 0 };
+        auto start = Clock::now();
+        for (auto done = uint64_t{ 0 }; done < ACCESSES; done += addresses.size()) {
+            if (test.bound) {
+                for (auto i = size_t{ 0 }; i < addresses.size(); i++) {
+                    sum += devices[i]->read(devices[i]->device, addresses[i]);
+                }
+            }
+            else {
+                for (auto address : addresses) {
+                    sum += memory.readByte(address);
+                }
+            }
+        }
+        auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // Keeps the reads from being optimised away
+        *checksum += sum;
+        return seconds;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    auto repeat = 5u;
+    for (auto i = 1; i < argc; i++) {
+        auto arg = string{ argv[i] };
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = max(1u, static_cast<unsigned>(stoul(argv[++i])));
+        }
+        else {
+            cerr
+                << "usage: membench [--repeat N]\n"
+                << "\n"
+                << "  --repeat N  run each case N times and report the fastest (default 5)\n";
+            return 2;
+        }
+    }
+
+    auto checksum = uint32_t{ 0 };
+    for (auto &test : CASES) {
+        auto best = runCase(test, &checksum);
+        for (auto i = 1u; i < repeat; i++) {
+            best = min(best, runCase(test, &checksum));
+        }
+
+        auto line = oss{};
+        line << fixed << setprecision(3)
+            << "{\"case\":\"" << test.name << "\""
+            << ",\"description\":\"" << test.description << "\""
+            << ",\"reads\":" << ACCESSES
+            << ",\"seconds\":" << setprecision(6) << best << setprecision(3)
+            << ",\"mreads_per_second\":" << ACCESSES / best / 1e6
+            << ",\"ns_per_read\":" << best * 1e9 / ACCESSES
+            << "}";
+        cout << line.str() << endl;
+    }
+
+    cerr << "checksum " << checksum << endl;
+    return 0;
+}
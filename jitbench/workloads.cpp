@@ -0,0 +1,15 @@
+#include "workloads.h"
+
+using std::vector;
+
+auto workloads()->vector<Workload>
+{
+    return vector<Workload>{
+        sieveWorkload(),
+        crcWorkload(),
+        memcpyWorkload(),
+        bcdWorkload(),
+        functionalWorkload(),
+        recursionWorkload(),
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// A run of guest code or data placed at base
+struct WorkloadSegment
+{
+    TargetAddress base;
+    const uint8_t *bytes;
+    size_t size;
+};
+
+//
+// A workload is a self checking 6502 program. Its segments make up a ROM at
+// the top of memory, RAM is installed below ROM_LIMIT, and it finishes by
+// jumping to itself: at pass if its results were right, anywhere else if not.
+//
+struct Workload
+{
+    enum { ROM_LIMIT = 0x8000 };
+
+    const char *name;
+    std::vector<WorkloadSegment> segments;
+    TargetAddress pass;
+};
+
+auto workloads()->std::vector<Workload>;
+
+auto bcdWorkload()->Workload;
+auto crcWorkload()->Workload;
+auto functionalWorkload()->Workload;
+auto memcpyWorkload()->Workload;
+auto recursionWorkload()->Workload;
+auto sieveWorkload()->Workload;
@@ -0,0 +1,124 @@
+// bcd.cpp : Decimal arithmetic workload.
+//
+
+#include "../workloads.h"
+
+//
+// Decimal mode arithmetic: add $0137 to an eight digit BCD accumulator
+// 10000 times, check it reads 01370000, then subtract it back to zero,
+// repeated ITERATIONS times.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // ITERATIONS = 4
+    // total = $00
+    // count = $04
+    // rounds = $06
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // F000 reset:  LDX #$FF
+        0x9A,                    // F002         TXS
+        0xD8,                    // F003         CLD
+        0xA9, 0x04,              // F004         LDA #ITERATIONS
+        0x85, 0x06,              // F006         STA rounds
+        0xA9, 0x00,              // F008 round:  LDA #0
+        0x85, 0x00,              // F00A         STA total
+        0x85, 0x01,              // F00C         STA total+1
+        0x85, 0x02,              // F00E         STA total+2
+        0x85, 0x03,              // F010         STA total+3
+        0x20, 0x7A, 0xF0,        // F012         JSR reload
+        0xF8,                    // F015         SED
+        0x18,                    // F016 add:    CLC
+        0xA5, 0x00,              // F017         LDA total
+        0x69, 0x37,              // F019         ADC #$37
+        0x85, 0x00,              // F01B         STA total
+        0xA5, 0x01,              // F01D         LDA total+1
+        0x69, 0x01,              // F01F         ADC #$01
+        0x85, 0x01,              // F021         STA total+1
+        0xA5, 0x02,              // F023         LDA total+2
+        0x69, 0x00,              // F025         ADC #0
+        0x85, 0x02,              // F027         STA total+2
+        0xA5, 0x03,              // F029         LDA total+3
+        0x69, 0x00,              // F02B         ADC #0
+        0x85, 0x03,              // F02D         STA total+3
+        0x20, 0x83, 0xF0,        // F02F         JSR countdown
+        0xD0, 0xE2,              // F032         BNE add
+        0xD8,                    // F034         CLD
+        0xA2, 0x03,              // F035         LDX #3
+        0xB5, 0x00,              // F037 check:  LDA total,X
+        0xDD, 0x90, 0xF0,        // F039         CMP expected,X
+        0xD0, 0x39,              // F03C         BNE fail
+        0xCA,                    // F03E         DEX
+        0x10, 0xF6,              // F03F         BPL check
+        0x20, 0x7A, 0xF0,        // F041         JSR reload
+        0xF8,                    // F044         SED
+                                 // subtract:
+        0x38,                    // F045         SEC
+        0xA5, 0x00,              // F046         LDA total
+        0xE9, 0x37,              // F048         SBC #$37
+        0x85, 0x00,              // F04A         STA total
+        0xA5, 0x01,              // F04C         LDA total+1
+        0xE9, 0x01,              // F04E         SBC #$01
+        0x85, 0x01,              // F050         STA total+1
+        0xA5, 0x02,              // F052         LDA total+2
+        0xE9, 0x00,              // F054         SBC #0
+        0x85, 0x02,              // F056         STA total+2
+        0xA5, 0x03,              // F058         LDA total+3
+        0xE9, 0x00,              // F05A         SBC #0
+        0x85, 0x03,              // F05C         STA total+3
+        0x90, 0x17,              // F05E         BCC underflow
+        0x20, 0x83, 0xF0,        // F060         JSR countdown
+        0xD0, 0xE0,              // F063         BNE subtract
+        0xD8,                    // F065         CLD
+        0xA5, 0x00,              // F066         LDA total
+        0x05, 0x01,              // F068         ORA total+1
+        0x05, 0x02,              // F06A         ORA total+2
+        0x05, 0x03,              // F06C         ORA total+3
+        0xD0, 0x07,              // F06E         BNE fail
+        0xC6, 0x06,              // F070         DEC rounds
+        0xD0, 0x94,              // F072         BNE round
+        0x4C, 0x74, 0xF0,        // F074 pass:   JMP pass
+                                 // underflow:
+        0x4C, 0x77, 0xF0,        // F077 fail:   JMP fail
+
+                                 // ; Sets the loop counter to 10000
+        0xA9, 0x10,              // F07A reload: LDA #<10000
+        0x85, 0x04,              // F07C         STA count
+        0xA9, 0x27,              // F07E         LDA #>10000
+        0x85, 0x05,              // F080         STA count+1
+        0x60,                    // F082         RTS
+
+                                 // ; Decrements the loop counter, returning Z set when it reaches zero. Runs
+                                 // ; in decimal mode, so sticks to instructions it does not affect.
+                                 // countdown:
+        0xA5, 0x04,              // F083         LDA count
+        0xD0, 0x02,              // F085         BNE low
+        0xC6, 0x05,              // F087         DEC count+1
+        0xC6, 0x04,              // F089 low:    DEC count
+        0xA5, 0x04,              // F08B         LDA count
+        0x05, 0x05,              // F08D         ORA count+1
+        0x60,                    // F08F         RTS
+
+                                 // expected:
+        0x00, 0x00, 0x37, 0x01,  // F090         .byte $00, $00, $37, $01
+    };
+
+    const uint8_t vectors[] = {
+        0x77, 0xF0, 0x00, 0xF0, 0x77, 0xF0, // FFFA         .word fail, reset, fail
+    };
+}
+
+auto bcdWorkload()->Workload
+{
+    return Workload{
+        "bcd",
+        {
+            { 0xF000, code, sizeof(code) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xF074,
+    };
+}
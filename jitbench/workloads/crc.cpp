@@ -0,0 +1,157 @@
+// crc.cpp : CRC-16 and CRC-32 workload.
+//
+
+#include "../workloads.h"
+
+//
+// Bitwise CRC-16/CCITT-FALSE and CRC-32 over a 1K pseudo random buffer,
+// repeated ITERATIONS times. Passes if both match the precomputed values.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // ITERATIONS = 10
+    // BUFFER = $2000
+    // ptr = $00
+    // pages = $02
+    // rounds = $03
+    // seed = $04
+    // crc16 = $10
+    // crc32 = $12
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // F000 reset:  LDX #$FF
+        0x9A,                    // F002         TXS
+        0xD8,                    // F003         CLD
+        0xA9, 0x00,              // F004         LDA #<BUFFER
+        0x85, 0x00,              // F006         STA ptr
+        0xA9, 0x20,              // F008         LDA #>BUFFER
+        0x85, 0x01,              // F00A         STA ptr+1
+        0xA2, 0x04,              // F00C         LDX #4
+        0xA0, 0x00,              // F00E         LDY #0
+        0xA9, 0x5A,              // F010         LDA #$5A
+                                 // generate:
+        0x85, 0x04,              // F012         STA seed                ; seed = seed * 5 + 1
+        0x0A,                    // F014         ASL A
+        0x0A,                    // F015         ASL A
+        0x18,                    // F016         CLC
+        0x65, 0x04,              // F017         ADC seed
+        0x18,                    // F019         CLC
+        0x69, 0x01,              // F01A         ADC #1
+        0x91, 0x00,              // F01C         STA (ptr),Y
+        0xC8,                    // F01E         INY
+        0xD0, 0xF1,              // F01F         BNE generate
+        0xE6, 0x01,              // F021         INC ptr+1
+        0xCA,                    // F023         DEX
+        0xD0, 0xEC,              // F024         BNE generate
+        0xA9, 0x0A,              // F026         LDA #ITERATIONS
+        0x85, 0x03,              // F028         STA rounds
+
+        0xA9, 0xFF,              // F02A round:  LDA #$FF
+        0x85, 0x10,              // F02C         STA crc16
+        0x85, 0x11,              // F02E         STA crc16+1
+        0xA9, 0x20,              // F030         LDA #>BUFFER
+        0x85, 0x01,              // F032         STA ptr+1
+        0xA9, 0x04,              // F034         LDA #4
+        0x85, 0x02,              // F036         STA pages
+        0xA0, 0x00,              // F038         LDY #0
+        0xB1, 0x00,              // F03A byte16: LDA (ptr),Y
+        0x45, 0x11,              // F03C         EOR crc16+1
+        0x85, 0x11,              // F03E         STA crc16+1
+        0xA2, 0x08,              // F040         LDX #8
+        0x06, 0x10,              // F042 bit16:  ASL crc16
+        0x26, 0x11,              // F044         ROL crc16+1
+        0x90, 0x0C,              // F046         BCC next16
+        0xA5, 0x11,              // F048         LDA crc16+1
+        0x49, 0x10,              // F04A         EOR #$10
+        0x85, 0x11,              // F04C         STA crc16+1
+        0xA5, 0x10,              // F04E         LDA crc16
+        0x49, 0x21,              // F050         EOR #$21
+        0x85, 0x10,              // F052         STA crc16
+        0xCA,                    // F054 next16: DEX
+        0xD0, 0xEB,              // F055         BNE bit16
+        0xC8,                    // F057         INY
+        0xD0, 0xE0,              // F058         BNE byte16
+        0xE6, 0x01,              // F05A         INC ptr+1
+        0xC6, 0x02,              // F05C         DEC pages
+        0xD0, 0xDA,              // F05E         BNE byte16
+
+        0xA9, 0xFF,              // F060         LDA #$FF
+        0x85, 0x12,              // F062         STA crc32
+        0x85, 0x13,              // F064         STA crc32+1
+        0x85, 0x14,              // F066         STA crc32+2
+        0x85, 0x15,              // F068         STA crc32+3
+        0xA9, 0x20,              // F06A         LDA #>BUFFER
+        0x85, 0x01,              // F06C         STA ptr+1
+        0xA9, 0x04,              // F06E         LDA #4
+        0x85, 0x02,              // F070         STA pages
+        0xB1, 0x00,              // F072 byte32: LDA (ptr),Y
+        0x45, 0x12,              // F074         EOR crc32
+        0x85, 0x12,              // F076         STA crc32
+        0xA2, 0x08,              // F078         LDX #8
+        0x46, 0x15,              // F07A bit32:  LSR crc32+3
+        0x66, 0x14,              // F07C         ROR crc32+2
+        0x66, 0x13,              // F07E         ROR crc32+1
+        0x66, 0x12,              // F080         ROR crc32
+        0x90, 0x18,              // F082         BCC next32
+        0xA5, 0x15,              // F084         LDA crc32+3
+        0x49, 0xED,              // F086         EOR #$ED
+        0x85, 0x15,              // F088         STA crc32+3
+        0xA5, 0x14,              // F08A         LDA crc32+2
+        0x49, 0xB8,              // F08C         EOR #$B8
+        0x85, 0x14,              // F08E         STA crc32+2
+        0xA5, 0x13,              // F090         LDA crc32+1
+        0x49, 0x83,              // F092         EOR #$83
+        0x85, 0x13,              // F094         STA crc32+1
+        0xA5, 0x12,              // F096         LDA crc32
+        0x49, 0x20,              // F098         EOR #$20
+        0x85, 0x12,              // F09A         STA crc32
+        0xCA,                    // F09C next32: DEX
+        0xD0, 0xDB,              // F09D         BNE bit32
+        0xC8,                    // F09F         INY
+        0xD0, 0xD0,              // F0A0         BNE byte32
+        0xE6, 0x01,              // F0A2         INC ptr+1
+        0xC6, 0x02,              // F0A4         DEC pages
+        0xD0, 0xCA,              // F0A6         BNE byte32
+
+        0xA2, 0x03,              // F0A8         LDX #3
+        0xB5, 0x12,              // F0AA check:  LDA crc32,X
+        0x49, 0xFF,              // F0AC         EOR #$FF
+        0xDD, 0xD3, 0xF0,        // F0AE         CMP expected+2,X
+        0xD0, 0x1B,              // F0B1         BNE fail
+        0xCA,                    // F0B3         DEX
+        0x10, 0xF4,              // F0B4         BPL check
+        0xA5, 0x10,              // F0B6         LDA crc16
+        0xCD, 0xD1, 0xF0,        // F0B8         CMP expected
+        0xD0, 0x11,              // F0BB         BNE fail
+        0xA5, 0x11,              // F0BD         LDA crc16+1
+        0xCD, 0xD2, 0xF0,        // F0BF         CMP expected+1
+        0xD0, 0x0A,              // F0C2         BNE fail
+        0xC6, 0x03,              // F0C4         DEC rounds
+        0xF0, 0x03,              // F0C6         BEQ pass
+        0x4C, 0x2A, 0xF0,        // F0C8         JMP round
+        0x4C, 0xCB, 0xF0,        // F0CB pass:   JMP pass
+        0x4C, 0xCE, 0xF0,        // F0CE fail:   JMP fail
+
+                                 // expected:
+        0x4E, 0x66, 0x30, 0x30, 0x7E, 0x76, // F0D1         .byte $4E, $66, $30, $30, $7E, $76
+    };
+
+    const uint8_t vectors[] = {
+        0xCE, 0xF0, 0x00, 0xF0, 0xCE, 0xF0, // FFFA         .word fail, reset, fail
+    };
+}
+
+auto crcWorkload()->Workload
+{
+    return Workload{
+        "crc",
+        {
+            { 0xF000, code, sizeof(code) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xF0CB,
+    };
+}
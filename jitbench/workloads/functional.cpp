@@ -0,0 +1,502 @@
+// functional.cpp : Self checking instruction set test.
+//
+
+#include "../workloads.h"
+
+//
+// Self checking instruction test. The ALU operations run exhaustively over
+// their operands (decimal mode over valid BCD only) and fold the results and
+// flags into a checksum, which is compared against a table. Directed
+// tests then cover the addressing modes, stack, subroutine, BRK and branch
+// behaviour. The number of the failing test is left in `test`.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // test = $00
+    // opa = $01
+    // opv = $02
+    // cin = $03
+    // sum1 = $04
+    // sum2 = $05
+    // entry = $06
+    // vector = $08
+    // mask = $0A
+    // kind = $0B
+    // tmp = $0C
+    // ptr = $0E
+    // zpdata = $80
+    // scratch = $0200
+
+    // UNARY = $01
+    // DECIMAL = $02
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // E000 reset:  LDX #$FF
+        0x9A,                    // E002         TXS
+        0xD8,                    // E003         CLD
+        0xA9, 0x00,              // E004         LDA #0
+        0x85, 0x00,              // E006         STA test
+        0x85, 0x07,              // E008         STA entry+1             ; entry is the offset of the current table entry
+
+                                 // ; --- exhaustive ALU checksums ---------------------------------------------
+        0xA6, 0x06,              // E00A nextop: LDX entry
+        0xBD, 0x20, 0xE1,        // E00C         LDA operations,X
+        0x85, 0x08,              // E00F         STA vector
+        0xBD, 0x21, 0xE1,        // E011         LDA operations+1,X
+        0x85, 0x09,              // E014         STA vector+1
+        0x05, 0x08,              // E016         ORA vector
+        0xD0, 0x03,              // E018         BNE runop
+        0x4C, 0xAC, 0xE1,        // E01A         JMP directed
+        0xE6, 0x00,              // E01D runop:  INC test
+        0xBD, 0x22, 0xE1,        // E01F         LDA operations+2,X
+        0x85, 0x0A,              // E022         STA mask
+        0xBD, 0x23, 0xE1,        // E024         LDA operations+3,X
+        0x85, 0x0B,              // E027         STA kind
+        0xA9, 0x00,              // E029         LDA #0
+        0x85, 0x04,              // E02B         STA sum1
+        0x85, 0x05,              // E02D         STA sum2
+        0x85, 0x01,              // E02F         STA opa
+        0xA9, 0x00,              // E031 aloop:  LDA #0
+        0x85, 0x02,              // E033         STA opv
+        0xA9, 0x00,              // E035 vloop:  LDA #0
+        0x85, 0x03,              // E037         STA cin
+        0xA5, 0x03,              // E039 cloop:  LDA cin
+        0x4A,                    // E03B         LSR A
+        0xA5, 0x01,              // E03C         LDA opa
+        0xB8,                    // E03E         CLV
+        0x20, 0x84, 0xE0,        // E03F         JSR dispatch
+        0x08,                    // E042         PHP
+        0x20, 0x87, 0xE0,        // E043         JSR accumulate
+        0x68,                    // E046         PLA
+        0x25, 0x0A,              // E047         AND mask
+        0x20, 0x87, 0xE0,        // E049         JSR accumulate
+        0xE6, 0x03,              // E04C         INC cin
+        0xA5, 0x03,              // E04E         LDA cin
+        0xC9, 0x02,              // E050         CMP #2
+        0xD0, 0xE5,              // E052         BNE cloop
+        0xA5, 0x0B,              // E054         LDA kind
+        0x29, 0x01,              // E056         AND #UNARY
+        0xD0, 0x07,              // E058         BNE vdone
+        0xA2, 0x02,              // E05A         LDX #opv
+        0x20, 0x99, 0xE0,        // E05C         JSR advance
+        0xD0, 0xD4,              // E05F         BNE vloop
+        0xA2, 0x01,              // E061 vdone:  LDX #opa
+        0x20, 0x99, 0xE0,        // E063         JSR advance
+        0xD0, 0xC9,              // E066         BNE aloop
+        0xA6, 0x06,              // E068         LDX entry
+        0xA5, 0x04,              // E06A         LDA sum1
+        0xDD, 0x24, 0xE1,        // E06C         CMP operations+4,X
+        0xD0, 0x10,              // E06F         BNE fail1
+        0xA5, 0x05,              // E071         LDA sum2
+        0xDD, 0x25, 0xE1,        // E073         CMP operations+5,X
+        0xD0, 0x09,              // E076         BNE fail1
+        0x8A,                    // E078         TXA
+        0x18,                    // E079         CLC
+        0x69, 0x06,              // E07A         ADC #6
+        0x85, 0x06,              // E07C         STA entry
+        0x4C, 0x0A, 0xE0,        // E07E         JMP nextop
+        0x4C, 0xD3, 0xE2,        // E081 fail1:  JMP fail
+
+                                 // dispatch:
+        0x6C, 0x08, 0x00,        // E084         JMP (vector)
+
+                                 // ; Rotates the 16-bit checksum left one bit and adds A. Must be called in
+                                 // ; binary mode.
+                                 // accumulate:
+        0x06, 0x04,              // E087         ASL sum1
+        0x26, 0x05,              // E089         ROL sum2
+        0x90, 0x02,              // E08B         BCC rotated
+        0xE6, 0x04,              // E08D         INC sum1
+                                 // rotated:
+        0x18,                    // E08F         CLC
+        0x65, 0x04,              // E090         ADC sum1
+        0x85, 0x04,              // E092         STA sum1
+        0x90, 0x02,              // E094         BCC added
+        0xE6, 0x05,              // E096         INC sum2
+        0x60,                    // E098 added:  RTS
+
+                                 // ; Steps the zero page operand at X to the next value, in BCD for decimal
+                                 // ; operations, and returns Z set when it wraps to zero.
+                                 // advance:
+        0xA5, 0x0B,              // E099         LDA kind
+        0x29, 0x02,              // E09B         AND #DECIMAL
+        0xD0, 0x03,              // E09D         BNE bcdstep
+        0xF6, 0x00,              // E09F         INC 0,X
+        0x60,                    // E0A1         RTS
+                                 // bcdstep:
+        0xB5, 0x00,              // E0A2         LDA 0,X
+        0xF8,                    // E0A4         SED
+        0x18,                    // E0A5         CLC
+        0x69, 0x01,              // E0A6         ADC #1
+        0xD8,                    // E0A8         CLD
+        0x95, 0x00,              // E0A9         STA 0,X
+        0xB5, 0x00,              // E0AB         LDA 0,X
+        0x60,                    // E0AD         RTS
+
+        0x65, 0x02,              // E0AE op_adc: ADC opv
+        0x60,                    // E0B0         RTS
+        0xE5, 0x02,              // E0B1 op_sbc: SBC opv
+        0x60,                    // E0B3         RTS
+        0x25, 0x02,              // E0B4 op_and: AND opv
+        0x60,                    // E0B6         RTS
+        0x05, 0x02,              // E0B7 op_ora: ORA opv
+        0x60,                    // E0B9         RTS
+        0x45, 0x02,              // E0BA op_eor: EOR opv
+        0x60,                    // E0BC         RTS
+        0xC5, 0x02,              // E0BD op_cmp: CMP opv
+        0x60,                    // E0BF         RTS
+        0xAA,                    // E0C0 op_cpx: TAX
+        0xE4, 0x02,              // E0C1         CPX opv
+        0x60,                    // E0C3         RTS
+        0xA8,                    // E0C4 op_cpy: TAY
+        0xC4, 0x02,              // E0C5         CPY opv
+        0x60,                    // E0C7         RTS
+        0x85, 0x0C,              // E0C8 op_bit: STA tmp
+        0xA5, 0x02,              // E0CA         LDA opv
+        0x24, 0x0C,              // E0CC         BIT tmp
+        0x60,                    // E0CE         RTS
+                                 // op_dadc:
+        0xF8,                    // E0CF         SED
+        0x65, 0x02,              // E0D0         ADC opv
+        0xD8,                    // E0D2         CLD
+        0x60,                    // E0D3         RTS
+                                 // op_dsbc:
+        0xF8,                    // E0D4         SED
+        0xE5, 0x02,              // E0D5         SBC opv
+        0xD8,                    // E0D7         CLD
+        0x60,                    // E0D8         RTS
+        0x0A,                    // E0D9 op_asl: ASL A
+        0x60,                    // E0DA         RTS
+        0x4A,                    // E0DB op_lsr: LSR A
+        0x60,                    // E0DC         RTS
+        0x2A,                    // E0DD op_rol: ROL A
+        0x60,                    // E0DE         RTS
+        0x6A,                    // E0DF op_ror: ROR A
+        0x60,                    // E0E0         RTS
+                                 // op_aslm:
+        0x85, 0x0C,              // E0E1         STA tmp
+        0x06, 0x0C,              // E0E3         ASL tmp
+        0xA5, 0x0C,              // E0E5         LDA tmp
+        0x60,                    // E0E7         RTS
+                                 // op_rorm:
+        0x8D, 0x00, 0x02,        // E0E8         STA scratch
+        0x6E, 0x00, 0x02,        // E0EB         ROR scratch
+        0xAD, 0x00, 0x02,        // E0EE         LDA scratch
+        0x60,                    // E0F1         RTS
+                                 // op_rolx:
+        0xA2, 0x03,              // E0F2         LDX #3
+        0x95, 0x09,              // E0F4         STA tmp-3,X
+        0x36, 0x09,              // E0F6         ROL tmp-3,X
+        0xA5, 0x0C,              // E0F8         LDA tmp
+        0x60,                    // E0FA         RTS
+                                 // op_lsrx:
+        0xA2, 0x11,              // E0FB         LDX #$11
+        0x9D, 0xEF, 0x01,        // E0FD         STA scratch-$11,X
+        0x5E, 0xEF, 0x01,        // E100         LSR scratch-$11,X
+        0xAD, 0x00, 0x02,        // E103         LDA scratch
+        0x60,                    // E106         RTS
+        0x85, 0x0C,              // E107 op_inc: STA tmp
+        0xE6, 0x0C,              // E109         INC tmp
+        0xA5, 0x0C,              // E10B         LDA tmp
+        0x60,                    // E10D         RTS
+        0x8D, 0x00, 0x02,        // E10E op_dec: STA scratch
+        0xCE, 0x00, 0x02,        // E111         DEC scratch
+        0xAD, 0x00, 0x02,        // E114         LDA scratch
+        0x60,                    // E117         RTS
+        0xAA,                    // E118 op_inx: TAX
+        0xE8,                    // E119         INX
+        0x8A,                    // E11A         TXA
+        0x60,                    // E11B         RTS
+        0xA8,                    // E11C op_dey: TAY
+        0x88,                    // E11D         DEY
+        0x98,                    // E11E         TYA
+        0x60,                    // E11F         RTS
+
+                                 // ; routine, flag mask, kind, expected checksum
+                                 // operations:
+        0xAE, 0xE0,              // E120         .word op_adc
+        0xC3, 0x00, 0x70, 0x9C,  // E122         .byte $C3, 0, $70, $9C
+        0xB1, 0xE0,              // E126         .word op_sbc
+        0xC3, 0x00, 0x7F, 0x61,  // E128         .byte $C3, 0, $7F, $61
+        0xB4, 0xE0,              // E12C         .word op_and
+        0xC3, 0x00, 0x97, 0xE2,  // E12E         .byte $C3, 0, $97, $E2
+        0xB7, 0xE0,              // E132         .word op_ora
+        0xC3, 0x00, 0xAF, 0xD8,  // E134         .byte $C3, 0, $AF, $D8
+        0xBA, 0xE0,              // E138         .word op_eor
+        0xC3, 0x00, 0x76, 0xA2,  // E13A         .byte $C3, 0, $76, $A2
+        0xBD, 0xE0,              // E13E         .word op_cmp
+        0xC3, 0x00, 0xF6, 0x88,  // E140         .byte $C3, 0, $F6, $88
+        0xC0, 0xE0,              // E144         .word op_cpx
+        0xC3, 0x00, 0xF6, 0x88,  // E146         .byte $C3, 0, $F6, $88
+        0xC4, 0xE0,              // E14A         .word op_cpy
+        0xC3, 0x00, 0xF6, 0x88,  // E14C         .byte $C3, 0, $F6, $88
+        0xC8, 0xE0,              // E150         .word op_bit
+        0xC3, 0x00, 0x92, 0x53,  // E152         .byte $C3, 0, $92, $53
+        0xCF, 0xE0,              // E156         .word op_dadc
+        0x01, 0x02, 0x66, 0xA2,  // E158         .byte $01, DECIMAL, $66, $A2
+        0xD4, 0xE0,              // E15C         .word op_dsbc
+        0x01, 0x02, 0x82, 0x09,  // E15E         .byte $01, DECIMAL, $82, $09
+        0xD9, 0xE0,              // E162         .word op_asl
+        0xC3, 0x01, 0xB0, 0xF9,  // E164         .byte $C3, UNARY, $B0, $F9
+        0xDB, 0xE0,              // E168         .word op_lsr
+        0xC3, 0x01, 0xC2, 0x13,  // E16A         .byte $C3, UNARY, $C2, $13
+        0xDD, 0xE0,              // E16E         .word op_rol
+        0xC3, 0x01, 0xB9, 0xDF,  // E170         .byte $C3, UNARY, $B9, $DF
+        0xDF, 0xE0,              // E174         .word op_ror
+        0xC3, 0x01, 0x20, 0x5A,  // E176         .byte $C3, UNARY, $20, $5A
+        0xE1, 0xE0,              // E17A         .word op_aslm
+        0xC3, 0x01, 0xB0, 0xF9,  // E17C         .byte $C3, UNARY, $B0, $F9
+        0xE8, 0xE0,              // E180         .word op_rorm
+        0xC3, 0x01, 0x20, 0x5A,  // E182         .byte $C3, UNARY, $20, $5A
+        0xF2, 0xE0,              // E186         .word op_rolx
+        0xC3, 0x01, 0xB9, 0xDF,  // E188         .byte $C3, UNARY, $B9, $DF
+        0xFB, 0xE0,              // E18C         .word op_lsrx
+        0xC3, 0x01, 0xC2, 0x13,  // E18E         .byte $C3, UNARY, $C2, $13
+        0x07, 0xE1,              // E192         .word op_inc
+        0xC3, 0x01, 0x51, 0x02,  // E194         .byte $C3, UNARY, $51, $02
+        0x0E, 0xE1,              // E198         .word op_dec
+        0xC3, 0x01, 0x11, 0x51,  // E19A         .byte $C3, UNARY, $11, $51
+        0x18, 0xE1,              // E19E         .word op_inx
+        0xC3, 0x01, 0x51, 0x02,  // E1A0         .byte $C3, UNARY, $51, $02
+        0x1C, 0xE1,              // E1A4         .word op_dey
+        0xC3, 0x01, 0x11, 0x51,  // E1A6         .byte $C3, UNARY, $11, $51
+        0x00, 0x00,              // E1AA         .word 0
+
+                                 // ; --- directed tests -------------------------------------------------------
+                                 // directed:
+        0xE6, 0x00,              // E1AC         INC test                ; addressing modes
+        0xA2, 0x00,              // E1AE         LDX #0
+        0x8A,                    // E1B0 store:  TXA
+        0x49, 0xA5,              // E1B1         EOR #$A5
+        0x9D, 0x00, 0x02,        // E1B3         STA scratch,X
+        0xE0, 0x80,              // E1B6         CPX #$80
+        0xB0, 0x02,              // E1B8         BCS stored
+        0x95, 0x80,              // E1BA         STA zpdata,X
+        0xE8,                    // E1BC stored: INX
+        0xD0, 0xF1,              // E1BD         BNE store
+        0xA9, 0x00,              // E1BF         LDA #<scratch
+        0x85, 0x0E,              // E1C1         STA ptr
+        0xA9, 0x02,              // E1C3         LDA #>scratch
+        0x85, 0x0F,              // E1C5         STA ptr+1
+        0xA0, 0x10,              // E1C7         LDY #$10
+        0xB1, 0x0E,              // E1C9         LDA (ptr),Y
+        0xC9, 0xB5,              // E1CB         CMP #$10^$A5
+        0xD0, 0x61,              // E1CD         BNE fail2
+        0xA2, 0x0A,              // E1CF         LDX #ptr-4
+        0xA1, 0x04,              // E1D1         LDA (4,X)
+        0xC9, 0xA5,              // E1D3         CMP #$00^$A5
+        0xD0, 0x59,              // E1D5         BNE fail2
+        0xA9, 0x3C,              // E1D7         LDA #$3C
+        0x85, 0x10,              // E1D9         STA $10
+        0xA2, 0x90,              // E1DB         LDX #$90
+        0xB5, 0x80,              // E1DD         LDA zpdata,X            ; zero page indexing wraps within page zero
+        0xC9, 0x3C,              // E1DF         CMP #$3C
+        0xD0, 0x4D,              // E1E1         BNE fail2
+        0xA0, 0x7F,              // E1E3         LDY #$7F
+        0xB6, 0x80,              // E1E5         LDX zpdata,Y
+        0xE0, 0xDA,              // E1E7         CPX #$7F^$A5
+        0xD0, 0x45,              // E1E9         BNE fail2
+        0xA0, 0xFF,              // E1EB         LDY #$FF
+        0xB9, 0x43, 0x01,        // E1ED         LDA scratch-$FF+$42,Y
+        0xC9, 0xE7,              // E1F0         CMP #$42^$A5
+        0xD0, 0x3C,              // E1F2         BNE fail2
+        0xA2, 0xC0,              // E1F4         LDX #$C0
+        0xBD, 0x40, 0x02,        // E1F6         LDA scratch+$40,X       ; crosses into page 3
+        0x85, 0x0C,              // E1F9         STA tmp
+        0xAD, 0x00, 0x03,        // E1FB         LDA scratch+$100
+        0xC5, 0x0C,              // E1FE         CMP tmp
+        0xD0, 0x2E,              // E200         BNE fail2
+        0xA0, 0x20,              // E202         LDY #$20
+        0xA9, 0x5C,              // E204         LDA #$5C
+        0x91, 0x0E,              // E206         STA (ptr),Y
+        0xAD, 0x20, 0x02,        // E208         LDA scratch+$20
+        0xC9, 0x5C,              // E20B         CMP #$5C
+        0xD0, 0x21,              // E20D         BNE fail2
+        0xA2, 0x0C,              // E20F         LDX #ptr-2
+        0xA9, 0xC5,              // E211         LDA #$C5
+        0x81, 0x02,              // E213         STA (2,X)
+        0xCD, 0x00, 0x02,        // E215         CMP scratch
+        0xD0, 0x16,              // E218         BNE fail2
+        0xA2, 0x33,              // E21A         LDX #$33
+        0xA0, 0x44,              // E21C         LDY #$44
+        0x8E, 0x01, 0x02,        // E21E         STX scratch+1
+        0x8C, 0x02, 0x02,        // E221         STY scratch+2
+        0xA0, 0x01,              // E224         LDY #1
+        0xA2, 0x77,              // E226         LDX #$77
+        0x96, 0x0B,              // E228         STX tmp-1,Y
+        0xA5, 0x0C,              // E22A         LDA tmp
+        0xC9, 0x77,              // E22C         CMP #$77
+        0xF0, 0x03,              // E22E         BEQ stack
+        0x4C, 0xD3, 0xE2,        // E230 fail2:  JMP fail
+
+        0xE6, 0x00,              // E233 stack:  INC test                ; stack and flags
+        0xA9, 0xFF,              // E235         LDA #$FF
+        0x48,                    // E237         PHA
+        0x28,                    // E238         PLP
+        0x08,                    // E239         PHP
+        0x68,                    // E23A         PLA
+        0xC9, 0xFF,              // E23B         CMP #$FF
+        0xD0, 0xF1,              // E23D         BNE fail2
+        0xA9, 0x00,              // E23F         LDA #$00
+        0x48,                    // E241         PHA
+        0x28,                    // E242         PLP
+        0x08,                    // E243         PHP
+        0x68,                    // E244         PLA
+        0xC9, 0x30,              // E245         CMP #$30                ; bit 5 and B always read back as set
+        0xD0, 0xE7,              // E247         BNE fail2
+        0xD8,                    // E249         CLD
+        0xBA,                    // E24A         TSX
+        0x86, 0x0C,              // E24B         STX tmp
+        0xA9, 0x12,              // E24D         LDA #$12
+        0x48,                    // E24F         PHA
+        0xA9, 0x34,              // E250         LDA #$34
+        0x48,                    // E252         PHA
+        0xBA,                    // E253         TSX
+        0xE8,                    // E254         INX
+        0xE8,                    // E255         INX
+        0xE4, 0x0C,              // E256         CPX tmp
+        0xD0, 0xD6,              // E258         BNE fail2
+        0x68,                    // E25A         PLA
+        0xC9, 0x34,              // E25B         CMP #$34
+        0xD0, 0xD1,              // E25D         BNE fail2
+        0x68,                    // E25F         PLA
+        0xC9, 0x12,              // E260         CMP #$12
+        0xD0, 0xCC,              // E262         BNE fail2
+        0xA2, 0x80,              // E264         LDX #$80                ; TXS leaves the flags alone
+        0xA9, 0x00,              // E266         LDA #0
+        0x9A,                    // E268         TXS
+        0xD0, 0xC5,              // E269         BNE fail2
+        0xA2, 0xFF,              // E26B         LDX #$FF
+        0x9A,                    // E26D         TXS
+
+        0xE6, 0x00,              // E26E         INC test                ; subroutines push the address of their last byte
+        0x20, 0xD6, 0xE2,        // E270         JSR pushed
+                                 // pushedret:
+        0xC9, 0x72,              // E273         CMP #<(pushedret-1)
+        0xD0, 0x18,              // E275         BNE fail3
+        0xE0, 0xE2,              // E277         CPX #>(pushedret-1)
+        0xD0, 0x14,              // E279         BNE fail3
+
+        0xE6, 0x00,              // E27B         INC test                ; JMP (indirect) does not carry into the high byte
+        0xA9, 0x92,              // E27D         LDA #<jmpok
+        0x8D, 0xFF, 0x02,        // E27F         STA scratch+$FF
+        0xA9, 0xE2,              // E282         LDA #>jmpok
+        0x8D, 0x00, 0x02,        // E284         STA scratch
+        0xA9, 0xE2,              // E287         LDA #>fail3
+        0x8D, 0x00, 0x03,        // E289         STA scratch+$100
+        0x6C, 0xFF, 0x02,        // E28C         JMP (scratch+$FF)
+        0x4C, 0xD3, 0xE2,        // E28F fail3:  JMP fail
+                                 // jmpok:
+        0xE6, 0x00,              // E292         INC test                ; BRK and RTI
+        0xA9, 0x00,              // E294         LDA #0
+        0x85, 0x0C,              // E296         STA tmp
+        0x18,                    // E298         CLC
+        0x00,                    // E299         BRK
+        0xEA,                    // E29A         .byte $EA               ; padding byte skipped by RTI
+                                 // brkreturn:
+        0xB0, 0xF2,              // E29B         BCS fail3               ; RTI restored the flags
+        0xA5, 0x0C,              // E29D         LDA tmp
+        0xC9, 0x01,              // E29F         CMP #1
+        0xD0, 0xEC,              // E2A1         BNE fail3
+
+        0xE6, 0x00,              // E2A3         INC test                ; branches, including across pages
+        0xA9, 0x80,              // E2A5         LDA #$80
+        0x18,                    // E2A7         CLC
+        0xB8,                    // E2A8         CLV
+        0x30, 0x03,              // E2A9         BMI b1
+        0x4C, 0xD3, 0xE2,        // E2AB         JMP fail
+        0x10, 0xDF,              // E2AE b1:     BPL fail3
+        0xB0, 0xDD,              // E2B0         BCS fail3
+        0x90, 0x03,              // E2B2         BCC b2
+        0x4C, 0xD3, 0xE2,        // E2B4         JMP fail
+        0x70, 0xD6,              // E2B7 b2:     BVS fail3
+        0x50, 0x03,              // E2B9         BVC b3
+        0x4C, 0xD3, 0xE2,        // E2BB         JMP fail
+        0xD0, 0x03,              // E2BE b3:     BNE b4
+        0x4C, 0xD3, 0xE2,        // E2C0         JMP fail
+        0xF0, 0xCA,              // E2C3 b4:     BEQ fail3
+        0xA9, 0x40,              // E2C5         LDA #$40
+        0x69, 0x40,              // E2C7         ADC #$40
+        0x50, 0xC4,              // E2C9         BVC fail3
+        0x30, 0x03,              // E2CB         BMI b5
+        0x4C, 0xD3, 0xE2,        // E2CD         JMP fail
+        0x4C, 0xF0, 0xE7,        // E2D0 b5:     JMP farbranch
+        0x4C, 0xD3, 0xE2,        // E2D3 fail:   JMP fail
+
+        0xBA,                    // E2D6 pushed: TSX
+        0xBD, 0x02, 0x01,        // E2D7         LDA $0102,X
+        0x48,                    // E2DA         PHA
+        0xBD, 0x01, 0x01,        // E2DB         LDA $0101,X
+        0xA8,                    // E2DE         TAY
+        0x68,                    // E2DF         PLA
+        0xAA,                    // E2E0         TAX
+        0x98,                    // E2E1         TYA
+        0x60,                    // E2E2         RTS
+
+                                 // interrupt:
+        0x48,                    // E2E3         PHA
+        0x8A,                    // E2E4         TXA
+        0x48,                    // E2E5         PHA
+        0xBA,                    // E2E6         TSX
+        0xBD, 0x03, 0x01,        // E2E7         LDA $0103,X             ; pushed flags have B set
+        0x29, 0x10,              // E2EA         AND #$10
+        0xF0, 0x0D,              // E2EC         BEQ fail4
+        0xBD, 0x04, 0x01,        // E2EE         LDA $0104,X             ; and the return address skips the padding byte
+        0xC9, 0x9B,              // E2F1         CMP #<brkreturn
+        0xD0, 0x06,              // E2F3         BNE fail4
+        0xE6, 0x0C,              // E2F5         INC tmp
+        0x68,                    // E2F7         PLA
+        0xAA,                    // E2F8         TAX
+        0x68,                    // E2F9         PLA
+        0x40,                    // E2FA         RTI
+        0x4C, 0xD3, 0xE2,        // E2FB fail4:  JMP fail
+    };
+
+    const uint8_t code1[] = {
+                                 // farbranch:
+        0xA2, 0x03,              // E7F0         LDX #3
+                                 // farloop:
+        0xCA,                    // E7F2         DEX                     ; loops back across the page boundary
+        0xEA,                    // E7F3         NOP
+        0xEA,                    // E7F4         NOP
+        0xEA,                    // E7F5         NOP
+        0xEA,                    // E7F6         NOP
+        0xEA,                    // E7F7         NOP
+        0xEA,                    // E7F8         NOP
+        0xEA,                    // E7F9         NOP
+        0xEA,                    // E7FA         NOP
+        0xEA,                    // E7FB         NOP
+        0xEA,                    // E7FC         NOP
+        0xEA,                    // E7FD         NOP
+        0xEA,                    // E7FE         NOP
+        0xEA,                    // E7FF         NOP
+        0xEA,                    // E800         NOP
+        0xEA,                    // E801         NOP
+        0xEA,                    // E802         NOP
+        0xD0, 0xED,              // E803         BNE farloop
+        0xE0, 0x00,              // E805         CPX #0
+        0xF0, 0x03,              // E807         BEQ pass
+        0x4C, 0xD3, 0xE2,        // E809         JMP fail
+        0x4C, 0x0C, 0xE8,        // E80C pass:   JMP pass
+    };
+
+    const uint8_t vectors[] = {
+        0xD3, 0xE2, 0x00, 0xE0, 0xE3, 0xE2, // FFFA         .word fail, reset, interrupt
+    };
+}
+
+auto functionalWorkload()->Workload
+{
+    return Workload{
+        "functional",
+        {
+            { 0xE000, code, sizeof(code) },
+            { 0xE7F0, code1, sizeof(code1) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xE80C,
+    };
+}
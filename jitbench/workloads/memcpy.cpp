@@ -0,0 +1,143 @@
+// memcpy.cpp : Block copy and fill workload.
+//
+
+#include "../workloads.h"
+
+//
+// Block moves: a 4K indirect indexed copy, a 4K fill, a page copy with
+// absolute indexing and an overlapping backward move, repeated ITERATIONS
+// times. Passes if the destination buffers compare equal to the source.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // ITERATIONS = 24
+    // SOURCE = $1000
+    // DEST = $2000
+    // SCRATCH = $3000
+    // src = $00
+    // dst = $02
+    // pages = $04
+    // rounds = $05
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // F000 reset:  LDX #$FF
+        0x9A,                    // F002         TXS
+        0xD8,                    // F003         CLD
+        0xA9, 0x00,              // F004         LDA #<SOURCE            ; source pattern: byte = low + 3 * page
+        0x85, 0x00,              // F006         STA src
+        0xA9, 0x10,              // F008         LDA #>SOURCE
+        0x85, 0x01,              // F00A         STA src+1
+        0xA2, 0x10,              // F00C         LDX #16
+        0xA0, 0x00,              // F00E         LDY #0
+                                 // pattern:
+        0x98,                    // F010         TYA
+        0x18,                    // F011         CLC
+        0x65, 0x01,              // F012         ADC src+1
+        0x65, 0x01,              // F014         ADC src+1
+        0x65, 0x01,              // F016         ADC src+1
+        0x91, 0x00,              // F018         STA (src),Y
+        0xC8,                    // F01A         INY
+        0xD0, 0xF3,              // F01B         BNE pattern
+        0xE6, 0x01,              // F01D         INC src+1
+        0xCA,                    // F01F         DEX
+        0xD0, 0xEE,              // F020         BNE pattern
+        0xA9, 0x18,              // F022         LDA #ITERATIONS
+        0x85, 0x05,              // F024         STA rounds
+
+        0xA9, 0x10,              // F026 round:  LDA #>SOURCE            ; copy 16 pages through (zp),Y
+        0x85, 0x01,              // F028         STA src+1
+        0xA9, 0x20,              // F02A         LDA #>DEST
+        0x85, 0x03,              // F02C         STA dst+1
+        0xA9, 0x00,              // F02E         LDA #0
+        0x85, 0x00,              // F030         STA src
+        0x85, 0x02,              // F032         STA dst
+        0xA2, 0x10,              // F034         LDX #16
+        0xA0, 0x00,              // F036         LDY #0
+        0xB1, 0x00,              // F038 copy:   LDA (src),Y
+        0x91, 0x02,              // F03A         STA (dst),Y
+        0xC8,                    // F03C         INY
+        0xD0, 0xF9,              // F03D         BNE copy
+        0xE6, 0x01,              // F03F         INC src+1
+        0xE6, 0x03,              // F041         INC dst+1
+        0xCA,                    // F043         DEX
+        0xD0, 0xF2,              // F044         BNE copy
+
+        0xA9, 0x30,              // F046         LDA #>SCRATCH           ; fill 16 pages
+        0x85, 0x03,              // F048         STA dst+1
+        0xA2, 0x10,              // F04A         LDX #16
+        0xA9, 0xE5,              // F04C         LDA #$E5
+        0x91, 0x02,              // F04E fill:   STA (dst),Y
+        0xC8,                    // F050         INY
+        0xD0, 0xFB,              // F051         BNE fill
+        0xE6, 0x03,              // F053         INC dst+1
+        0xCA,                    // F055         DEX
+        0xD0, 0xF6,              // F056         BNE fill
+
+        0xA2, 0x00,              // F058         LDX #0                  ; copy one page, absolute indexed
+        0xBD, 0x00, 0x15,        // F05A page:   LDA SOURCE+$0500,X
+        0x9D, 0x00, 0x31,        // F05D         STA SCRATCH+$0100,X
+        0xE8,                    // F060         INX
+        0xD0, 0xF7,              // F061         BNE page
+
+        0xA0, 0xFF,              // F063         LDY #$FF                ; move SCRATCH+$100..+$1FE up one byte, backwards
+        0xB9, 0xFF, 0x30,        // F065 back:   LDA SCRATCH+$00FF,Y
+        0x99, 0x00, 0x31,        // F068         STA SCRATCH+$0100,Y
+        0x88,                    // F06B         DEY
+        0xD0, 0xF7,              // F06C         BNE back
+
+        0xA9, 0x10,              // F06E         LDA #>SOURCE            ; compare the 4K copy
+        0x85, 0x01,              // F070         STA src+1
+        0xA9, 0x20,              // F072         LDA #>DEST
+        0x85, 0x03,              // F074         STA dst+1
+        0xA2, 0x10,              // F076         LDX #16
+                                 // compare:
+        0xB1, 0x00,              // F078         LDA (src),Y
+        0xD1, 0x02,              // F07A         CMP (dst),Y
+        0xD0, 0x30,              // F07C         BNE fail
+        0xC8,                    // F07E         INY
+        0xD0, 0xF7,              // F07F         BNE compare
+        0xE6, 0x01,              // F081         INC src+1
+        0xE6, 0x03,              // F083         INC dst+1
+        0xCA,                    // F085         DEX
+        0xD0, 0xF0,              // F086         BNE compare
+
+        0xAD, 0x00, 0x31,        // F088         LDA SCRATCH+$0100       ; the backward move left the first byte alone
+        0xCD, 0x00, 0x15,        // F08B         CMP SOURCE+$0500
+        0xD0, 0x1E,              // F08E         BNE fail
+        0xA2, 0x01,              // F090         LDX #1
+                                 // shifted:
+        0xBD, 0x00, 0x31,        // F092         LDA SCRATCH+$0100,X
+        0xDD, 0xFF, 0x14,        // F095         CMP SOURCE+$04FF,X
+        0xD0, 0x14,              // F098         BNE fail
+        0xE8,                    // F09A         INX
+        0xD0, 0xF5,              // F09B         BNE shifted
+        0xAD, 0x00, 0x32,        // F09D         LDA SCRATCH+$0200
+        0xC9, 0xE5,              // F0A0         CMP #$E5
+        0xD0, 0x0A,              // F0A2         BNE fail
+
+        0xC6, 0x05,              // F0A4         DEC rounds
+        0xF0, 0x03,              // F0A6         BEQ pass
+        0x4C, 0x26, 0xF0,        // F0A8         JMP round
+        0x4C, 0xAB, 0xF0,        // F0AB pass:   JMP pass
+        0x4C, 0xAE, 0xF0,        // F0AE fail:   JMP fail
+    };
+
+    const uint8_t vectors[] = {
+        0xAE, 0xF0, 0x00, 0xF0, 0xAE, 0xF0, // FFFA         .word fail, reset, fail
+    };
+}
+
+auto memcpyWorkload()->Workload
+{
+    return Workload{
+        "memcpy",
+        {
+            { 0xF000, code, sizeof(code) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xF0AB,
+    };
+}
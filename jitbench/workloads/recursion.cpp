@@ -0,0 +1,86 @@
+// recursion.cpp : Recursive subroutine call workload.
+//
+
+#include "../workloads.h"
+
+//
+// Naive recursive Fibonacci: fib(20) counted out as 6765 leaf calls of
+// fib(1), with the argument kept on the hardware stack across calls.
+// Repeated ITERATIONS times.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // ITERATIONS = 8
+    // sum = $00
+    // rounds = $02
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // F000 reset:  LDX #$FF
+        0x9A,                    // F002         TXS
+        0xD8,                    // F003         CLD
+        0xA9, 0x08,              // F004         LDA #ITERATIONS
+        0x85, 0x02,              // F006         STA rounds
+        0xA9, 0x00,              // F008 round:  LDA #0
+        0x85, 0x00,              // F00A         STA sum
+        0x85, 0x01,              // F00C         STA sum+1
+        0xA9, 0x14,              // F00E         LDA #20
+        0x20, 0x2E, 0xF0,        // F010         JSR fib
+        0xBA,                    // F013         TSX                     ; the stack must balance
+        0xE0, 0xFF,              // F014         CPX #$FF
+        0xD0, 0x13,              // F016         BNE fail
+        0xA5, 0x00,              // F018         LDA sum
+        0xC9, 0x6D,              // F01A         CMP #<6765
+        0xD0, 0x0D,              // F01C         BNE fail
+        0xA5, 0x01,              // F01E         LDA sum+1
+        0xC9, 0x1A,              // F020         CMP #>6765
+        0xD0, 0x07,              // F022         BNE fail
+        0xC6, 0x02,              // F024         DEC rounds
+        0xD0, 0xE0,              // F026         BNE round
+        0x4C, 0x28, 0xF0,        // F028 pass:   JMP pass
+        0x4C, 0x2B, 0xF0,        // F02B fail:   JMP fail
+
+                                 // ; Adds fib(A) to sum
+        0xC9, 0x02,              // F02E fib:    CMP #2
+        0xB0, 0x0A,              // F030         BCS recurse
+        0x18,                    // F032         CLC
+        0x65, 0x00,              // F033         ADC sum
+        0x85, 0x00,              // F035         STA sum
+        0x90, 0x02,              // F037         BCC leaf
+        0xE6, 0x01,              // F039         INC sum+1
+        0x60,                    // F03B leaf:   RTS
+                                 // recurse:
+        0x48,                    // F03C         PHA
+        0xE9, 0x01,              // F03D         SBC #1                  ; carry is set
+        0x20, 0x2E, 0xF0,        // F03F         JSR fib
+        0x68,                    // F042         PLA
+        0x48,                    // F043         PHA
+        0x38,                    // F044         SEC
+        0xE9, 0x02,              // F045         SBC #2
+        0x20, 0x2E, 0xF0,        // F047         JSR fib
+        0xBA,                    // F04A         TSX                     ; the argument is still where it was pushed
+        0xBD, 0x01, 0x01,        // F04B         LDA $0101,X
+        0xC9, 0x02,              // F04E         CMP #2
+        0x90, 0xD9,              // F050         BCC fail
+        0x68,                    // F052         PLA
+        0x60,                    // F053         RTS
+    };
+
+    const uint8_t vectors[] = {
+        0x2B, 0xF0, 0x00, 0xF0, 0x2B, 0xF0, // FFFA         .word fail, reset, fail
+    };
+}
+
+auto recursionWorkload()->Workload
+{
+    return Workload{
+        "recursion",
+        {
+            { 0xF000, code, sizeof(code) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xF028,
+    };
+}
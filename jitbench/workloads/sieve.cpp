@@ -0,0 +1,119 @@
+// sieve.cpp : Prime sieve workload.
+//
+
+#include "../workloads.h"
+
+//
+// Sieve of Eratosthenes over 8192 flags, repeated ITERATIONS times.
+// Passes if every round finds the 1028 primes below 8192.
+//
+// The bytes are an assembled listing of the source in the comments.
+//
+
+namespace
+{
+    // ITERATIONS = 4
+    // FLAGS = $1000
+    // ptr = $00
+    // i = $02
+    // j = $04
+    // count = $06
+    // rounds = $08
+
+    const uint8_t code[] = {
+        0xA2, 0xFF,              // F000 reset:  LDX #$FF
+        0x9A,                    // F002         TXS
+        0xD8,                    // F003         CLD
+        0xA9, 0x04,              // F004         LDA #ITERATIONS
+        0x85, 0x08,              // F006         STA rounds
+        0xA9, 0x00,              // F008 round:  LDA #<FLAGS
+        0x85, 0x00,              // F00A         STA ptr
+        0xA9, 0x10,              // F00C         LDA #>FLAGS
+        0x85, 0x01,              // F00E         STA ptr+1
+        0xA2, 0x20,              // F010         LDX #32
+        0xA9, 0x01,              // F012         LDA #1
+        0xA0, 0x00,              // F014         LDY #0
+        0x91, 0x00,              // F016 fill:   STA (ptr),Y
+        0xC8,                    // F018         INY
+        0xD0, 0xFB,              // F019         BNE fill
+        0xE6, 0x01,              // F01B         INC ptr+1
+        0xCA,                    // F01D         DEX
+        0xD0, 0xF6,              // F01E         BNE fill
+        0xA9, 0x02,              // F020         LDA #2
+        0x85, 0x02,              // F022         STA i
+        0xA9, 0x00,              // F024         LDA #0
+        0x85, 0x03,              // F026         STA i+1
+        0x85, 0x06,              // F028         STA count
+        0x85, 0x07,              // F02A         STA count+1
+        0xA5, 0x03,              // F02C scan:   LDA i+1
+        0xC9, 0x20,              // F02E         CMP #$20
+        0x90, 0x03,              // F030         BCC test
+        0x4C, 0x7F, 0xF0,        // F032         JMP counted
+        0xA5, 0x02,              // F035 test:   LDA i
+        0x85, 0x00,              // F037         STA ptr
+        0xA5, 0x03,              // F039         LDA i+1
+        0x69, 0x10,              // F03B         ADC #>FLAGS
+        0x85, 0x01,              // F03D         STA ptr+1
+        0xB1, 0x00,              // F03F         LDA (ptr),Y
+        0xF0, 0x33,              // F041         BEQ next
+        0xE6, 0x06,              // F043         INC count
+        0xD0, 0x02,              // F045         BNE double
+        0xE6, 0x07,              // F047         INC count+1
+        0xA5, 0x02,              // F049 double: LDA i
+        0x0A,                    // F04B         ASL A
+        0x85, 0x04,              // F04C         STA j
+        0xA5, 0x03,              // F04E         LDA i+1
+        0x2A,                    // F050         ROL A
+        0x85, 0x05,              // F051         STA j+1
+        0xA5, 0x05,              // F053 mark:   LDA j+1
+        0xC9, 0x20,              // F055         CMP #$20
+        0xB0, 0x1D,              // F057         BCS next
+        0xA5, 0x04,              // F059         LDA j
+        0x85, 0x00,              // F05B         STA ptr
+        0xA5, 0x05,              // F05D         LDA j+1
+        0x69, 0x10,              // F05F         ADC #>FLAGS
+        0x85, 0x01,              // F061         STA ptr+1
+        0x98,                    // F063         TYA
+        0x91, 0x00,              // F064         STA (ptr),Y
+        0xA5, 0x04,              // F066         LDA j
+        0x18,                    // F068         CLC
+        0x65, 0x02,              // F069         ADC i
+        0x85, 0x04,              // F06B         STA j
+        0xA5, 0x05,              // F06D         LDA j+1
+        0x65, 0x03,              // F06F         ADC i+1
+        0x85, 0x05,              // F071         STA j+1
+        0x4C, 0x53, 0xF0,        // F073         JMP mark
+        0xE6, 0x02,              // F076 next:   INC i
+        0xD0, 0xB2,              // F078         BNE scan
+        0xE6, 0x03,              // F07A         INC i+1
+        0x4C, 0x2C, 0xF0,        // F07C         JMP scan
+                                 // counted:
+        0xA5, 0x06,              // F07F         LDA count
+        0xC9, 0x04,              // F081         CMP #<1028
+        0xD0, 0x10,              // F083         BNE fail
+        0xA5, 0x07,              // F085         LDA count+1
+        0xC9, 0x04,              // F087         CMP #>1028
+        0xD0, 0x0A,              // F089         BNE fail
+        0xC6, 0x08,              // F08B         DEC rounds
+        0xF0, 0x03,              // F08D         BEQ pass
+        0x4C, 0x08, 0xF0,        // F08F         JMP round
+        0x4C, 0x92, 0xF0,        // F092 pass:   JMP pass
+        0x4C, 0x95, 0xF0,        // F095 fail:   JMP fail
+    };
+
+    const uint8_t vectors[] = {
+        0x95, 0xF0, 0x00, 0xF0, 0x95, 0xF0, // FFFA         .word fail, reset, fail
+    };
+}
+
+auto sieveWorkload()->Workload
+{
+    return Workload{
+        "sieve",
+        {
+            { 0xF000, code, sizeof(code) },
+            { 0xFFFA, vectors, sizeof(vectors) },
+        },
+        0xF092,
+    };
+}
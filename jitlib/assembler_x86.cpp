@@ -13,9 +13,38 @@ auto AssemblerX86::beginCodeFragment() -> void
     vm_->beginCodeFragment();
 }
 
-auto AssemblerX86::endCodeFragment() -> void *
+auto AssemblerX86::endCodeFragment(const char *name) -> void *
 {
-    return vm_->endCodeFragment();
+    return vm_->endCodeFragment(name);
+}
+
+auto AssemblerX86::encodeAddPtrOffsetConstant(X86Register ptr, uint32_t offset, uint32_t c)->void
+{
+    encodeGroup1PtrOffsetConstant(0, ptr, offset, c);
+}
+
+auto AssemblerX86::encodeAddPtrOffsetConstant64(X86Register ptr, uint32_t offset, uint32_t c)->void
+{
+    assert(X64);
+    encodeREXW();
+    encodeGroup1PtrOffsetConstant(0, ptr, offset, c);
+}
+
+auto AssemblerX86::encodeAdcPtrOffsetConstant(X86Register ptr, uint32_t offset, uint32_t c)->void
+{
+    encodeGroup1PtrOffsetConstant(2, ptr, offset, c);
+}
+
+auto AssemblerX86::encodeAddRegConstant(X86Register reg, uint32_t c)->void
+{
+    encodeREXW();
+    encodeGroup1RegConstant(0, reg, c);
+}
+
+auto AssemblerX86::encodeAdcRegConstant(X86Register reg, uint32_t c)->void
+{
+    encodeREXW();
+    encodeGroup1RegConstant(2, reg, c);
 }
 
 auto AssemblerX86::encodeAndReg8Constant(X86Register8 reg, uint8_t constant)->void
@@ -32,45 +61,60 @@ auto AssemblerX86::encodeAndReg8Constant(X86Register8 reg, uint8_t constant)->vo
 
 auto AssemblerX86::encodeCall(NativeAddress fn)->void
 {
-    auto addr = reinterpret_cast<uint32_t>(fn);
+    // In 64-bit mode the target is not necessarily within 2G of the code
+    // region, so go through a register.
+    if (X64) {
+        encodeMoveRegPointer(EAX, fn);
+        encodeCallReg(EAX);
+        return;
+    }
+
     vm_->addByte(0xE8);
 
     // The operand to CALL is a signed quantity relative to the end of
     // the instruction
 
     auto delta = fn - (vm_->nextByte() + sizeof(uint32_t));
+    encodeLittleEndian(delta, 4);
+}
 
-    for (auto i = 0; i < 4; i++) {
-        vm_->addByte(delta & 0xFF);
-        delta >>= 8;
-    }
+auto AssemblerX86::encodeCallReg(X86Register reg)->void
+{
+    vm_->addByte(0xFF);
+    vm_->addByte(buildModRM(MOD_REG, 2, reg));
 }
 
-auto AssemblerX86::encodeJumpIndirect(X86Register reg, uint32_t offset)->void
+auto AssemblerX86::encodeJump(NativeAddress target)->void
 {
-    MOD mod = MOD_INDIRECT;
-    int offsetBytes = 0;
+    // Jumps are always within the JIT region, so a 32-bit displacement
+    // reaches in either mode.
+    vm_->addByte(0xE9);
 
-    if (offset) {
-        if (offset < 0x80 || offset > 0xFFFFFF80) {
-            mod = MOD_DISP8;
-            offsetBytes = 1;
-        }
-        else {
-            mod = MOD_DISP32;
-            offsetBytes = 4;
-        }
-    }
+    auto delta = target - (vm_->nextByte() + sizeof(uint32_t));
+    assert(delta == static_cast<int32_t>(delta));
+    encodeLittleEndian(delta, 4);
+}
+
+auto AssemblerX86::encodeJumpConditional(X86Condition cond, NativeAddress target)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(static_cast<uint8_t>(0x80 | cond));
 
-    uint8_t modrm = buildModRM(mod, static_cast<X86Register>(4), reg);
+    auto delta = target - (vm_->nextByte() + sizeof(uint32_t));
+    assert(delta == static_cast<int32_t>(delta));
+    encodeLittleEndian(delta, 4);
+}
 
+auto AssemblerX86::encodeJumpIndirect(X86Register reg, uint32_t offset)->void
+{
     vm_->addByte(0xFF);
-    vm_->addByte(modrm);
+    encodeMemoryOperand(4, reg, offset);
+}
 
-    while (offsetBytes--) {
-        vm_->addByte(offset & 0xFF);
-        offset >>= 8;
-    }
+auto AssemblerX86::encodeJumpReg(X86Register reg)->void
+{
+    vm_->addByte(0xFF);
+    vm_->addByte(buildModRM(MOD_REG, 4, reg));
 }
 
 auto AssemblerX86::encodeLAHF()->void
@@ -83,6 +127,7 @@ auto AssemblerX86::encodeMoveRegReg(X86Register dst, X86Register src)->void
 {
     uint8_t modrm = buildModRM(MOD_REG, dst, src);
 
+    encodeREXW();
     vm_->addByte(0x8B);
     vm_->addByte(modrm);
 }
@@ -98,70 +143,73 @@ auto AssemblerX86::encodeMoveRegReg8(X86Register8 dst, X86Register8 src)->void
 
 auto AssemblerX86::encodeMoveRegPtrOffset(X86Register dst, X86Register ptr, uint32_t offset)->void
 {
-    MOD mod = MOD_INDIRECT;
-    int offsetBytes = 0;
-
-    if (offset) {
-        if (offset < 0x80 || offset > 0xFFFFFF80) {
-            mod = MOD_DISP8;
-            offsetBytes = 1;
-        }
-        else {
-            mod = MOD_DISP32;
-            offsetBytes = 4;
-        }
-    }
-
-    uint8_t modrm = buildModRM(mod, dst, ptr);
-
+    encodeREXW();
     vm_->addByte(0x8B);
-    vm_->addByte(modrm);
-
-    while (offsetBytes--) {
-        vm_->addByte(offset & 0xFF);
-        offset >>= 8;
-    }
+    encodeMemoryOperand(dst, ptr, offset);
 }
 
 auto AssemblerX86::encodeMoveReg8PtrOffset(X86Register8 dst, X86Register ptr, uint32_t offset)->void
 {
-    MOD mod = MOD_INDIRECT;
-    int offsetBytes = 0;
+    vm_->addByte(0x8A);
+    encodeMemoryOperand(dst, ptr, offset);
+}
 
-    assert(ptr != ESP);
+auto AssemblerX86::encodeMoveReg8Indexed(X86Register8 dst, X86Register base, X86Register index)->void
+{
+    assert(base != EBP);
+    assert(index != ESP);
 
-    if (offset) {
-        if (offset == 0 && ptr != EBP) {
-            mod = MOD_INDIRECT;
-        } else if (offset < 0x80 || offset > 0xFFFFFF80) {
-            mod = MOD_DISP8;
-            offsetBytes = 1;
-        }
-        else {
-            mod = MOD_DISP32;
-            offsetBytes = 4;
-        }
-    }
+    vm_->addByte(0x8A);
+    vm_->addByte(buildModRM(MOD_INDIRECT, dst, ESP));
+    vm_->addByte(static_cast<uint8_t>((index << 3) | base));
+}
 
-    uint8_t modrm = buildModRM(mod, dst, ptr);
+auto AssemblerX86::encodeMovePtrOffsetReg(X86Register ptr, uint32_t offset, X86Register src)->void
+{
+    encodeREXW();
+    vm_->addByte(0x89);
+    encodeMemoryOperand(src, ptr, offset);
+}
 
-    vm_->addByte(0x8A);
-    vm_->addByte(modrm);
+auto AssemblerX86::encodeMovePtrOffsetReg8(X86Register ptr, uint32_t offset, X86Register8 src)->void
+{
+    vm_->addByte(0x88);
+    encodeMemoryOperand(src, ptr, offset);
+}
 
-    while (offsetBytes--) {
-        vm_->addByte(offset & 0xFF);
-        offset >>= 8;
-    }
+auto AssemblerX86::encodeMovePtrOffsetConstant16(X86Register ptr, uint32_t offset, uint16_t c)->void
+{
+    vm_->addByte(0x66);
+    vm_->addByte(0xC7);
+    encodeMemoryOperand(0, ptr, offset);
+    encodeLittleEndian(c, 2);
+}
+
+auto AssemblerX86::encodeMovePtrOffsetConstant32(X86Register ptr, uint32_t offset, uint32_t c)->void
+{
+    vm_->addByte(0xC7);
+    encodeMemoryOperand(0, ptr, offset);
+    encodeLittleEndian(c, 4);
 }
 
 auto AssemblerX86::encodeMoveRegConstant(X86Register dst, uint32_t c)->void
 {
     vm_->addByte(0xB8 | dst);
+    encodeLittleEndian(c, 4);
+}
 
-    for (auto i = 0; i < 4; i++) {
-        vm_->addByte(c & 0xFF);
-        c >>= 8;
-    }
+auto AssemblerX86::encodeMoveRegPointer(X86Register dst, const void *p)->void
+{
+    encodeREXW();
+    vm_->addByte(0xB8 | dst);
+    encodeLittleEndian(reinterpret_cast<uintptr_t>(p), sizeof(p));
+}
+
+auto AssemblerX86::encodeMoveR8Reg(X86Register src)->void
+{
+    vm_->addByte(REX_R);
+    vm_->addByte(0x8B);
+    vm_->addByte(buildModRM(MOD_REG, EAX, src));
 }
 
 auto AssemblerX86::encodeMoveReg8Constant(X86Register8 reg, uint8_t data)->void
@@ -190,7 +238,7 @@ auto AssemblerX86::encodeXorReg(X86Register dst, X86Register src)->void
     assert(src >= 0 && src < 8);
     assert(dst >= 0 && dst < 8);
     vm_->addByte(0x31);
-    vm_->addByte(buildModRM(MOD_REG, dst, src));
+    vm_->addByte(buildModRM(MOD_REG, src, dst));
 }
 
 auto AssemblerX86::encodePopRegister(X86Register reg)->void
@@ -221,6 +269,247 @@ auto AssemblerX86::encodeShiftRightReg(X86Register reg, uint8_t shift)->void
     }
 }
 
+auto AssemblerX86::encodeSubRegConstant(X86Register reg, uint32_t c)->void
+{
+    encodeREXW();
+    encodeGroup1RegConstant(5, reg, c);
+}
+
+
+auto AssemblerX86::encodeAddPtrOffsetReg(X86Register ptr, uint32_t offset, X86Register src)->void
+{
+    encodeREXW();
+    vm_->addByte(0x01);
+    encodeMemoryOperand(src, ptr, offset);
+}
+
+auto AssemblerX86::encodeAddReg8Constant(X86Register8 reg, uint8_t constant)->void
+{
+    encodeGroup1Reg8Constant(0, reg, constant);
+}
+
+auto AssemblerX86::encodeAddReg8PtrOffset(X86Register8 dst, X86Register ptr, uint32_t offset)->void
+{
+    vm_->addByte(0x02);
+    encodeMemoryOperand(dst, ptr, offset);
+}
+
+auto AssemblerX86::encodeAddRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(0, dst, src);
+}
+
+auto AssemblerX86::encodeAdcReg8Constant(X86Register8 reg, uint8_t constant)->void
+{
+    encodeGroup1Reg8Constant(2, reg, constant);
+}
+
+auto AssemblerX86::encodeAdcRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(2, dst, src);
+}
+
+auto AssemblerX86::encodeAndRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(4, dst, src);
+}
+
+// BT with an immediate bit number; CF is the bit
+//
+auto AssemblerX86::encodeBitTestRegConstant(X86Register reg, uint8_t bit)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(0xBA);
+    vm_->addByte(buildModRM(MOD_REG, 4, reg));
+    vm_->addByte(bit);
+}
+
+auto AssemblerX86::encodeCMC()->void
+{
+    vm_->addByte(0xF5);
+}
+
+auto AssemblerX86::encodeCmpPtrOffsetReg8(X86Register ptr, uint32_t offset, X86Register8 src)->void
+{
+    vm_->addByte(0x38);
+    encodeMemoryOperand(src, ptr, offset);
+}
+
+auto AssemblerX86::encodeCmpReg8Constant(X86Register8 reg, uint8_t constant)->void
+{
+    encodeGroup1Reg8Constant(7, reg, constant);
+}
+
+auto AssemblerX86::encodeCmpRegPtrOffset(X86Register reg, X86Register ptr, uint32_t offset)->void
+{
+    encodeREXW();
+    vm_->addByte(0x3B);
+    encodeMemoryOperand(reg, ptr, offset);
+}
+
+auto AssemblerX86::encodeCmpRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(7, dst, src);
+}
+
+auto AssemblerX86::encodeDecPtrOffset8(X86Register ptr, uint32_t offset)->void
+{
+    vm_->addByte(0xFE);
+    encodeMemoryOperand(1, ptr, offset);
+}
+
+auto AssemblerX86::encodeDecReg8(X86Register8 reg)->void
+{
+    vm_->addByte(0xFE);
+    vm_->addByte(buildModRM(MOD_REG, 1, reg));
+}
+
+auto AssemblerX86::encodeIncPtrOffset8(X86Register ptr, uint32_t offset)->void
+{
+    vm_->addByte(0xFE);
+    encodeMemoryOperand(0, ptr, offset);
+}
+
+auto AssemblerX86::encodeIncPtrOffset16(X86Register ptr, uint32_t offset)->void
+{
+    vm_->addByte(0x66);
+    vm_->addByte(0xFF);
+    encodeMemoryOperand(0, ptr, offset);
+}
+
+auto AssemblerX86::encodeIncReg8(X86Register8 reg)->void
+{
+    vm_->addByte(0xFE);
+    vm_->addByte(buildModRM(MOD_REG, 0, reg));
+}
+
+auto AssemblerX86::encodeJumpForward()->NativeAddress
+{
+    vm_->addByte(0xE9);
+    auto displacement = vm_->nextByte();
+    encodeLittleEndian(0, 4);
+    return displacement;
+}
+
+auto AssemblerX86::encodeJumpConditionalForward(X86Condition cond)->NativeAddress
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(static_cast<uint8_t>(0x80 | cond));
+    auto displacement = vm_->nextByte();
+    encodeLittleEndian(0, 4);
+    return displacement;
+}
+
+auto AssemblerX86::patchJump(NativeAddress displacement)->void
+{
+    auto delta = vm_->nextByte() - (displacement + sizeof(uint32_t));
+    assert(delta == static_cast<int32_t>(delta));
+    for (auto i = 0; i < 4; i++) {
+        displacement[i] = static_cast<uint8_t>(delta >> (i * 8));
+    }
+}
+
+auto AssemblerX86::encodeMoveZeroExtendReg8(X86Register dst, X86Register8 src)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(0xB6);
+    vm_->addByte(buildModRM(MOD_REG, dst, src));
+}
+
+auto AssemblerX86::encodeMoveZeroExtendReg16(X86Register dst, X86Register src)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(0xB7);
+    vm_->addByte(buildModRM(MOD_REG, dst, src));
+}
+
+auto AssemblerX86::encodeMoveZeroExtendPtrOffset8(X86Register dst, X86Register ptr, uint32_t offset)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(0xB6);
+    encodeMemoryOperand(dst, ptr, offset);
+}
+
+auto AssemblerX86::encodeNotReg8(X86Register8 reg)->void
+{
+    vm_->addByte(0xF6);
+    vm_->addByte(buildModRM(MOD_REG, 2, reg));
+}
+
+auto AssemblerX86::encodeOrReg8Constant(X86Register8 reg, uint8_t constant)->void
+{
+    encodeGroup1Reg8Constant(1, reg, constant);
+}
+
+// RCR by one, through the carry
+//
+auto AssemblerX86::encodeRotateCarryRightReg8(X86Register8 reg)->void
+{
+    encodeGroup2Reg8(3, reg, 1);
+}
+
+auto AssemblerX86::encodeSetConditionReg8(X86Condition cond, X86Register8 reg)->void
+{
+    vm_->addByte(0x0F);
+    vm_->addByte(static_cast<uint8_t>(0x90 | cond));
+    vm_->addByte(buildModRM(MOD_REG, 0, reg));
+}
+
+auto AssemblerX86::encodeShiftLeftReg(X86Register reg, uint8_t shift)->void
+{
+    if (shift == 1) {
+        vm_->addByte(0xD1);
+        vm_->addByte(buildModRM(MOD_REG, 4, reg));
+    }
+    else {
+        vm_->addByte(0xC1);
+        vm_->addByte(buildModRM(MOD_REG, 4, reg));
+        vm_->addByte(shift);
+    }
+}
+
+auto AssemblerX86::encodeShiftLeftReg8(X86Register8 reg, uint8_t shift)->void
+{
+    encodeGroup2Reg8(4, reg, shift);
+}
+
+auto AssemblerX86::encodeShiftRightReg8(X86Register8 reg, uint8_t shift)->void
+{
+    encodeGroup2Reg8(5, reg, shift);
+}
+
+auto AssemblerX86::encodeSbbRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(3, dst, src);
+}
+
+auto AssemblerX86::encodeSubRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(5, dst, src);
+}
+
+auto AssemblerX86::encodeTestReg8Constant(X86Register8 reg, uint8_t constant)->void
+{
+    if (reg == AL) {
+        vm_->addByte(0xA8);
+    }
+    else {
+        vm_->addByte(0xF6);
+        vm_->addByte(buildModRM(MOD_REG, 0, reg));
+    }
+    vm_->addByte(constant);
+}
+
+auto AssemblerX86::encodeTestRegReg8(X86Register8 reg1, X86Register8 reg2)->void
+{
+    vm_->addByte(0x84);
+    vm_->addByte(buildModRM(MOD_REG, reg2, reg1));
+}
+
+auto AssemblerX86::encodeXorRegReg8(X86Register8 dst, X86Register8 src)->void
+{
+    encodeGroup1RegReg8(6, dst, src);
+}
 
 auto AssemblerX86::buildModRM(MOD mod, unsigned reg, unsigned mem)->uint8_t
 {
@@ -230,3 +519,118 @@ auto AssemblerX86::buildModRM(MOD mod, unsigned reg, unsigned mem)->uint8_t
     return mod | (reg << 3) | mem;
 }
 
+auto AssemblerX86::encodeREXW()->void
+{
+    if (X64) {
+        vm_->addByte(REX_W);
+    }
+}
+
+// Encodes the MOD R/M byte (plus SIB and displacement as needed) for [ptr + offset].
+// ESP as a base always needs a SIB byte, and EBP with no displacement would be
+// taken as an absolute (or in 64-bit mode, RIP relative) address, so it gets
+// an explicit zero displacement.
+//
+auto AssemblerX86::encodeMemoryOperand(unsigned reg, X86Register ptr, uint32_t offset)->void
+{
+    MOD mod = MOD_INDIRECT;
+    int offsetBytes = 0;
+
+    if (offset != 0 || ptr == EBP) {
+        if (isDisp8(offset)) {
+            mod = MOD_DISP8;
+            offsetBytes = 1;
+        }
+        else {
+            mod = MOD_DISP32;
+            offsetBytes = 4;
+        }
+    }
+
+    vm_->addByte(buildModRM(mod, reg, ptr));
+    if (ptr == ESP) {
+        vm_->addByte(SIB_NO_INDEX | ESP);
+    }
+
+    encodeLittleEndian(offset, offsetBytes);
+}
+
+// Group 1 is ADD/OR/ADC/SBB/AND/SUB/XOR/CMP, selected by op in the reg field
+//
+auto AssemblerX86::encodeGroup1PtrOffsetConstant(unsigned op, X86Register ptr, uint32_t offset, uint32_t c)->void
+{
+    if (isDisp8(c)) {
+        vm_->addByte(0x83);
+        encodeMemoryOperand(op, ptr, offset);
+        encodeLittleEndian(c, 1);
+    }
+    else {
+        vm_->addByte(0x81);
+        encodeMemoryOperand(op, ptr, offset);
+        encodeLittleEndian(c, 4);
+    }
+}
+
+auto AssemblerX86::encodeGroup1RegConstant(unsigned op, X86Register reg, uint32_t c)->void
+{
+    if (isDisp8(c)) {
+        vm_->addByte(0x83);
+        vm_->addByte(buildModRM(MOD_REG, op, reg));
+        encodeLittleEndian(c, 1);
+    }
+    else {
+        vm_->addByte(0x81);
+        vm_->addByte(buildModRM(MOD_REG, op, reg));
+        encodeLittleEndian(c, 4);
+    }
+}
+
+// The r/m8, r8 form, with dst in r/m
+//
+auto AssemblerX86::encodeGroup1RegReg8(unsigned op, X86Register8 dst, X86Register8 src)->void
+{
+    vm_->addByte(static_cast<uint8_t>(op << 3));
+    vm_->addByte(buildModRM(MOD_REG, src, dst));
+}
+
+auto AssemblerX86::encodeGroup1Reg8Constant(unsigned op, X86Register8 reg, uint8_t c)->void
+{
+    if (reg == AL) {
+        vm_->addByte(static_cast<uint8_t>((op << 3) | 0x04));
+    }
+    else {
+        vm_->addByte(0x80);
+        vm_->addByte(buildModRM(MOD_REG, op, reg));
+    }
+    vm_->addByte(c);
+}
+
+// Group 2 is ROL/ROR/RCL/RCR/SHL/SHR/-/SAR
+//
+auto AssemblerX86::encodeGroup2Reg8(unsigned op, X86Register8 reg, uint8_t shift)->void
+{
+    if (shift == 1) {
+        vm_->addByte(0xD0);
+        vm_->addByte(buildModRM(MOD_REG, op, reg));
+    }
+    else {
+        vm_->addByte(0xC0);
+        vm_->addByte(buildModRM(MOD_REG, op, reg));
+        vm_->addByte(shift);
+    }
+}
+
+auto AssemblerX86::encodeLittleEndian(uint64_t value, int bytes)->void
+{
+    while (bytes--) {
+        vm_->addByte(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+// True if a 32-bit quantity can be encoded as a sign extended byte
+//
+auto AssemblerX86::isDisp8(uint32_t offset)->bool
+{
+    return offset < 0x80 || offset >= 0xFFFFFF80;
+}
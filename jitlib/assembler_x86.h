@@ -31,6 +31,18 @@ enum X86Register8 {
     BH = 7,
 };
 
+// Condition codes, as encoded in Jcc and SETcc
+enum X86Condition {
+    CC_O = 0x0,
+    CC_NO = 0x1,
+    CC_C = 0x2,
+    CC_NC = 0x3,
+    CC_Z = 0x4,
+    CC_NZ = 0x5,
+    CC_S = 0x8,
+    CC_NS = 0x9,
+};
+
 enum X86Flags {
     X86_CARRY = 0x0001,
     X86_ZERO = 0x0040,
@@ -38,34 +50,100 @@ enum X86Flags {
     X86_OVERFLOW = 0x0800,
 };
 
+//
+// AssemblerX86 emits either 32-bit or 64-bit code, matching the host. Only the
+// eight legacy registers are used in both modes, so the encodings are the same
+// except that "Reg" (pointer sized) operations get a REX.W prefix in 64-bit
+// mode. "Reg32" operations are always 32 bits wide; in 64-bit mode writing
+// one zero extends into the whole register.
+//
 class AssemblerX86
 {
 public:
     AssemblerX86(JitVM *vm);
 
-    static_assert(sizeof(NativeAddress) == sizeof(uint32_t), "assembler_x86 may only be compiled in 32-bit.");
+    static_assert(sizeof(NativeAddress) == sizeof(uint32_t) || sizeof(NativeAddress) == sizeof(uint64_t), "assembler_x86 may only be compiled for x86 or x86-64.");
+    static const bool X64 = sizeof(NativeAddress) == sizeof(uint64_t);
 
     auto beginCodeFragment()->void;
-    auto endCodeFragment()->void *;
+    auto endCodeFragment(const char *name)->void *;
 
+    auto encodeAddPtrOffsetConstant(X86Register ptr, uint32_t offset, uint32_t c)->void;
+    auto encodeAddPtrOffsetConstant64(X86Register ptr, uint32_t offset, uint32_t c)->void;
+    auto encodeAddPtrOffsetReg(X86Register ptr, uint32_t offset, X86Register src)->void;
+    auto encodeAddReg8Constant(X86Register8 reg, uint8_t constant)->void;
+    auto encodeAddReg8PtrOffset(X86Register8 dst, X86Register ptr, uint32_t offset)->void;
+    auto encodeAddRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeAdcPtrOffsetConstant(X86Register ptr, uint32_t offset, uint32_t c)->void;
+    auto encodeAdcRegConstant(X86Register reg, uint32_t c)->void;
+    auto encodeAdcReg8Constant(X86Register8 reg, uint8_t constant)->void;
+    auto encodeAdcRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeAddRegConstant(X86Register reg, uint32_t c)->void;
     auto encodeAndReg8Constant(X86Register8 reg, uint8_t constant)->void;
+    auto encodeAndRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeBitTestRegConstant(X86Register reg, uint8_t bit)->void;
     auto encodeCall(NativeAddress fn)->void;
+    auto encodeCallReg(X86Register reg)->void;
+    auto encodeCMC()->void;
+    auto encodeCmpPtrOffsetReg8(X86Register ptr, uint32_t offset, X86Register8 src)->void;
+    auto encodeCmpReg8Constant(X86Register8 reg, uint8_t constant)->void;
+    auto encodeCmpRegPtrOffset(X86Register reg, X86Register ptr, uint32_t offset)->void;
+    auto encodeCmpRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeDecPtrOffset8(X86Register ptr, uint32_t offset)->void;
+    auto encodeDecReg8(X86Register8 reg)->void;
+    auto encodeIncPtrOffset8(X86Register ptr, uint32_t offset)->void;
+    auto encodeIncPtrOffset16(X86Register ptr, uint32_t offset)->void;
+    auto encodeIncReg8(X86Register8 reg)->void;
+    auto encodeJump(NativeAddress target)->void;
+    auto encodeJumpConditional(X86Condition cond, NativeAddress target)->void;
     auto encodeJumpIndirect(X86Register reg, uint32_t offset = 0)->void;
+    auto encodeJumpReg(X86Register reg)->void;
     auto encodeLAHF()->void;
     auto encodeMoveRegReg(X86Register dst, X86Register src)->void;
     auto encodeMoveRegReg8(X86Register8 dst, X86Register8 src)->void;
     auto encodeMoveRegPtrOffset(X86Register dst, X86Register ptr, uint32_t offset = 0)->void;
     auto encodeMoveReg8PtrOffset(X86Register8 dst, X86Register ptr, uint32_t offset = 0)->void;
+    auto encodeMoveReg8Indexed(X86Register8 dst, X86Register base, X86Register index)->void;
+    auto encodeMovePtrOffsetReg(X86Register ptr, uint32_t offset, X86Register src)->void;
+    auto encodeMovePtrOffsetReg8(X86Register ptr, uint32_t offset, X86Register8 src)->void;
+    auto encodeMovePtrOffsetConstant16(X86Register ptr, uint32_t offset, uint16_t c)->void;
+    auto encodeMovePtrOffsetConstant32(X86Register ptr, uint32_t offset, uint32_t c)->void;
     auto encodeMoveRegConstant(X86Register dst, uint32_t c = 0)->void;
+    auto encodeMoveRegPointer(X86Register dst, const void *p)->void;
+
+    // mov r8d, src; 64-bit only. R8 holds a Win64 call's third argument, and
+    // is the one register beyond EDI translated code has to name.
+    auto encodeMoveR8Reg(X86Register src)->void;
     auto encodeMoveReg8Constant(X86Register8 reg, uint8_t data)->void;
+    auto encodeMoveZeroExtendReg8(X86Register dst, X86Register8 src)->void;
+    auto encodeMoveZeroExtendReg16(X86Register dst, X86Register src)->void;
+    auto encodeMoveZeroExtendPtrOffset8(X86Register dst, X86Register ptr, uint32_t offset)->void;
+    auto encodeNotReg8(X86Register8 reg)->void;
+    auto encodeOrReg8Constant(X86Register8 reg, uint8_t constant)->void;
     auto encodeOrRegReg8(X86Register8 dst, X86Register8 src)->void;
     auto encodePopRegister(X86Register reg)->void;
     auto encodePushRegister(X86Register reg)->void;
     auto encodeRet()->void;
+    auto encodeRotateCarryRightReg8(X86Register8 reg)->void;
+    auto encodeSetConditionReg8(X86Condition cond, X86Register8 reg)->void;
+    auto encodeShiftLeftReg(X86Register reg, uint8_t shift)->void;
+    auto encodeShiftLeftReg8(X86Register8 reg, uint8_t shift)->void;
     auto encodeShiftRightReg(X86Register reg, uint8_t shift)->void;
+    auto encodeShiftRightReg8(X86Register8 reg, uint8_t shift)->void;
+    auto encodeSbbRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeSubRegConstant(X86Register reg, uint32_t c)->void;
+    auto encodeSubRegReg8(X86Register8 dst, X86Register8 src)->void;
+    auto encodeTestReg8Constant(X86Register8 reg, uint8_t constant)->void;
+    auto encodeTestRegReg8(X86Register8 reg1, X86Register8 reg2)->void;
     auto encodeXchgReg8(X86Register8 reg1, X86Register8 reg2)->void;
     auto encodeXorReg(X86Register dst, X86Register src)->void;
+    auto encodeXorRegReg8(X86Register8 dst, X86Register8 src)->void;
 
+    // Jumps whose targets are not emitted yet return where their displacement
+    // is, for patchJump to point at the next byte emitted once it is
+    auto encodeJumpForward()->NativeAddress;
+    auto encodeJumpConditionalForward(X86Condition cond)->NativeAddress;
+    auto patchJump(NativeAddress displacement)->void;
 
 private:
     enum MOD {
@@ -75,9 +153,23 @@ private:
         MOD_REG = 0xC0,
     };
 
+    enum {
+        REX_W = 0x48,
+        REX_R = 0x44,
+        SIB_NO_INDEX = 0x20,
+    };
+
     auto buildModRM(MOD mod, unsigned reg, unsigned mem)->uint8_t;
-       
+    auto encodeREXW()->void;
+    auto encodeMemoryOperand(unsigned reg, X86Register ptr, uint32_t offset)->void;
+    auto encodeGroup1PtrOffsetConstant(unsigned op, X86Register ptr, uint32_t offset, uint32_t c)->void;
+    auto encodeGroup1RegConstant(unsigned op, X86Register reg, uint32_t c)->void;
+    auto encodeGroup1RegReg8(unsigned op, X86Register8 dst, X86Register8 src)->void;
+    auto encodeGroup1Reg8Constant(unsigned op, X86Register8 reg, uint8_t c)->void;
+    auto encodeGroup2Reg8(unsigned op, X86Register8 reg, uint8_t shift)->void;
+    auto encodeLittleEndian(uint64_t value, int bytes)->void;
+    auto isDisp8(uint32_t offset)->bool;
+
     JitVM *vm_;
     uint8_t rex_;
 };
-
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "types.h"
+
+enum M6502Flags
+{
+    M6502_CARRY = 0x01,
+    M6502_ZERO = 0x02,
+    M6502_INTERRUPT = 0x04,
+    M6502_DECIMAL = 0x08,
+    M6502_BRK = 0x10,
+    M6502_ALWAYS = 0x20,
+    M6502_OVERFLOW = 0x40,
+    M6502_SIGN = 0x80,
+};
+
+//
+// CpuState is the architectural state of the emulated 6502 which does not
+// live in SystemMemory. It is what gets persisted to and restored from a
+// save state.
+//
+struct CpuState
+{
+    uint8_t a;
+    uint8_t x;
+    uint8_t y;
+    uint8_t s;
+    uint8_t p;
+    TargetAddress pc;
+    uint64_t cycles;
+};
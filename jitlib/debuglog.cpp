@@ -0,0 +1,17 @@
+#include "stdafx.h"
+
+#include "debuglog.h"
+
+#include <stdio.h>
+
+using std::string;
+
+auto debugLog(const string &text)->void
+{
+#ifdef _WIN32
+    OutputDebugStringA(text.c_str());
+#else
+    fputs(text.c_str(), stderr);
+    fflush(stderr);
+#endif
+}
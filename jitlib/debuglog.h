@@ -0,0 +1,7 @@
+#pragma once
+
+#include <string>
+
+// Writes a diagnostic message where a developer will see it: the debugger's
+// output window on Windows, stderr elsewhere.
+auto debugLog(const std::string &text)->void;
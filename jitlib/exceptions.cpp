@@ -1,6 +1,6 @@
 #include "stdafx.h"
 
-#include "Exceptions.h"
+#include "exceptions.h"
 
 #include <stdexcept>
 #include <sstream>
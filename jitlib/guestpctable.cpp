@@ -0,0 +1,65 @@
+#include "stdafx.h"
+
+#include "guestpctable.h"
+
+#include <algorithm>
+#include <assert.h>
+
+using std::upper_bound;
+
+auto GuestPCTable::beginBlock(NativeAddress code)->void
+{
+    assert(blocks_.empty() || code >= blocks_.back().end);
+    blocks_.push_back(BlockEntry{ code, code, static_cast<uint32_t>(instructions_.size()) });
+}
+
+auto GuestPCTable::addInstruction(NativeAddress code, TargetAddress pc)->void
+{
+    auto offset = code - blocks_.back().start;
+    assert(offset >= 0 && offset <= UINT16_MAX);
+    instructions_.push_back(InstructionEntry{ static_cast<uint16_t>(offset), pc });
+}
+
+auto GuestPCTable::endBlock(NativeAddress end)->void
+{
+    blocks_.back().end = end;
+}
+
+auto GuestPCTable::lookup(NativeAddress code, TargetAddress *pc, TargetAddress *blockStart) const->bool
+{
+    auto block = upper_bound(begin(blocks_), end(blocks_), code, [](NativeAddress code, const BlockEntry &block) {
+        return code < block.start;
+    });
+    if (block == begin(blocks_)) {
+        return false;
+    }
+
+    --block;
+    auto first = begin(instructions_) + block->firstInstruction;
+    auto last = block + 1 == end(blocks_) ? end(instructions_) : begin(instructions_) + (block + 1)->firstInstruction;
+    if (code >= block->end || first == last) {
+        return false;
+    }
+
+    auto offset = code - block->start;
+    auto instruction = upper_bound(first, last, offset, [](NativeAddressSize offset, const InstructionEntry &instruction) {
+        return offset < instruction.offset;
+    });
+    if (instruction != first) {
+        --instruction;
+    }
+
+    *pc = instruction->pc;
+    *blockStart = first->pc;
+    return true;
+}
+
+auto GuestPCTable::blocks() const->size_t
+{
+    return blocks_.size();
+}
+
+auto GuestPCTable::instructions() const->size_t
+{
+    return instructions_.size();
+}
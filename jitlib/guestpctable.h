@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "types.h"
+
+//
+// GuestPCTable maps addresses in generated code back to the guest instruction
+// they were translated from, so a host PC caught by a profiler can be charged
+// to a 6502 address. The translator records where each guest instruction's
+// code starts as it emits it; an address maps to the last instruction that
+// starts at or before it.
+//
+// Blocks are added in the order JitVM hands out code, which is also address
+// order, so a lookup is two binary searches. Each instruction costs four
+// bytes.
+//
+class GuestPCTable
+{
+public:
+    auto beginBlock(NativeAddress code)->void;
+    auto addInstruction(NativeAddress code, TargetAddress pc)->void;
+    auto endBlock(NativeAddress end)->void;
+
+    // Finds the guest instruction whose translation contains code. Returns
+    // false for addresses outside every block, such as the entry and exit
+    // stubs.
+    auto lookup(NativeAddress code, TargetAddress *pc, TargetAddress *blockStart) const->bool;
+
+    auto blocks() const->size_t;
+    auto instructions() const->size_t;
+
+private:
+    struct BlockEntry
+    {
+        NativeAddress start;
+        NativeAddress end;
+        uint32_t firstInstruction;
+    };
+
+    struct InstructionEntry
+    {
+        // From the start of the block; blocks are far smaller than 64K
+        uint16_t offset;
+        TargetAddress pc;
+    };
+
+    std::vector<BlockEntry> blocks_;
+    std::vector<InstructionEntry> instructions_;
+};
@@ -0,0 +1,314 @@
+#include "stdafx.h"
+
+#include "guestprofiler.h"
+
+#include "exceptions.h"
+#include "guestpctable.h"
+#include "jitter6502.h"
+#include "opcodes.h"
+#include "systemmemory.h"
+#include "vmcontext.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <utility>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
+using std::atomic;
+using std::endl;
+using std::find;
+using std::fixed;
+using std::hex;
+using std::map;
+using std::ostream;
+using std::pair;
+using std::setfill;
+using std::setprecision;
+using std::setw;
+using std::sort;
+using std::string;
+using std::vector;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    const TargetAddress STACK_PAGE = 0x0100;
+
+    // Stands in for the caller of a subroutine called from outside any other
+    const int32_t TOP_LEVEL = -1;
+
+    struct SubroutineCounts
+    {
+        size_t self;
+        size_t total;
+
+        // Samples by calling subroutine, or TOP_LEVEL
+        map<int32_t, size_t> callers;
+    };
+
+    auto address(int32_t addr)->string
+    {
+        if (addr == TOP_LEVEL) {
+            return "top";
+        }
+
+        auto text = oss{};
+        text << "$" << setw(4) << setfill('0') << hex << std::uppercase << addr;
+        return text.str();
+    }
+
+    auto percent(size_t count, size_t total)->double
+    {
+        return total > 0 ? 100.0 * count / total : 0.0;
+    }
+
+    // Sorts counts from the hottest down and keeps the first top
+    template<typename Key, typename Value, typename Weight>
+    auto hottest(const map<Key, Value> &counts, size_t top, Weight weight)->vector<pair<Key, Value>>
+    {
+        auto sorted = vector<pair<Key, Value>>(begin(counts), end(counts));
+        sort(begin(sorted), end(sorted), [&weight](const pair<Key, Value> &a, const pair<Key, Value> &b) {
+            return weight(a.second) != weight(b.second) ? weight(a.second) > weight(b.second) : a.first < b.first;
+        });
+        if (sorted.size() > top) {
+            sorted.resize(top);
+        }
+        return sorted;
+    }
+
+#ifdef __linux__
+    struct sigaction previousAction;
+
+    auto onSigProf(int, siginfo_t *, void *ucontext)->void
+    {
+        auto &registers = static_cast<ucontext_t *>(ucontext)->uc_mcontext;
+#ifdef __x86_64__
+        GuestProfiler::onSignal(static_cast<uintptr_t>(registers.gregs[REG_RIP]));
+#else
+        GuestProfiler::onSignal(static_cast<uintptr_t>(registers.gregs[REG_EIP]));
+#endif
+    }
+#endif
+}
+
+atomic<GuestProfiler *> GuestProfiler::active_(nullptr);
+
+GuestProfiler::GuestProfiler(Jitter6502 *jitter, const SystemMemory *memory, size_t capacity)
+    : jitter_(jitter)
+    , context_(&jitter->context())
+    , memory_(memory)
+    , samples_(capacity)
+    , count_(0)
+    , dropped_(0)
+    , hertz_(0)
+    , running_(false)
+{
+}
+
+GuestProfiler::~GuestProfiler()
+{
+    stop();
+}
+
+auto GuestProfiler::start(unsigned hertz)->void
+{
+#ifdef __linux__
+    if (hertz == 0 || hertz > 1000000) {
+        oss() << "Sampling rate must be between 1 and 1000000 Hz." << throwError;
+    }
+
+    auto expected = static_cast<GuestProfiler *>(nullptr);
+    if (!active_.compare_exchange_strong(expected, this)) {
+        oss() << "Another guest profiler is already running." << throwError;
+    }
+
+    struct sigaction action = {};
+    action.sa_sigaction = onSigProf;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &previousAction);
+
+    auto interval = itimerval{};
+    interval.it_interval.tv_sec = 0;
+    interval.it_interval.tv_usec = 1000000 / hertz;
+    interval.it_value = interval.it_interval;
+    if (setitimer(ITIMER_PROF, &interval, nullptr) != 0) {
+        sigaction(SIGPROF, &previousAction, nullptr);
+        active_ = nullptr;
+        oss() << "Could not start the profiling timer." << throwError;
+    }
+
+    hertz_ = hertz;
+    running_ = true;
+#else
+    oss() << "Guest profiling is only supported on Linux." << throwError;
+#endif
+}
+
+auto GuestProfiler::stop()->void
+{
+#ifdef __linux__
+    if (!running_) {
+        return;
+    }
+
+    // A signal raised before the timer stops is delivered as setitimer
+    // returns, to the handler still installed; restoring the previous
+    // action first could let it terminate the process.
+    auto interval = itimerval{};
+    setitimer(ITIMER_PROF, &interval, nullptr);
+    sigaction(SIGPROF, &previousAction, nullptr);
+
+    active_ = nullptr;
+    running_ = false;
+#endif
+}
+
+auto GuestProfiler::samples() const->size_t
+{
+    return count_;
+}
+
+auto GuestProfiler::onSignal(uintptr_t hostPC)->void
+{
+    auto profiler = active_.load();
+    if (profiler != nullptr) {
+        profiler->takeSample(hostPC);
+    }
+}
+
+auto GuestProfiler::takeSample(uintptr_t hostPC)->void
+{
+    auto index = count_.load(std::memory_order_relaxed);
+    if (index == samples_.size()) {
+        dropped_++;
+        return;
+    }
+
+    auto &sample = samples_[index];
+    sample.hostPC = hostPC;
+    sample.pc = context_->cpu.pc;
+
+    // The stack grows down from $01FF and S points at the next free byte
+    auto depth = uint8_t{ 0 };
+    for (auto s = context_->cpu.s + 1; s <= 0xFF && depth < STACK_BYTES; s++) {
+        sample.stack[depth++] = memory_->peekByte(static_cast<TargetAddress>(STACK_PAGE + s));
+    }
+    sample.depth = depth;
+
+    count_.store(index + 1, std::memory_order_release);
+}
+
+auto GuestProfiler::report(ostream &out, size_t top) const->void
+{
+    auto &table = jitter_->guestPCTable();
+    auto count = count_.load(std::memory_order_acquire);
+
+    auto inGeneratedCode = size_t{ 0 };
+    auto instructions = map<TargetAddress, size_t>{};
+    auto blocks = map<TargetAddress, TargetAddress>{};
+    auto subroutines = map<int32_t, SubroutineCounts>{};
+    auto frames = vector<int32_t>{};
+
+    for (auto i = size_t{ 0 }; i < count; i++) {
+        auto &sample = samples_[i];
+
+        auto pc = sample.pc;
+        auto blockStart = sample.pc;
+        if (table.lookup(reinterpret_cast<NativeAddress>(sample.hostPC), &pc, &blockStart)) {
+            inGeneratedCode++;
+        }
+        instructions[pc]++;
+        blocks[pc] = blockStart;
+
+        // The subroutines on the stack, innermost first
+        frames.clear();
+        for (auto at = 0; at + 1 < sample.depth; ) {
+            auto returnAddress = static_cast<TargetAddress>(sample.stack[at] | (sample.stack[at + 1] << 8));
+            auto callSite = static_cast<TargetAddress>(returnAddress - 2);
+            if (opcodeTable(jitter_->model())[memory_->peekByte(callSite)].flow == FlowCall) {
+                auto subroutine = static_cast<TargetAddress>(memory_->peekByte(callSite + 1) | (memory_->peekByte(callSite + 2) << 8));
+                frames.push_back(subroutine);
+                at += 2;
+            }
+            else {
+                at++;
+            }
+        }
+
+        auto current = frames.empty() ? TOP_LEVEL : frames.front();
+        subroutines[current].self++;
+
+        // A recursive subroutine is counted once per sample however deep it is
+        auto seen = vector<int32_t>{};
+        for (auto frame = begin(frames); frame != end(frames); ++frame) {
+            auto subroutine = *frame;
+            if (find(begin(seen), end(seen), subroutine) != end(seen)) {
+                continue;
+            }
+            seen.push_back(subroutine);
+
+            auto caller = frame + 1 == end(frames) ? TOP_LEVEL : *(frame + 1);
+            subroutines[subroutine].total++;
+            subroutines[subroutine].callers[caller]++;
+        }
+        if (frames.empty()) {
+            subroutines[TOP_LEVEL].total++;
+        }
+    }
+
+    out
+        << "profile: " << count << " samples at " << hertz_ << " Hz, "
+        << inGeneratedCode << " in generated code, "
+        << count - inGeneratedCode << " in the dispatcher or translator, "
+        << dropped_ << " dropped" << endl;
+
+    out << endl << "hottest instructions" << endl;
+    out << "   self%  samples  address  block  instruction" << endl;
+    auto hotInstructions = hottest(instructions, top, [](size_t samples) { return samples; });
+    for (auto &instruction : hotInstructions) {
+        auto pc = instruction.first;
+        uint8_t bytes[3];
+        for (auto i = 0; i < 3; i++) {
+            bytes[i] = memory_->peekByte(static_cast<TargetAddress>(pc + i));
+        }
+        out
+            << fixed << setprecision(1) << setfill(' ')
+            << setw(7) << percent(instruction.second, count) << "%"
+            << setw(9) << instruction.second
+            << setw(9) << address(instruction.first)
+            << setw(7) << address(blocks[instruction.first])
+            << "  " << disassemble(pc, bytes, jitter_->model())
+            << endl;
+    }
+
+    // The top level is a subroutine for the profile's purposes: its total is
+    // every sample with no frame on the stack.
+    out << endl << "hottest subroutines" << endl;
+    out << "  total%   self%  samples  subroutine  called from" << endl;
+    auto hotSubroutines = hottest(subroutines, top, [](const SubroutineCounts &counts) { return counts.total; });
+    for (auto &subroutine : hotSubroutines) {
+        auto &counts = subroutine.second;
+        out
+            << fixed << setprecision(1) << setfill(' ')
+            << setw(7) << percent(counts.total, count) << "%"
+            << setw(7) << percent(counts.self, count) << "%"
+            << setw(9) << counts.total
+            << setw(12) << address(subroutine.first)
+            << " ";
+
+        auto callers = hottest(counts.callers, 4, [](size_t samples) { return samples; });
+        for (auto &caller : callers) {
+            out << " " << address(caller.first) << " (" << caller.second << ")";
+        }
+        out << endl;
+    }
+}
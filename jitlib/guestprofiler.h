@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <ostream>
+#include <vector>
+
+#include "types.h"
+
+class Jitter6502;
+class SystemMemory;
+struct VMContext;
+
+//
+// GuestProfiler samples a running guest with SIGPROF and reports where the
+// 6502 program spends its time. Each sample is charged to a guest instruction
+// through the translator's GuestPCTable; samples taken outside generated code
+// (in the dispatcher or translator) are charged to the block about to run.
+//
+// The signal handler only copies the host PC, the guest S register and the top
+// of the guest stack into a buffer allocated up front. Everything else is done
+// by report(), which rebuilds the guest call chain of each sample from the
+// return addresses on its stack: a stacked word is taken to be a return
+// address when the three bytes before the address it returns to are a JSR.
+// That is a heuristic; data pushed on the stack can occasionally look like a
+// frame.
+//
+// Only one profiler can run at a time, and it should sample a machine running
+// on the thread that started it. Nothing is installed until start(), so a
+// machine that is not being profiled pays nothing for it.
+//
+class GuestProfiler
+{
+public:
+    enum { DEFAULT_CAPACITY = 65536 };
+
+    GuestProfiler(Jitter6502 *jitter, const SystemMemory *memory, size_t capacity = DEFAULT_CAPACITY);
+    ~GuestProfiler();
+
+    GuestProfiler(const GuestProfiler &) = delete;
+    auto operator=(const GuestProfiler &)->GuestProfiler & = delete;
+
+    auto start(unsigned hertz)->void;
+    auto stop()->void;
+
+    // Writes the hottest top instructions and subroutines
+    auto report(std::ostream &out, size_t top) const->void;
+
+    auto samples() const->size_t;
+
+    // Called by the SIGPROF handler with the interrupted host PC
+    static auto onSignal(uintptr_t hostPC)->void;
+
+private:
+    // Enough for 32 levels of JSR
+    enum { STACK_BYTES = 64 };
+
+    struct Sample
+    {
+        uintptr_t hostPC;
+
+        // The guest PC in the context, which is the next block to run when
+        // the dispatcher is interrupted
+        TargetAddress pc;
+
+        // Bytes copied from the top of the guest stack
+        uint8_t depth;
+        uint8_t stack[STACK_BYTES];
+    };
+
+    auto takeSample(uintptr_t hostPC)->void;
+
+    static std::atomic<GuestProfiler *> active_;
+
+    Jitter6502 *jitter_;
+    const VMContext *context_;
+    const SystemMemory *memory_;
+    std::vector<Sample> samples_;
+    std::atomic<size_t> count_;
+    std::atomic<size_t> dropped_;
+    unsigned hertz_;
+    bool running_;
+};
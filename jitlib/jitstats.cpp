@@ -0,0 +1,192 @@
+#include "stdafx.h"
+
+#include "jitstats.h"
+
+#include <iomanip>
+#include <sstream>
+
+using std::fixed;
+using std::memory_order_relaxed;
+using std::setprecision;
+using std::string;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    auto ratio(double num, double den)->double
+    {
+        return den > 0 ? num / den : 0.0;
+    }
+}
+
+auto JitStats::averageBlockInstructions() const->double
+{
+    return ratio(static_cast<double>(guestInstructionsCompiled), static_cast<double>(blocksCompiled));
+}
+
+auto JitStats::averageBlockBytes() const->double
+{
+    return ratio(static_cast<double>(guestBytesCompiled), static_cast<double>(blocksCompiled));
+}
+
+auto JitStats::toJSON() const->string
+{
+    auto json = oss{};
+    json << fixed << setprecision(3)
+        << "{\"dispatches\":" << dispatches
+        << ",\"dispatcher_misses\":" << dispatcherMisses
+        << ",\"blocks_compiled\":" << blocksCompiled
+        << ",\"guest_instructions_compiled\":" << guestInstructionsCompiled
+        << ",\"guest_bytes_compiled\":" << guestBytesCompiled
+        << ",\"native_bytes_emitted\":" << nativeBytesEmitted
+        << ",\"code_ratio\":" << ratio(static_cast<double>(nativeBytesEmitted), static_cast<double>(guestBytesCompiled))
+        << ",\"average_block_instructions\":" << averageBlockInstructions()
+        << ",\"average_block_bytes\":" << averageBlockBytes()
+        << ",\"compile_ms\":" << compileNanoseconds / 1e6
+        << ",\"compile_time_us\":{";
+
+    for (auto bucket = 0; bucket < COMPILE_TIME_BUCKETS; bucket++) {
+        json << (bucket == 0 ? "" : ",");
+        if (bucket + 1 < COMPILE_TIME_BUCKETS) {
+            json << "\"<" << (1u << bucket) << "\":";
+        }
+        else {
+            json << "\">=" << (1u << (bucket - 1)) << "\":";
+        }
+        json << compileTimes[bucket];
+    }
+
+    json
+        << "},\"idle_loops\":" << idleLoops
+        << ",\"idle_cycles_skipped\":" << idleCyclesSkipped
+        << ",\"block_move_loops\":" << blockMoveLoops
+        << ",\"block_move_bytes\":" << blockMoveBytes
+        << ",\"word_operations\":" << wordOperations
+        << ",\"native_loops\":" << nativeLoops
+        << ",\"rom_reads_folded\":" << romReadsFolded
+        << ",\"pretranslated_blocks\":" << pretranslatedBlocks
+        << ",\"pretranslate_ms\":" << pretranslateNanoseconds / 1e6
+        << ",\"code_cache\":{\"reserved\":" << codeCacheReserved
+        << ",\"committed\":" << codeCacheCommitted
+        << ",\"used\":" << codeCacheUsed
+        << "}}";
+    return json.str();
+}
+
+JitCounters::JitCounters()
+    : dispatches_(0)
+    , dispatcherMisses_(0)
+    , blocksCompiled_(0)
+    , guestInstructionsCompiled_(0)
+    , guestBytesCompiled_(0)
+    , nativeBytesEmitted_(0)
+    , compileNanoseconds_(0)
+    , idleLoops_(0)
+    , idleCyclesSkipped_(0)
+    , blockMoveLoops_(0)
+    , blockMoveBytes_(0)
+    , wordOperations_(0)
+    , nativeLoops_(0)
+    , romReadsFolded_(0)
+    , pretranslatedBlocks_(0)
+    , pretranslateNanoseconds_(0)
+{
+    for (auto &bucket : compileTimes_) {
+        bucket.store(0, memory_order_relaxed);
+    }
+}
+
+auto JitCounters::countDispatch()->void
+{
+    add(&dispatches_, 1);
+}
+
+auto JitCounters::countDispatcherMiss()->void
+{
+    add(&dispatcherMisses_, 1);
+}
+
+auto JitCounters::countBlock(uint64_t guestInstructions, uint64_t guestBytes, uint64_t nativeBytes, uint64_t nanoseconds)->void
+{
+    add(&blocksCompiled_, 1);
+    add(&guestInstructionsCompiled_, guestInstructions);
+    add(&guestBytesCompiled_, guestBytes);
+    add(&nativeBytesEmitted_, nativeBytes);
+    add(&compileNanoseconds_, nanoseconds);
+
+    auto bucket = 0;
+    while (bucket + 1 < JitStats::COMPILE_TIME_BUCKETS && nanoseconds >= (1000ull << bucket)) {
+        bucket++;
+    }
+    add(&compileTimes_[bucket], 1);
+}
+
+auto JitCounters::countIdleLoop()->void
+{
+    add(&idleLoops_, 1);
+}
+
+auto JitCounters::countIdleSkip(uint64_t cycles)->void
+{
+    add(&idleCyclesSkipped_, cycles);
+}
+
+auto JitCounters::countBlockMoveLoop()->void
+{
+    add(&blockMoveLoops_, 1);
+}
+
+auto JitCounters::countBlockMove(uint64_t bytes)->void
+{
+    add(&blockMoveBytes_, bytes);
+}
+
+auto JitCounters::countWordOperation()->void
+{
+    add(&wordOperations_, 1);
+}
+
+auto JitCounters::countNativeLoop()->void
+{
+    add(&nativeLoops_, 1);
+}
+
+auto JitCounters::countROMReadsFolded(uint64_t reads)->void
+{
+    add(&romReadsFolded_, reads);
+}
+
+auto JitCounters::countPretranslation(uint64_t blocks, uint64_t nanoseconds)->void
+{
+    add(&pretranslatedBlocks_, blocks);
+    add(&pretranslateNanoseconds_, nanoseconds);
+}
+
+auto JitCounters::read(JitStats *stats) const->void
+{
+    stats->dispatches = dispatches_.load(memory_order_relaxed);
+    stats->dispatcherMisses = dispatcherMisses_.load(memory_order_relaxed);
+    stats->blocksCompiled = blocksCompiled_.load(memory_order_relaxed);
+    stats->guestInstructionsCompiled = guestInstructionsCompiled_.load(memory_order_relaxed);
+    stats->guestBytesCompiled = guestBytesCompiled_.load(memory_order_relaxed);
+    stats->nativeBytesEmitted = nativeBytesEmitted_.load(memory_order_relaxed);
+    stats->compileNanoseconds = compileNanoseconds_.load(memory_order_relaxed);
+    for (auto bucket = 0; bucket < JitStats::COMPILE_TIME_BUCKETS; bucket++) {
+        stats->compileTimes[bucket] = compileTimes_[bucket].load(memory_order_relaxed);
+    }
+    stats->idleLoops = idleLoops_.load(memory_order_relaxed);
+    stats->idleCyclesSkipped = idleCyclesSkipped_.load(memory_order_relaxed);
+    stats->blockMoveLoops = blockMoveLoops_.load(memory_order_relaxed);
+    stats->blockMoveBytes = blockMoveBytes_.load(memory_order_relaxed);
+    stats->wordOperations = wordOperations_.load(memory_order_relaxed);
+    stats->nativeLoops = nativeLoops_.load(memory_order_relaxed);
+    stats->romReadsFolded = romReadsFolded_.load(memory_order_relaxed);
+    stats->pretranslatedBlocks = pretranslatedBlocks_.load(memory_order_relaxed);
+    stats->pretranslateNanoseconds = pretranslateNanoseconds_.load(memory_order_relaxed);
+}
+
+auto JitCounters::add(Counter *counter, uint64_t count)->void
+{
+    counter->store(counter->load(memory_order_relaxed) + count, memory_order_relaxed);
+}
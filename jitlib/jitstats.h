@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <string>
+
+//
+// JitStats is a copy of the translator and code cache statistics, taken with
+// Jitter6502::stats(). The counters are read one at a time while the guest
+// may be running, so a copy is not an exact instant, but each counter in it is
+// a value the counter really had.
+//
+struct JitStats
+{
+    // Translation times are bucketed by powers of two microseconds: bucket 0
+    // counts blocks translated in under 1us, bucket n those taking from
+    // 2^(n-1)us up to 2^n us, and the last bucket everything slower.
+    enum { COMPILE_TIME_BUCKETS = 12 };
+
+    // Times a translated block was entered from the dispatcher, and times the
+    // dispatcher found no translation for the guest PC
+    uint64_t dispatches;
+    uint64_t dispatcherMisses;
+
+    uint64_t blocksCompiled;
+    uint64_t guestInstructionsCompiled;
+    uint64_t guestBytesCompiled;
+    uint64_t nativeBytesEmitted;
+    uint64_t compileNanoseconds;
+    std::array<uint64_t, COMPILE_TIME_BUCKETS> compileTimes;
+
+    // Blocks recognised as idle loops, and guest cycles fast-forwarded rather
+    // than run in them
+    uint64_t idleLoops;
+    uint64_t idleCyclesSkipped;
+
+    // Blocks starting with a loop that copies or fills memory, and bytes such
+    // loops moved in one go rather than a trip at a time
+    uint64_t blockMoveLoops;
+    uint64_t blockMoveBytes;
+
+    // Byte-wise 16-bit adds, subtracts and compares translated as one
+    uint64_t wordOperations;
+
+    // Branches and jumps back into their own block, translated as native
+    // loops rather than ways out
+    uint64_t nativeLoops;
+
+    // Reads of ROM done while translating, leaving a constant in their place
+    uint64_t romReadsFolded;
+
+    // Blocks translated ahead of time from the ROM before the guest ran, and
+    // the time that took
+    uint64_t pretranslatedBlocks;
+    uint64_t pretranslateNanoseconds;
+
+    size_t codeCacheReserved;
+    size_t codeCacheCommitted;
+    size_t codeCacheUsed;
+
+    auto averageBlockInstructions() const->double;
+    auto averageBlockBytes() const->double;
+
+    // One JSON object on a single line
+    auto toJSON() const->std::string;
+};
+
+//
+// JitCounters are the live counters behind JitStats. Only the thread running
+// the guest updates them, so an update is a relaxed load and store rather
+// than a locked read-modify-write; other threads may read them at any time.
+//
+class JitCounters
+{
+public:
+    JitCounters();
+
+    auto countDispatch()->void;
+    auto countDispatcherMiss()->void;
+    auto countBlock(uint64_t guestInstructions, uint64_t guestBytes, uint64_t nativeBytes, uint64_t nanoseconds)->void;
+    auto countIdleLoop()->void;
+    auto countIdleSkip(uint64_t cycles)->void;
+    auto countBlockMoveLoop()->void;
+    auto countBlockMove(uint64_t bytes)->void;
+    auto countWordOperation()->void;
+    auto countNativeLoop()->void;
+    auto countROMReadsFolded(uint64_t reads)->void;
+    auto countPretranslation(uint64_t blocks, uint64_t nanoseconds)->void;
+
+    // Fills in everything but the code cache sizes
+    auto read(JitStats *stats) const->void;
+
+private:
+    using Counter = std::atomic<uint64_t>;
+
+    static auto add(Counter *counter, uint64_t count)->void;
+
+    Counter dispatches_;
+    Counter dispatcherMisses_;
+    Counter blocksCompiled_;
+    Counter guestInstructionsCompiled_;
+    Counter guestBytesCompiled_;
+    Counter nativeBytesEmitted_;
+    Counter compileNanoseconds_;
+    std::array<Counter, JitStats::COMPILE_TIME_BUCKETS> compileTimes_;
+    Counter idleLoops_;
+    Counter idleCyclesSkipped_;
+    Counter blockMoveLoops_;
+    Counter blockMoveBytes_;
+    Counter wordOperations_;
+    Counter nativeLoops_;
+    Counter romReadsFolded_;
+    Counter pretranslatedBlocks_;
+    Counter pretranslateNanoseconds_;
+};
@@ -2,423 +2,3010 @@
 
 #include "jitter6502.h"
 
+#include "debuglog.h"
 #include "exceptions.h"
 #include "jitvm.h"
 #include "assembler_x86.h"
 #include "systemmemory.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <stdio.h>
 
 using std::array;
 using std::endl;
 using std::hex;
+using std::max;
+using std::min;
 using std::runtime_error;
 using std::setfill;
 using std::setw;
+using std::vector;
 
+using Clock = std::chrono::steady_clock;
 using oss = std::ostringstream;
 
-Jitter6502::Jitter6502(JitVM *vm, AssemblerX86 *assembler, SystemMemory *memory)
+namespace
+{
+    // Registers the entry stub receives its arguments in, as do the helpers and
+    // devices translated code calls, and the stack it reserves so those calls
+    // see an aligned stack (and, on Win64, their home space). A Win64 call's
+    // third argument goes in R8, which has an encoder of its own.
+#ifdef _WIN32
+    const X86Register ARG0 = ECX;
+    const X86Register ARG1 = EDX;
+    const uint32_t STACK_RESERVE = 40;
+#else
+    const X86Register ARG0 = EDI;
+    const X86Register ARG1 = ESI;
+    const X86Register ARG2 = EDX;
+    const uint32_t STACK_RESERVE = 8;
+#endif
+
+    // Where the 6502 fetches its reset and interrupt handlers from
+    const TargetAddress NMI_VECTOR = 0xFFFA;
+    const TargetAddress RESET_VECTOR = 0xFFFC;
+    const TargetAddress IRQ_VECTOR = 0xFFFE;
+
+    const TargetAddress STACK_PAGE = 0x0100;
+
+    // The loads and stores of a word operation, zero page then absolute, and
+    // CLC and SEC
+    const uint8_t WORD_LOADS[] = { 0xA5, 0xAD };
+    const uint8_t WORD_STORES[] = { 0x85, 0x8D };
+    const uint8_t WORD_CARRIES[] = { 0x18, 0x38 };
+
+    // ADC, SBC and CMP in the order of WordOperator, each zero page, absolute
+    // then immediate
+    const uint8_t WORD_OPERATORS[][3] = {
+        { 0x65, 0x6D, 0x69 },
+        { 0xE5, 0xED, 0xE9 },
+        { 0xC5, 0xCD, 0xC9 },
+    };
+}
+
+Jitter6502::Jitter6502(JitVM *vm, AssemblerX86 *assembler, SystemMemory *memory, CpuModel model)
     : vm_(vm)
     , assembler_(assembler)
     , memory_(memory)
+    , model_(model)
+    , opcodes_(opcodeTable(model))
+    , jitters_(model == CPU_NMOS_UNDOCUMENTED ? &nmosUndocumentedJitters_ : model == CPU_65C02 ? &cmosJitters_ : &nmosJitters_)
+    , context_()
+    , scheduler_([this] { return currentCycle(); })
+    , irqLine_(false)
+    , nmiPending_(false)
+    , translatedPages_()
+    , counters_()
+    , blockStart_(0)
+    , blockEnd_(0)
+    , blockBank_(SystemMemory::NO_BANK)
+    , instructionStart_(0)
+    , instruction_(nullptr)
+    , blockCycles_(0)
+    , blockInstructions_(0)
+    , blockIsTrap_(false)
+    , blockCyclesVary_(false)
+    , blockDecimal_(false)
+    , blockDecimalFromEntry_(true)
+    , blockDependsOnDecimal_(false)
+    , blockEffects_()
+    , blockIdleCycles_(0)
+    , blockIdleInstructions_(0)
+{
+    buildReentryStub();
+    buildFlagTranslationMap();
+}
+
+auto Jitter6502::boot()->void
+{
+    reset();
+
+    try {
+        if (run(UINT64_MAX) == InvalidOpcode) {
+            auto errText = oss{};
+            errText << "Execution terminated at " << setw(4) << setfill('0') << hex << context_.cpu.pc << "; invalid opcode" << endl;
+            debugLog(errText.str());
+        }
+    }
+    catch (const runtime_error &err) {
+        auto errText = oss{};
+        errText << "Runtime threw exception: " << err.what() << endl;
+        debugLog(errText.str());
+    }
+}
+
+auto Jitter6502::reset()->void
+{
+    context_.cpu.pc = memory_->readWord(RESET_VECTOR);
+    context_.cpu.s = 0xFD;
+    context_.cpu.p = M6502_ALWAYS | M6502_INTERRUPT;
+    nmiPending_ = false;
+}
+
+auto Jitter6502::run(uint64_t cycleLimit)->RunStatus
+{
+    while (context_.cpu.cycles < cycleLimit) {
+        // Fire the device events that have fallen due, then let translated
+        // code run up to the next one
+        if (scheduler_.nextDeadline() <= context_.cpu.cycles) {
+            scheduler_.runDue();
+        }
+        context_.deadline = min(cycleLimit, scheduler_.nextDeadline());
+
+        if (nmiPending_) {
+            nmiPending_ = false;
+            enterInterrupt(NMI_VECTOR, false);
+        }
+        else if (irqLine_ && (context_.cpu.p & M6502_INTERRUPT) == 0) {
+            enterInterrupt(IRQ_VECTOR, false);
+        }
+
+        auto key = blockKey(context_.cpu.pc);
+        auto block = blocks_.find(key);
+
+        if (block == end(blocks_)) {
+            counters_.countDispatcherMiss();
+            block = addBlock(context_.cpu.pc, (context_.cpu.p & M6502_DECIMAL) != 0);
+        }
+
+        if (block->second.trap) {
+            return Trapped;
+        }
+
+        counters_.countDispatch();
+        entryStub_(&context_, block->second.code);
+
+        if (context_.exitReason != ExitNone) {
+            auto reason = context_.exitReason;
+            context_.exitReason = ExitNone;
+
+            switch (reason) {
+            case ExitInvalidOpcode:
+                return InvalidOpcode;
+            case ExitBreak:
+                enterInterrupt(IRQ_VECTOR, true);
+                break;
+            }
+        }
+
+        // An idle loop that has been round once is at a fixed point, and every
+        // further trip would repeat it exactly, so skip ahead to the deadline
+        if (block->second.idleCycles != 0 && blockKey(context_.cpu.pc) == block->first) {
+            if (context_.deadline == UINT64_MAX) {
+                return Trapped;
+            }
+            skipIdleLoop(block->second);
+        }
+    }
+
+    return CycleLimitReached;
+}
+
+// Walks the guest's code by recursive descent, from where it will start and
+// where its interrupts go, translating each block and then the blocks it can
+// go on to. Only fixed ROM is walked: RAM may not hold its code yet, and a
+// bank window may hold another bank by the time the guest gets there. Blocks
+// are translated for the D flag they are reached with, clear at the roots.
+//
+auto Jitter6502::pretranslate()->size_t
+{
+    auto start = Clock::now();
+
+    auto pending = vector<BlockExit>{ BlockExit{ context_.cpu.pc, (context_.cpu.p & M6502_DECIMAL) != 0 } };
+    for (auto address : { RESET_VECTOR, NMI_VECTOR, IRQ_VECTOR }) {
+        if (memory_->isROM(address) && memory_->isROM(address + 1)) {
+            pending.push_back(BlockExit{ memory_->readWord(address), false });
+        }
+    }
+
+    auto translated = size_t{ 0 };
+    while (!pending.empty()) {
+        auto next = pending.back();
+        pending.pop_back();
+        if (!memory_->isROM(next.pc) || blocks_.count(blockKey(next.pc, next.decimal)) != 0) {
+            continue;
+        }
+
+        addBlock(next.pc, next.decimal);
+        translated++;
+        pending.insert(end(pending), begin(blockExits_), end(blockExits_));
+    }
+
+    counters_.countPretranslation(
+        translated,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    return translated;
+}
+
+auto Jitter6502::jit(TargetAddress ip)->NativeAddress
+{
+    return jit(ip, (context_.cpu.p & M6502_DECIMAL) != 0);
+}
+
+// Translates the block at pc for the D flag given and files it
+//
+auto Jitter6502::addBlock(TargetAddress pc, bool decimal)->BlockMap::iterator
+{
+    auto key = blockKey(pc, decimal);
+    auto code = jit(pc, decimal);
+    auto translated = Block{ code, blockIsTrap_, blockIdleCycles_, blockIdleInstructions_ };
+
+    // The block's code may run off the top of memory and wrap round
+    for (auto page = blockStart_ >> 8; ; page = (page + 1) & 0xFF) {
+        translatedPages_.set(page);
+        if (page == static_cast<TargetAddress>(blockEnd_ - 1) >> 8) {
+            break;
+        }
+    }
+
+    // A block with no decimal arithmetic, or only after its own SED or CLD,
+    // runs the same whichever D it is entered with
+    if (!blockDependsOnDecimal_) {
+        blocks_.emplace(key ^ DECIMAL_KEY, translated);
+    }
+    return blocks_.emplace(key, translated).first;
+}
+
+auto Jitter6502::jit(TargetAddress ip, bool decimal)->NativeAddress
+{
+    auto start = Clock::now();
+
+    blockStart_ = ip;
+    blockBank_ = memory_->bankAt(ip);
+    blockCycles_ = 0;
+    blockInstructions_ = 0;
+    blockIsTrap_ = false;
+    blockCyclesVary_ = false;
+    blockDecimal_ = decimal;
+    blockDecimalFromEntry_ = true;
+    blockDependsOnDecimal_ = false;
+    blockEffects_ = BlockEffects{};
+    blockIdleCycles_ = 0;
+    blockIdleInstructions_ = 0;
+    blockLabels_.clear();
+    blockExits_.clear();
+
+    vm_->beginCodeFragment();
+    pcTable_.beginBlock(vm_->nextByte());
+    while (true) {
+        pcTable_.addInstruction(vm_->nextByte(), ip);
+        instructionStart_ = ip;
+
+        // A block stays within one bank, so that switching another in under
+        // its tail cannot leave it stale. An instruction straddling the edge
+        // of a window goes with the bank holding its opcode.
+        if (blockInstructions_ == MAX_BLOCK_INSTRUCTIONS || memory_->bankAt(ip) != blockBank_) {
+            jit_exitBlock(ip);
+            break;
+        }
+
+        jit_blockMove(ip);
+        blockLabels_.push_back(BlockLabel{ ip, vm_->nextByte(), blockCycles_, blockInstructions_, blockDecimal_ });
+        if (jit_wordOperation(&ip)) {
+            continue;
+        }
+
+        auto byte = memory_->readByte(ip++);
+        instruction_ = &opcodes_[byte];
+        jit_noteEffects(*instruction_);
+        if (!(this->*(*jitters_)[byte])(&ip)) {
+            break;
+        }
+    }
+
+    if (isIdleLoop()) {
+        counters_.countIdleLoop();
+    }
+    else {
+        blockIdleCycles_ = 0;
+        blockIdleInstructions_ = 0;
+    }
+
+    blockEnd_ = ip;
+
+    // Named by the guest bytes the block covers, for profilers
+    char name[16];
+    snprintf(name, sizeof(name), "blk_%04X_%04X", blockStart_, static_cast<TargetAddress>(blockEnd_ - 1));
+
+    auto end = vm_->nextByte();
+    auto code = vm_->endCodeFragment(name);
+    pcTable_.endBlock(end);
+
+    counters_.countBlock(
+        blockInstructions_,
+        static_cast<TargetAddress>(blockEnd_ - blockStart_),
+        end - code,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+    return code;
+}
+
+// Loops in translated code only look at the deadline between trips, so an
+// interrupt raised while one runs brings it in for the dispatcher to see
+//
+auto Jitter6502::setIRQ(bool asserted)->void
+{
+    irqLine_ = asserted;
+    if (asserted) {
+        context_.deadline = 0;
+    }
+}
+
+auto Jitter6502::triggerNMI()->void
+{
+    nmiPending_ = true;
+    context_.deadline = 0;
+}
+
+auto Jitter6502::context()->VMContext &
+{
+    return context_;
+}
+
+auto Jitter6502::scheduler()->Scheduler &
+{
+    return scheduler_;
+}
+
+auto Jitter6502::model() const->CpuModel
+{
+    return model_;
+}
+
+auto Jitter6502::currentPC() const->TargetAddress
+{
+    auto site = context_.ioSite;
+    return site == NO_IO_SITE ? context_.cpu.pc : ioSites_[site - 1].pc;
+}
+
+auto Jitter6502::currentCycle() const->uint64_t
+{
+    // Translated code only adds a block's cycles as it leaves
+    auto site = context_.ioSite;
+    return site == NO_IO_SITE ? context_.cpu.cycles : context_.cpu.cycles + ioSites_[site - 1].cycles;
+}
+
+auto Jitter6502::stats() const->JitStats
+{
+    auto stats = JitStats{};
+    counters_.read(&stats);
+    stats.codeCacheReserved = vm_->reservedBytes();
+    stats.codeCacheCommitted = vm_->committedBytes();
+    stats.codeCacheUsed = vm_->usedBytes();
+    return stats;
+}
+
+auto Jitter6502::guestPCTable() const->const GuestPCTable &
+{
+    return pcTable_;
+}
+
+// A block is an idle loop if it can branch back to its own start, touches
+// nothing outside the CPU, never reads a register or flag it has changed
+// earlier in the block, and takes the same cycles every trip. Memory it reads
+// cannot change while it loops, so one trip leaves the CPU in a state that
+// every later trip reproduces exactly.
+//
+auto Jitter6502::isIdleLoop() const->bool
+{
+    return
+        blockIdleCycles_ != 0 &&
+        !blockIsTrap_ &&
+        !blockCyclesVary_ &&
+        !blockEffects_.sideEffects &&
+        (blockEffects_.registersRead & blockEffects_.registersWritten) == 0 &&
+        (blockEffects_.flagsRead & blockEffects_.flagsWritten) == 0;
+}
+
+// Whether a loop from the given instruction round to the one being translated
+// might be idle, as far as the opcode table can tell. Such loops are left to
+// leave the block each trip, for the dispatcher to skip.
+//
+auto Jitter6502::loopMayIdle(TargetAddress loop) const->bool
+{
+    auto effects = BlockEffects{};
+    for (auto pc = loop; ; ) {
+        const auto &info = opcodes_[memory_->peekByte(pc)];
+        addEffects(&effects, info);
+        if (pc == instructionStart_) {
+            break;
+        }
+        pc += info.length;
+    }
+    return
+        !effects.sideEffects &&
+        (effects.registersRead & effects.registersWritten) == 0 &&
+        (effects.flagsRead & effects.flagsWritten) == 0;
+}
+
+// Accounts for the trips round an idle loop needed to reach the deadline,
+// overshooting it by less than a trip as running them would
+//
+auto Jitter6502::skipIdleLoop(const Block &loop)->void
+{
+    if (context_.cpu.cycles >= context_.deadline) {
+        return;
+    }
+
+    auto trips = (context_.deadline - context_.cpu.cycles + loop.idleCycles - 1) / loop.idleCycles;
+    context_.cpu.cycles += trips * loop.idleCycles;
+    context_.instructions += trips * loop.idleInstructions;
+    counters_.countIdleSkip(trips * loop.idleCycles);
+}
+
+// The base address a block move's operand indexes from: the operand itself,
+// or for (zp),Y the pointer there, so long as reading it calls no device
+//
+auto Jitter6502::blockMoveBase(AddressingMode mode, uint16_t operand, TargetAddress *base) const->bool
+{
+    if (mode != IndirectY) {
+        *base = operand;
+        return true;
+    }
+
+    auto high = static_cast<TargetAddress>((operand + 1) & 0xFF);
+    if (!memory_->isPlain(operand, 1, false) || !memory_->isPlain(high, 1, false)) {
+        return false;
+    }
+    *base = memory_->peekByte(operand) | memory_->peekByte(high) << 8;
+    return true;
+}
+
+// Runs every remaining trip of a block move as one host copy or fill, leaving
+// the guest as the last trip would. The trips visit each index from the
+// lowest in turn; counting down from 0 visits all 256, 0 first. Copies whose
+// source and destination overlap are only done when no trip reads a byte an
+// earlier one wrote, which is when reading the whole source first gives the
+// same bytes.
+//
+auto Jitter6502::runBlockMove(const BlockMove &move)->bool
+{
+    auto &cpu = context_.cpu;
+    auto index = move.indexX ? cpu.x : cpu.y;
+    unsigned trips = move.increments ? 0x100 - index : index == 0 ? 0x100 : index;
+    unsigned lowest = move.increments || index == 0 ? index : 1;
+
+    TargetAddress source = 0, destination;
+    if (move.copies && !blockMoveBase(move.sourceMode, move.source, &source)) {
+        return false;
+    }
+    if (!blockMoveBase(move.destinationMode, move.destination, &destination)) {
+        return false;
+    }
+
+    auto from = source + lowest;
+    auto to = destination + lowest;
+    if (to + trips > 0x10000 || !memory_->isPlain(to, trips, true)) {
+        return false;
+    }
+    if (move.copies && (from + trips > 0x10000 || !memory_->isPlain(from, trips, false))) {
+        return false;
+    }
+
+    // Nothing the loop runs on may change under it, nor may code translated
+    // before, which the move would leave stale
+    auto overlaps = [&](unsigned start, unsigned length) {
+        return to < start + length && start < to + trips;
+    };
+    for (auto page = to >> 8; page <= (to + trips - 1) >> 8; page++) {
+        if (translatedPages_.test(page)) {
+            return false;
+        }
+    }
+    if (overlaps(move.loop, move.exit - move.loop) ||
+        (move.sourceMode == IndirectY && (overlaps(move.source, 1) || overlaps((move.source + 1) & 0xFF, 1))) ||
+        (move.destinationMode == IndirectY && (overlaps(move.destination, 1) || overlaps((move.destination + 1) & 0xFF, 1)))) {
+        return false;
+    }
+    if (move.copies && overlaps(from, trips) && !(move.increments ? to <= from : index != 0 && to >= from)) {
+        return false;
+    }
+
+    // A load indexed past the end of its base's page costs a cycle more
+    auto crossings = 0u;
+    if (move.sourcePenalty && (source & 0xFF) != 0) {
+        auto first = max(lowest, 0x100u - (source & 0xFF));
+        crossings = lowest + trips > first ? lowest + trips - first : 0;
+    }
+    auto cycles = uint64_t{ trips } * move.tripCycles + uint64_t{ trips - 1 } * move.branchCycles + crossings;
+    if (cpu.cycles + move.blockCycles + cycles > context_.deadline) {
+        return false;
+    }
+
+    if (move.copies) {
+        uint8_t bytes[0x100];
+        memory_->readBlock(from, bytes, trips);
+        memory_->writeBlock(to, bytes, trips);
+        cpu.a = bytes[(move.increments ? 0xFF : 0x01) - lowest];
+    }
+    else {
+        memory_->fill(to, cpu.a, trips);
+    }
+
+    (move.indexX ? cpu.x : cpu.y) = 0;
+    cpu.p = static_cast<uint8_t>((cpu.p & ~M6502_SIGN) | M6502_ZERO);
+    cpu.pc = move.exit;
+    cpu.cycles += cycles;
+    context_.instructions += uint64_t{ trips } * move.tripInstructions;
+    counters_.countBlockMove(trips);
+    return true;
+}
+
+auto Jitter6502::blockKey(TargetAddress pc) const->BlockKey
+{
+    return blockKey(pc, (context_.cpu.p & M6502_DECIMAL) != 0);
+}
+
+auto Jitter6502::blockKey(TargetAddress pc, bool decimal) const->BlockKey
+{
+    return static_cast<BlockKey>(memory_->bankAt(pc)) << 17 | (decimal ? DECIMAL_KEY : 0) | pc;
+}
+
+auto Jitter6502::buildReentryStub()->void
+{
+    // Save the host registers translated code uses, point EBP at the context,
+    // load the cached guest registers and jump to the block.
+    assembler_->beginCodeFragment();
+    assembler_->encodePushRegister(EBP);
+    assembler_->encodePushRegister(EBX);
+    if (AssemblerX86::X64) {
+        assembler_->encodeSubRegConstant(ESP, STACK_RESERVE);
+        assembler_->encodeMoveRegReg(EBP, ARG0);
+        assembler_->encodeMoveRegReg(EAX, ARG1);
+    }
+    else {
+        assembler_->encodeMoveRegPtrOffset(EBP, ESP, 12);
+        assembler_->encodeMoveRegPtrOffset(EAX, ESP, 16);
+    }
+    assembler_->encodeMovePtrOffsetReg(EBP, offsetof(VMContext, hostStack), ESP);
+    assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.a));
+    assembler_->encodeMoveReg8PtrOffset(BH, EBP, offsetof(VMContext, cpu.p));
+    assembler_->encodeJumpReg(EAX);
+    entryStub_ = reinterpret_cast<Entry>(assembler_->endCodeFragment("jit6502_entry"));
+
+    // Set up return
+    assembler_->beginCodeFragment();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.a), BL);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.p), BH);
+    assembler_->encodeMoveRegPtrOffset(ESP, EBP, offsetof(VMContext, hostStack));
+    if (AssemblerX86::X64) {
+        assembler_->encodeAddRegConstant(ESP, STACK_RESERVE);
+    }
+    assembler_->encodePopRegister(EBX);
+    assembler_->encodePopRegister(EBP);
+    assembler_->encodeRet();
+    exitStub_ = static_cast<NativeAddress>(assembler_->endCodeFragment("jit6502_exit"));
+}
+
+auto Jitter6502::buildFlagTranslationMap()->void
+{
+    for (int i = 0; i < 0x100; i++) {
+        uint8_t flags6502 = 0x00;
+        
+        if ((i & X86_CARRY) != 0) {
+            flags6502 |= M6502_CARRY;
+        }
+
+        if ((i & X86_ZERO) != 0) {
+            flags6502 |= M6502_ZERO;
+        }
+
+        if ((i & X86_SIGN) != 0) {
+            flags6502 |= M6502_SIGN;
+        }
+
+        flagTranslationMap_[i] = flags6502;
+    }
+}
+
+// Pushes PC and P and continues at the handler, as the 6502 does at the end
+// of the instruction during which an interrupt is seen. BRK is a software
+// interrupt: it pushes P with B set, and its block has counted its cycles.
+// The 65C02 also clears D, so handlers need not.
+//
+auto Jitter6502::enterInterrupt(TargetAddress vector, bool software)->void
+{
+    auto &cpu = context_.cpu;
+    auto pushed = software ? cpu.p | M6502_ALWAYS | M6502_BRK : (cpu.p | M6502_ALWAYS) & ~M6502_BRK;
+
+    memory_->writeByte(STACK_PAGE | cpu.s--, cpu.pc >> 8);
+    memory_->writeByte(STACK_PAGE | cpu.s--, cpu.pc & 0xFF);
+    memory_->writeByte(STACK_PAGE | cpu.s--, static_cast<uint8_t>(pushed));
+    cpu.p |= M6502_INTERRUPT;
+    if (model_ == CPU_65C02) {
+        cpu.p &= ~M6502_DECIMAL;
+    }
+    cpu.pc = memory_->readWord(vector);
+    if (!software) {
+        cpu.cycles += 7;
+    }
+}
+
+auto Jitter6502::readMemory(Jitter6502 *jitter, uint32_t address)->uint8_t
+{
+    auto data = jitter->memory_->readByte(static_cast<TargetAddress>(address));
+    jitter->context_.ioSite = NO_IO_SITE;
+    return data;
+}
+
+auto Jitter6502::writeMemory(Jitter6502 *jitter, uint32_t access)->void
+{
+    jitter->memory_->writeByte(static_cast<TargetAddress>(access >> 8), access & 0xFF);
+    jitter->context_.ioSite = NO_IO_SITE;
+}
+
+auto Jitter6502::readPointer(Jitter6502 *jitter, uint32_t address)->uint16_t
+{
+    auto low = jitter->memory_->readByte(static_cast<TargetAddress>(address & 0xFF));
+    auto high = jitter->memory_->readByte(static_cast<TargetAddress>((address + 1) & 0xFF));
+    return static_cast<uint16_t>(low | (high << 8));
+}
+
+// Each digit of the rotated result is corrected by the rule the NMOS 6502
+// applies after ADC, but judged on A & operand before the rotate. N is the
+// carry rotated in, Z and V come before correction, and C is the high
+// digit's correction.
+//
+auto Jitter6502::arrDecimal(Jitter6502 *jitter, uint32_t operand)->void
+{
+    auto &cpu = jitter->context_.cpu;
+    auto value = static_cast<uint8_t>(cpu.a & operand);
+    auto carry = (cpu.p & M6502_CARRY) != 0;
+    auto result = static_cast<uint8_t>((value >> 1) | (carry ? 0x80 : 0x00));
+
+    cpu.p &= ~(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN);
+    cpu.p |= carry ? M6502_SIGN : 0;
+    cpu.p |= result == 0 ? M6502_ZERO : 0;
+    cpu.p |= (result ^ value) & M6502_OVERFLOW;
+
+    if ((value & 0x0F) + (value & 0x01) > 0x05) {
+        result = static_cast<uint8_t>((result & 0xF0) | ((result + 0x06) & 0x0F));
+    }
+    if ((value & 0xF0) + (value & 0x10) > 0x50) {
+        result = static_cast<uint8_t>(result + 0x60);
+        cpu.p |= M6502_CARRY;
+    }
+    cpu.a = result;
+}
+
+auto Jitter6502::moveBlock(Jitter6502 *jitter, uint32_t move)->uint8_t
+{
+    return jitter->runBlockMove(jitter->blockMoves_[move]) ? 1 : 0;
+}
+
+// Each byte is added as ADC does in binary mode, SBC and CMP adding its
+// complement, and CMP with the carry set. Only the top byte's result is left
+// in A and N, Z, C and V.
+//
+auto Jitter6502::operateOnWord(Jitter6502 *jitter, uint32_t operation)->void
+{
+    auto &cpu = jitter->context_.cpu;
+    auto memory = jitter->memory_;
+    const auto &word = jitter->wordOperations_[operation];
+
+    unsigned carry = word.op == WordCompare ? 1 : word.setsCarry ? word.carry : cpu.p & M6502_CARRY;
+    auto value = uint8_t{ 0 };
+    auto overflow = false;
+    for (auto i = 0u; i < word.bytes; i++) {
+        unsigned left = memory->readByte(word.left[i]);
+        unsigned right = word.immediate[i] ? word.right[i] : memory->readByte(word.right[i]);
+        if (word.op != WordAdd) {
+            right ^= 0xFF;
+        }
+
+        auto sum = left + right + carry;
+        value = static_cast<uint8_t>(sum);
+        carry = sum >> 8;
+        overflow = (~(left ^ right) & (left ^ value) & 0x80) != 0;
+        if (word.op != WordCompare) {
+            memory->writeByte(word.result[i], value);
+        }
+    }
+
+    cpu.a = value;
+    cpu.p &= ~(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN);
+    cpu.p |= carry != 0 ? M6502_CARRY : 0;
+    cpu.p |= value == 0 ? M6502_ZERO : 0;
+    cpu.p |= overflow ? M6502_OVERFLOW : 0;
+    cpu.p |= value & M6502_SIGN;
+}
+
+//
+// Addressing modes. Those known at translation time cost nothing; the others
+// leave the address in EAX.
+//
+
+template<> auto Jitter6502::jit_address<ZeroPage>(uint16_t operand, bool)->EffectiveAddress
+{
+    return EffectiveAddress{ true, operand };
+}
+
+template<> auto Jitter6502::jit_address<Absolute>(uint16_t operand, bool)->EffectiveAddress
+{
+    return EffectiveAddress{ true, operand };
+}
+
+// Zero page indexing wraps within the zero page
+//
+template<> auto Jitter6502::jit_address<ZeroPageX>(uint16_t operand, bool)->EffectiveAddress
+{
+    assembler_->encodeMoveZeroExtendPtrOffset8(EAX, EBP, offsetof(VMContext, cpu.x));
+    assembler_->encodeAddReg8Constant(AL, static_cast<uint8_t>(operand));
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<ZeroPageY>(uint16_t operand, bool)->EffectiveAddress
+{
+    assembler_->encodeMoveZeroExtendPtrOffset8(EAX, EBP, offsetof(VMContext, cpu.y));
+    assembler_->encodeAddReg8Constant(AL, static_cast<uint8_t>(operand));
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<AbsoluteX>(uint16_t operand, bool again)->EffectiveAddress
+{
+    assembler_->encodeMoveRegConstant(EAX, operand);
+    jit_indexAddress(offsetof(VMContext, cpu.x), again);
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<AbsoluteY>(uint16_t operand, bool again)->EffectiveAddress
+{
+    assembler_->encodeMoveRegConstant(EAX, operand);
+    jit_indexAddress(offsetof(VMContext, cpu.y), again);
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<IndirectX>(uint16_t operand, bool)->EffectiveAddress
+{
+    assembler_->encodeMoveZeroExtendPtrOffset8(EAX, EBP, offsetof(VMContext, cpu.x));
+    assembler_->encodeAddReg8Constant(AL, static_cast<uint8_t>(operand));
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::readPointer));
+    assembler_->encodeMoveZeroExtendReg16(EAX, EAX);
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<IndirectY>(uint16_t operand, bool again)->EffectiveAddress
+{
+    jit_readPointer(operand);
+    jit_indexAddress(offsetof(VMContext, cpu.y), again);
+    return EffectiveAddress{ false, 0 };
+}
+
+template<> auto Jitter6502::jit_address<ZeroPageIndirect>(uint16_t operand, bool)->EffectiveAddress
+{
+    return jit_readPointer(operand);
+}
+
+template<AddressingMode Mode>
+auto Jitter6502::jit_loadOperand(uint16_t operand)->void
+{
+    jit_readMemory(jit_address<Mode>(operand), instruction_->cycles - 1);
+}
+
+template<> auto Jitter6502::jit_loadOperand<Immediate>(uint16_t operand)->void
+{
+    assembler_->encodeMoveReg8Constant(AL, static_cast<uint8_t>(operand));
+}
+
+//
+// Kinds of instruction
+//
+
+template<AddressingMode Mode, Jitter6502::Emitter Operation>
+auto Jitter6502::jitRead(TargetAddress *ip)->bool
+{
+    jit_loadOperand<Mode>(jit_fetchOperand(ip));
+    (this->*Operation)();
+    jit_countInstruction();
+    return true;
+}
+
+template<AddressingMode Mode, Jitter6502::Emitter Operation>
+auto Jitter6502::jitStore(TargetAddress *ip)->bool
+{
+    jit_writeMemory(jit_address<Mode>(jit_fetchOperand(ip)), instruction_->cycles - 1, Operation);
+    jit_countInstruction();
+    return true;
+}
+
+// The 6502 reads two cycles before the end and writes on the last. The address
+// is worked out again for the write, which for the modes that have to compute
+// it is cheaper than keeping it across the read.
+//
+template<AddressingMode Mode, Jitter6502::Emitter Operation>
+auto Jitter6502::jitModify(TargetAddress *ip)->bool
+{
+    auto operand = jit_fetchOperand(ip);
+    jit_readMemory(jit_address<Mode>(operand), instruction_->cycles - 3);
+    (this->*Operation)();
+    assembler_->encodeMoveRegReg8(CL, AL);
+    jit_writeMemory(jit_address<Mode>(operand, true), instruction_->cycles - 1, &Jitter6502::jit_modifiedData);
+    jit_countInstruction();
+    return true;
+}
+
+template<Jitter6502::Emitter Operation>
+auto Jitter6502::jitModifyA(TargetAddress *ip)->bool
+{
+    assembler_->encodeMoveRegReg8(AL, BL);
+    (this->*Operation)();
+    assembler_->encodeMoveRegReg8(BL, AL);
+    jit_countInstruction();
+    return true;
+}
+
+// Instructions which can unmask interrupts end their block, so the dispatcher
+// sees a pending IRQ
+//
+template<Jitter6502::Emitter Operation, bool EndsBlock>
+auto Jitter6502::jitImplied(TargetAddress *ip)->bool
+{
+    (this->*Operation)();
+    jit_countInstruction();
+    if (EndsBlock) {
+        jit_exitBlock(*ip);
+    }
+    return !EndsBlock;
+}
+
+// A taken branch leaves the block, costing a cycle more, or two if it lands
+// on another page; one not taken carries on with the block
+//
+template<M6502Flags Flag, bool Set>
+auto Jitter6502::jitBranch(TargetAddress *ip)->bool
+{
+    auto offset = static_cast<int8_t>(jit_fetchOperand(ip));
+    auto target = static_cast<TargetAddress>(*ip + offset);
+    jit_countInstruction();
+
+    assembler_->encodeTestReg8Constant(BH, Flag);
+    auto notTaken = assembler_->encodeJumpConditionalForward(Set ? CC_Z : CC_NZ);
+    jit_takeBranch(target, (target & 0xFF00) == (*ip & 0xFF00) ? 1 : 2);
+    assembler_->patchJump(notTaken);
+    return true;
+}
+
+auto Jitter6502::jitInvalidOpcode(TargetAddress *ip)->bool
+{
+    // Leave with cpu.pc at the opcode, for the dispatcher to report
+    (*ip)--;
+    jit_exitBlock(*ip, 0, ExitInvalidOpcode);
+    return false;
+}
+
+// BRA always leaves the block, a cycle later if it lands on another page
+//
+auto Jitter6502::jitBRA(TargetAddress *ip)->bool
+{
+    auto offset = static_cast<int8_t>(jit_fetchOperand(ip));
+    auto target = static_cast<TargetAddress>(*ip + offset);
+    blockIsTrap_ = target == blockStart_ && blockInstructions_ == 0;
+    jit_countInstruction();
+    jit_takeBranch(target, (target & 0xFF00) == (*ip & 0xFF00) ? 0 : 1);
+    return false;
+}
+
+// BRK skips the byte after it. The dispatcher pushes the return address and P
+// and enters the IRQ handler, as it does for an IRQ.
+//
+auto Jitter6502::jitBRK(TargetAddress *ip)->bool
+{
+    jit_countInstruction();
+    jit_exitBlock(static_cast<TargetAddress>(instructionStart_ + 2), 0, ExitBreak);
+    return false;
+}
+
+auto Jitter6502::jitJMP_ABS(TargetAddress *ip)->bool
+{
+    auto target = jit_fetchOperand(ip);
+    blockIsTrap_ = target == blockStart_ && blockInstructions_ == 0;
+    jit_countInstruction();
+    jit_takeBranch(target, 0);
+    return false;
+}
+
+// The NMOS 6502 does not carry into the high byte of the pointer, so JMP
+// ($xxFF) takes the high byte of its target from $xx00. The 65C02 does, at
+// the cost of a cycle.
+//
+template<CpuModel Model>
+auto Jitter6502::jitJMP_IND(TargetAddress *ip)->bool
+{
+    auto pointer = jit_fetchOperand(ip);
+    auto high = Model == CPU_65C02 ?
+        static_cast<TargetAddress>(pointer + 1) :
+        static_cast<TargetAddress>((pointer & 0xFF00) | ((pointer + 1) & 0x00FF));
+
+    // A vector in ROM is as good as the address itself
+    if (memory_->isROM(pointer) && memory_->isROM(high)) {
+        counters_.countROMReadsFolded(2);
+        jit_countInstruction();
+        jit_takeBranch(static_cast<TargetAddress>(memory_->peekByte(pointer) | memory_->peekByte(high) << 8), 0);
+        return false;
+    }
+
+    jit_readMemory(EffectiveAddress{ true, pointer }, instruction_->cycles - 2);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc), AL);
+    jit_readMemory(EffectiveAddress{ true, high }, instruction_->cycles - 1);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc) + 1, AL);
+    jit_countInstruction();
+    jit_exitBlockToStoredPC();
+    return false;
+}
+
+// JMP (abs,X) takes its target from the table entry X selects
+//
+auto Jitter6502::jitJMP_INDX(TargetAddress *ip)->bool
+{
+    auto table = jit_fetchOperand(ip);
+
+    assembler_->encodeMoveRegConstant(EAX, table);
+    jit_indexAddress(offsetof(VMContext, cpu.x));
+    jit_readMemory(EffectiveAddress{ false, 0 }, 4);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc), AL);
+    assembler_->encodeMoveRegConstant(EAX, static_cast<uint16_t>(table + 1));
+    jit_indexAddress(offsetof(VMContext, cpu.x));
+    jit_readMemory(EffectiveAddress{ false, 0 }, 5);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc) + 1, AL);
+    jit_countInstruction();
+    jit_exitBlockToStoredPC();
+    return false;
+}
+
+// JSR pushes the address of its own last byte; RTS comes back to the
+// instruction after it
+//
+auto Jitter6502::jitJSR(TargetAddress *ip)->bool
+{
+    auto target = jit_fetchOperand(ip);
+    auto returnAddress = static_cast<TargetAddress>(*ip - 1);
+
+    assembler_->encodeMoveReg8Constant(CL, static_cast<uint8_t>(returnAddress >> 8));
+    jit_push(CL);
+    assembler_->encodeMoveReg8Constant(CL, static_cast<uint8_t>(returnAddress & 0xFF));
+    jit_push(CL);
+    jit_countInstruction();
+    jit_noteExit(*ip);
+    jit_exitBlock(target);
+    return false;
+}
+
+auto Jitter6502::jitRTI(TargetAddress *ip)->bool
+{
+    opPLP();
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc), AL);
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc) + 1, AL);
+    jit_countInstruction();
+    jit_exitBlockToStoredPC();
+    return false;
+}
+
+auto Jitter6502::jitRTS(TargetAddress *ip)->bool
+{
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc), AL);
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.pc) + 1, AL);
+    assembler_->encodeIncPtrOffset16(EBP, offsetof(VMContext, cpu.pc));
+    jit_countInstruction();
+    jit_exitBlockToStoredPC();
+    return false;
+}
+
+//
+// Operations reading an operand from AL
+//
+
+// Binary arithmetic maps onto the host's; 6502 carry in and out is inverted
+// borrow for subtraction. The block is translated for one D flag, so only one
+// of binary and decimal arithmetic is ever emitted.
+//
+template<CpuModel Model>
+auto Jitter6502::opADC()->void
+{
+    if (jit_decimalMode()) {
+        jit_addDecimal();
+        if (Model == CPU_65C02) {
+            jit_decimalFlags();
+        }
+        return;
+    }
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeAdcRegReg8(BL, AL);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN);
+}
+
+auto Jitter6502::opAND()->void
+{
+    assembler_->encodeAndRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+// N and V are bits 7 and 6 of the operand; Z is set if A and it share no bits
+//
+auto Jitter6502::opBIT()->void
+{
+    assembler_->encodeMoveRegReg8(CL, AL);
+    assembler_->encodeAndReg8Constant(CL, M6502_SIGN | M6502_OVERFLOW);
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~(M6502_SIGN | M6502_OVERFLOW | M6502_ZERO)));
+    assembler_->encodeOrRegReg8(BH, CL);
+    assembler_->encodeTestRegReg8(BL, AL);
+    assembler_->encodeSetConditionReg8(CC_Z, CL);
+    assembler_->encodeShiftLeftReg8(CL, 1);
+    assembler_->encodeOrRegReg8(BH, CL);
+}
+
+// The 65C02's BIT #imm only sets Z
+//
+auto Jitter6502::opBITImmediate()->void
+{
+    assembler_->encodeTestRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO);
+}
+
+auto Jitter6502::opCMP()->void
+{
+    assembler_->encodeCmpRegReg8(BL, AL);
+    assembler_->encodeCMC();
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opCPX()->void
+{
+    assembler_->encodeCmpPtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AL);
+    assembler_->encodeCMC();
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opCPY()->void
+{
+    assembler_->encodeCmpPtrOffsetReg8(EBP, offsetof(VMContext, cpu.y), AL);
+    assembler_->encodeCMC();
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opEOR()->void
+{
+    assembler_->encodeXorRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opLDA()->void
+{
+    assembler_->encodeMoveRegReg8(BL, AL);
+    jit_setFlagsFromValue(BL);
+}
+
+auto Jitter6502::opLDX()->void
+{
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AL);
+    jit_setFlagsFromValue(AL);
+}
+
+auto Jitter6502::opLDY()->void
+{
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.y), AL);
+    jit_setFlagsFromValue(AL);
+}
+
+auto Jitter6502::opORA()->void
+{
+    assembler_->encodeOrRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+template<CpuModel Model>
+auto Jitter6502::opSBC()->void
+{
+    if (jit_decimalMode()) {
+        jit_subtractDecimal<Model>();
+        if (Model == CPU_65C02) {
+            jit_decimalFlags();
+        }
+        return;
+    }
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeCMC();
+    assembler_->encodeSbbRegReg8(BL, AL);
+    assembler_->encodeCMC();
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN);
+}
+
+//
+// Operations loading AL with the value to store
+//
+
+auto Jitter6502::opSTA()->void
+{
+    assembler_->encodeMoveRegReg8(AL, BL);
+}
+
+auto Jitter6502::opSTX()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AL, EBP, offsetof(VMContext, cpu.x));
+}
+
+auto Jitter6502::opSTY()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AL, EBP, offsetof(VMContext, cpu.y));
+}
+
+auto Jitter6502::opSTZ()->void
+{
+    assembler_->encodeMoveReg8Constant(AL, 0);
+}
+
+//
+// Operations modifying AL
+//
+
+auto Jitter6502::opASL()->void
+{
+    assembler_->encodeShiftLeftReg8(AL, 1);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opDEC()->void
+{
+    assembler_->encodeDecReg8(AL);
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opINC()->void
+{
+    assembler_->encodeIncReg8(AL);
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opLSR()->void
+{
+    assembler_->encodeShiftRightReg8(AL, 1);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+// Adding AL to itself with the carry in shifts it in, and sets every flag ROL
+// does
+//
+auto Jitter6502::opROL()->void
+{
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeAdcRegReg8(AL, AL);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+// RCR only sets the carry
+//
+auto Jitter6502::opROR()->void
+{
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeRotateCarryRightReg8(AL);
+    jit_setFlags(M6502_CARRY);
+    jit_setFlagsFromValue(AL);
+}
+
+// TRB and TSB set Z as BIT does, then clear or set the bits of A in memory
+//
+auto Jitter6502::opTRB()->void
+{
+    assembler_->encodeTestRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO);
+    assembler_->encodeMoveRegReg8(CL, BL);
+    assembler_->encodeNotReg8(CL);
+    assembler_->encodeAndRegReg8(AL, CL);
+}
+
+auto Jitter6502::opTSB()->void
+{
+    assembler_->encodeTestRegReg8(BL, AL);
+    jit_setFlags(M6502_ZERO);
+    assembler_->encodeOrRegReg8(AL, BL);
+}
+
+//
+// Operations on registers and flags
+//
+
+auto Jitter6502::opCLC()->void
+{
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~M6502_CARRY));
+}
+
+auto Jitter6502::opCLD()->void
+{
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~M6502_DECIMAL));
+    blockDecimal_ = false;
+    blockDecimalFromEntry_ = false;
+}
+
+auto Jitter6502::opCLI()->void
+{
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~M6502_INTERRUPT));
+}
+
+auto Jitter6502::opCLV()->void
+{
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~M6502_OVERFLOW));
+}
+
+auto Jitter6502::opDEX()->void
+{
+    assembler_->encodeDecPtrOffset8(EBP, offsetof(VMContext, cpu.x));
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opDEY()->void
+{
+    assembler_->encodeDecPtrOffset8(EBP, offsetof(VMContext, cpu.y));
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opINX()->void
+{
+    assembler_->encodeIncPtrOffset8(EBP, offsetof(VMContext, cpu.x));
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opINY()->void
+{
+    assembler_->encodeIncPtrOffset8(EBP, offsetof(VMContext, cpu.y));
+    jit_setFlags(M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opNOP()->void
+{
+}
+
+auto Jitter6502::opPHA()->void
+{
+    jit_push(BL);
+}
+
+// P is pushed with B and bit 5 set
+//
+auto Jitter6502::opPHP()->void
+{
+    assembler_->encodeMoveRegReg8(CL, BH);
+    assembler_->encodeOrReg8Constant(CL, M6502_BRK | M6502_ALWAYS);
+    jit_push(CL);
+}
+
+auto Jitter6502::opPHX()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(CL, EBP, offsetof(VMContext, cpu.x));
+    jit_push(CL);
+}
+
+auto Jitter6502::opPHY()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(CL, EBP, offsetof(VMContext, cpu.y));
+    jit_push(CL);
+}
+
+auto Jitter6502::opPLA()->void
+{
+    jit_pull();
+    assembler_->encodeMoveRegReg8(BL, AL);
+    jit_setFlagsFromValue(BL);
+}
+
+auto Jitter6502::opPLP()->void
+{
+    jit_pull();
+    assembler_->encodeMoveRegReg8(BH, AL);
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~M6502_BRK));
+    assembler_->encodeOrReg8Constant(BH, M6502_ALWAYS);
+}
+
+auto Jitter6502::opPLX()->void
+{
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AL);
+    jit_setFlagsFromValue(AL);
+}
+
+auto Jitter6502::opPLY()->void
+{
+    jit_pull();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.y), AL);
+    jit_setFlagsFromValue(AL);
+}
+
+auto Jitter6502::opSEC()->void
+{
+    assembler_->encodeOrReg8Constant(BH, M6502_CARRY);
+}
+
+auto Jitter6502::opSED()->void
+{
+    assembler_->encodeOrReg8Constant(BH, M6502_DECIMAL);
+    blockDecimal_ = true;
+    blockDecimalFromEntry_ = false;
+}
+
+auto Jitter6502::opSEI()->void
+{
+    assembler_->encodeOrReg8Constant(BH, M6502_INTERRUPT);
+}
+
+auto Jitter6502::opTAX()->void
+{
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), BL);
+    jit_setFlagsFromValue(BL);
+}
+
+auto Jitter6502::opTAY()->void
+{
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.y), BL);
+    jit_setFlagsFromValue(BL);
+}
+
+auto Jitter6502::opTSX()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AL, EBP, offsetof(VMContext, cpu.s));
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AL);
+    jit_setFlagsFromValue(AL);
+}
+
+auto Jitter6502::opTXA()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.x));
+    jit_setFlagsFromValue(BL);
+}
+
+auto Jitter6502::opTXS()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AL, EBP, offsetof(VMContext, cpu.x));
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.s), AL);
+}
+
+auto Jitter6502::opTYA()->void
 {
-    buildReentryStub();
-    buildFlagTranslationMap();
+    assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.y));
+    jit_setFlagsFromValue(BL);
 }
 
-auto Jitter6502::boot()->void
+//
+// NMOS undocumented operations
+//
+
+// A = (A & M) >> 1
+//
+auto Jitter6502::opALR()->void
 {
-    const TargetAddress RESET = 0xFFFC;
+    assembler_->encodeAndRegReg8(BL, AL);
+    assembler_->encodeShiftRightReg8(BL, 1);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
 
-    auto ip = memory_->readWord(RESET);
-    auto start = jit(ip);
+// AND, with N copied to C
+//
+auto Jitter6502::opANC()->void
+{
+    opAND();
+    assembler_->encodeMoveRegReg8(AL, BL);
+    assembler_->encodeShiftLeftReg8(AL, 1);
+    jit_setFlags(M6502_CARRY);
+}
 
-    try {
-        entryStub_(vm_, start);
+// AND then ROR A, with C from bit 6 of the result and V from bit 6 xor bit 5.
+// Shifting the result left twice puts them in CF and OF.
+//
+auto Jitter6502::opARR()->void
+{
+    if (jit_decimalMode()) {
+        assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.a), BL);
+        assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.p), BH);
+        assembler_->encodeMoveZeroExtendReg8(EAX, AL);
+        jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::arrDecimal));
+        assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.a));
+        assembler_->encodeMoveReg8PtrOffset(BH, EBP, offsetof(VMContext, cpu.p));
+        return;
     }
-    catch (runtime_error err) {
-        auto errText = oss{};
-        errText << "Runtime threw exception: " << err.what() << endl;
-        OutputDebugStringA(errText.str().c_str());
+    assembler_->encodeAndRegReg8(BL, AL);
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeRotateCarryRightReg8(BL);
+    jit_setFlagsFromValue(BL);
+    assembler_->encodeMoveRegReg8(AL, BL);
+    assembler_->encodeAddRegReg8(AL, AL);
+    assembler_->encodeAddRegReg8(AL, AL);
+    jit_setFlags(M6502_CARRY | M6502_OVERFLOW);
+}
+
+auto Jitter6502::opDCP()->void
+{
+    assembler_->encodeDecReg8(AL);
+    opCMP();
+}
+
+template<CpuModel Model>
+auto Jitter6502::opISC()->void
+{
+    assembler_->encodeIncReg8(AL);
+    opSBC<Model>();
+}
+
+auto Jitter6502::opLAX()->void
+{
+    opLDA();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AL);
+}
+
+auto Jitter6502::opRLA()->void
+{
+    opROL();
+    opAND();
+}
+
+// Decimal addition works in AL, so the rotated value to write back is kept
+// on the host stack meanwhile
+//
+template<CpuModel Model>
+auto Jitter6502::opRRA()->void
+{
+    opROR();
+    assembler_->encodePushRegister(EAX);
+    opADC<Model>();
+    assembler_->encodePopRegister(EAX);
+}
+
+auto Jitter6502::opSAX()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AL, EBP, offsetof(VMContext, cpu.x));
+    assembler_->encodeAndRegReg8(AL, BL);
+}
+
+// X = (A & X) - M, with C and the other flags as CMP sets them
+//
+auto Jitter6502::opSBX()->void
+{
+    assembler_->encodeMoveReg8PtrOffset(AH, EBP, offsetof(VMContext, cpu.x));
+    assembler_->encodeAndRegReg8(AH, BL);
+    assembler_->encodeSubRegReg8(AH, AL);
+    assembler_->encodeCMC();
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.x), AH);
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_SIGN);
+}
+
+auto Jitter6502::opSLO()->void
+{
+    opASL();
+    opORA();
+}
+
+auto Jitter6502::opSRE()->void
+{
+    opLSR();
+    opEOR();
+}
+
+// Whether the instruction being translated runs in decimal mode. Unless the
+// block has set or cleared D itself, that is an assumption the block's key
+// records.
+//
+auto Jitter6502::jit_decimalMode()->bool
+{
+    if (blockDecimalFromEntry_) {
+        blockDependsOnDecimal_ = true;
     }
+    return blockDecimal_;
 }
 
-auto Jitter6502::jit(TargetAddress ip)->NativeAddress
+//
+// Decimal arithmetic, without branches, as the NMOS 6502 does it. Each
+// digit's sum is corrected by adding 6 when it is over 9: comparing it with
+// 10 and subtracting with borrow from itself turns the carry into a mask of
+// the 6 to add.
+//
+
+// A + M + C with M in AL. Z comes from the binary sum; N and V from the sum
+// before the high digit is corrected.
+//
+auto Jitter6502::jit_addDecimal()->void
 {
-    auto inBlock = true;
+    // Z, as 0 or 1 in AH
+    assembler_->encodeMoveRegReg8(AH, BL);
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeAdcRegReg8(AH, AL);
+    assembler_->encodeSetConditionReg8(CC_Z, AH);
 
-    vm_->beginCodeFragment();
-    while (true) {
-        auto byte = memory_->readByte(ip++);
-        if (!(this->*jitters_[byte])(&ip)) {
-            break;
+    // Low digit in CL, corrected
+    assembler_->encodeMoveRegReg8(CL, BL);
+    assembler_->encodeAndReg8Constant(CL, 0x0F);
+    assembler_->encodeMoveRegReg8(DL, AL);
+    assembler_->encodeAndReg8Constant(DL, 0x0F);
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeAdcRegReg8(CL, DL);
+    assembler_->encodeCmpReg8Constant(CL, 10);
+    assembler_->encodeCMC();
+    assembler_->encodeSbbRegReg8(DL, DL);
+    assembler_->encodeAndReg8Constant(DL, 0x06);
+    assembler_->encodeAddRegReg8(CL, DL);
+
+    // High digit in CH, with the low digit's carry
+    assembler_->encodeMoveRegReg8(CH, BL);
+    assembler_->encodeShiftRightReg8(CH, 4);
+    assembler_->encodeMoveRegReg8(DL, AL);
+    assembler_->encodeShiftRightReg8(DL, 4);
+    assembler_->encodeCmpReg8Constant(CL, 0x10);
+    assembler_->encodeCMC();
+    assembler_->encodeAdcRegReg8(CH, DL);
+
+    // N is bit 7 of the uncorrected high digit, shifted into place; V is set
+    // when A and M have the same sign and it differs
+    assembler_->encodeMoveRegReg8(DL, CH);
+    assembler_->encodeShiftLeftReg8(DL, 4);
+    assembler_->encodeMoveRegReg8(DH, BL);
+    assembler_->encodeXorRegReg8(DH, DL);
+    assembler_->encodeXorRegReg8(AL, BL);
+    assembler_->encodeNotReg8(AL);
+    assembler_->encodeAndRegReg8(DH, AL);
+    assembler_->encodeAndReg8Constant(DL, M6502_SIGN);
+    assembler_->encodeShiftRightReg8(DH, 1);
+    assembler_->encodeAndReg8Constant(DH, M6502_OVERFLOW);
+    assembler_->encodeShiftLeftReg8(AH, 1);
+    assembler_->encodeOrRegReg8(DL, DH);
+    assembler_->encodeOrRegReg8(DL, AH);
+
+    // Correct the high digit; its carry is C
+    assembler_->encodeCmpReg8Constant(CH, 10);
+    assembler_->encodeCMC();
+    assembler_->encodeSbbRegReg8(AL, AL);
+    assembler_->encodeAndReg8Constant(AL, 0x06);
+    assembler_->encodeAddRegReg8(CH, AL);
+    assembler_->encodeCmpReg8Constant(CH, 0x10);
+    assembler_->encodeCMC();
+    assembler_->encodeAdcReg8Constant(DL, 0);
+
+    assembler_->encodeShiftLeftReg8(CH, 4);
+    assembler_->encodeAndReg8Constant(CL, 0x0F);
+    assembler_->encodeOrRegReg8(CL, CH);
+    assembler_->encodeMoveRegReg8(BL, CL);
+    assembler_->encodeAndReg8Constant(BH, static_cast<uint8_t>(~(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN)));
+    assembler_->encodeOrRegReg8(BH, DL);
+}
+
+// A - M - !C with M in AL. Every flag comes from the binary difference. The
+// NMOS 6502 takes 6 off each digit that borrows; the 65C02 takes $60 off the
+// whole difference if it borrows, then 6 more if the low digit did. The two
+// only differ when a digit is not BCD.
+//
+template<CpuModel Model>
+auto Jitter6502::jit_subtractDecimal()->void
+{
+    // Low digit in CL; DH is all ones if it borrowed
+    assembler_->encodeMoveRegReg8(CL, BL);
+    assembler_->encodeAndReg8Constant(CL, 0x0F);
+    assembler_->encodeMoveRegReg8(DL, AL);
+    assembler_->encodeAndReg8Constant(DL, 0x0F);
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeCMC();
+    assembler_->encodeSbbRegReg8(CL, DL);
+    assembler_->encodeSbbRegReg8(DH, DH);
+
+    if (Model == CPU_65C02) {
+        // The binary difference in CL; DL is all ones if it borrowed
+        assembler_->encodeMoveRegReg8(CL, BL);
+        assembler_->encodeBitTestRegConstant(EBX, 8);
+        assembler_->encodeCMC();
+        assembler_->encodeSbbRegReg8(CL, AL);
+        assembler_->encodeSbbRegReg8(DL, DL);
+        assembler_->encodeAndReg8Constant(DL, 0x60);
+        assembler_->encodeSubRegReg8(CL, DL);
+        assembler_->encodeAndReg8Constant(DH, 0x06);
+        assembler_->encodeSubRegReg8(CL, DH);
+    }
+    else {
+        // High digit in CH, less the low digit's borrow, corrected if negative
+        assembler_->encodeMoveRegReg8(CH, BL);
+        assembler_->encodeShiftRightReg8(CH, 4);
+        assembler_->encodeMoveRegReg8(DL, AL);
+        assembler_->encodeShiftRightReg8(DL, 4);
+        assembler_->encodeSubRegReg8(CH, DL);
+        assembler_->encodeAddRegReg8(CH, DH);
+        assembler_->encodeMoveRegReg8(DL, CH);
+        assembler_->encodeAddRegReg8(DL, DL);
+        assembler_->encodeSbbRegReg8(DL, DL);
+        assembler_->encodeAndReg8Constant(DL, 0x06);
+        assembler_->encodeSubRegReg8(CH, DL);
+
+        assembler_->encodeAndReg8Constant(DH, 0x06);
+        assembler_->encodeSubRegReg8(CL, DH);
+        assembler_->encodeShiftLeftReg8(CH, 4);
+        assembler_->encodeAndReg8Constant(CL, 0x0F);
+        assembler_->encodeOrRegReg8(CL, CH);
+    }
+
+    // The flags of the binary difference, with the result going to A
+    assembler_->encodeMoveRegReg8(AH, BL);
+    assembler_->encodeMoveRegReg8(BL, CL);
+    assembler_->encodeBitTestRegConstant(EBX, 8);
+    assembler_->encodeCMC();
+    assembler_->encodeSbbRegReg8(AH, AL);
+    assembler_->encodeCMC();
+    jit_setFlags(M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN);
+}
+
+// The 65C02 sets N and Z from the decimal result, which takes it a cycle more
+//
+auto Jitter6502::jit_decimalFlags()->void
+{
+    blockCycles_++;
+    jit_setFlagsFromValue(BL);
+}
+
+// Reads the bytes after the opcode, as many as the opcode table says it has
+//
+auto Jitter6502::jit_fetchOperand(TargetAddress *ip)->uint16_t
+{
+    auto operand = uint16_t{ 0 };
+    if (instruction_->length == 2) {
+        operand = memory_->readByte(*ip);
+    }
+    else if (instruction_->length == 3) {
+        operand = memory_->readWord(*ip);
+    }
+    *ip += instruction_->length - 1;
+    return operand;
+}
+
+// Adds the index register at offset in the context to the address in EAX.
+// Where the opcode costs a cycle more for crossing a page, that is added to
+// cpu.cycles straight away, so devices still see exact cycles.
+//
+auto Jitter6502::jit_indexAddress(size_t index, bool again)->void
+{
+    auto penalty = instruction_->pageCrossPenalty && !again;
+
+    assembler_->encodeAddReg8PtrOffset(AL, EBP, static_cast<uint32_t>(index));
+    if (penalty) {
+        assembler_->encodeSetConditionReg8(CC_C, DL);
+    }
+    assembler_->encodeAdcReg8Constant(AH, 0);
+
+    if (penalty) {
+        assembler_->encodeMoveZeroExtendReg8(EDX, DL);
+        assembler_->encodeAddPtrOffsetReg(EBP, offsetof(VMContext, cpu.cycles), EDX);
+        if (!AssemblerX86::X64) {
+            assembler_->encodeAdcPtrOffsetConstant(EBP, offsetof(VMContext, cpu.cycles) + 4, 0);
         }
+        blockCyclesVary_ = true;
     }
-    return vm_->endCodeFragment();
 }
 
-auto Jitter6502::buildReentryStub()->void
+// A block move loop first tries running the whole loop at once, and is
+// translated as usual for when that cannot be done, its branch back looping
+// to just after the try. The loop is recognised by its opcodes: an optional
+// LDA and an STA, both indexed by the register the following INX, DEX, INY
+// or DEY steps, then a BNE back.
+//
+auto Jitter6502::jit_blockMove(TargetAddress ip)->void
 {
-    // Set up stack, EDI -> VM, and jump to entry
-    assembler_->beginCodeFragment();
-    assembler_->encodePushRegister(EBP);
-    assembler_->encodeMoveRegReg(EBP, ESP);
-    assembler_->encodeXorReg(EBX, EBX);
-    assembler_->encodeMoveRegPtrOffset(EDI, EBP, 8);
-    assembler_->encodeJumpIndirect(EBP, 12);
-    entryStub_ = static_cast<Entry>(assembler_->endCodeFragment());
+    auto move = BlockMove{};
+    move.loop = ip;
+    move.blockCycles = blockCycles_;
 
-    // Set up return
-    assembler_->beginCodeFragment();
-    assembler_->encodeMoveRegReg(ESP, EBP);
-    assembler_->encodePopRegister(EBP);
-    assembler_->encodeRet();
-    exitStub_ = static_cast<Exit>(assembler_->endCodeFragment());
+    auto opcode = memory_->peekByte(ip);
+    if (opcode == 0xBD || opcode == 0xB9 || opcode == 0xB1) {
+        move.copies = true;
+        move.sourceMode = opcodes_[opcode].mode;
+        move.source = memory_->peekByte(ip + 1) | (opcodes_[opcode].length == 3 ? memory_->peekByte(ip + 2) << 8 : 0);
+        move.sourcePenalty = opcodes_[opcode].pageCrossPenalty;
+        move.tripCycles += opcodes_[opcode].cycles;
+        move.tripInstructions++;
+        ip += opcodes_[opcode].length;
+        opcode = memory_->peekByte(ip);
+    }
+    if (opcode != 0x9D && opcode != 0x99 && opcode != 0x91) {
+        return;
+    }
+    move.destinationMode = opcodes_[opcode].mode;
+    move.destination = memory_->peekByte(ip + 1) | (opcodes_[opcode].length == 3 ? memory_->peekByte(ip + 2) << 8 : 0);
+    move.tripCycles += opcodes_[opcode].cycles;
+    move.tripInstructions++;
+    ip += opcodes_[opcode].length;
+
+    opcode = memory_->peekByte(ip);
+    switch (opcode) {
+    case 0xE8: move.indexX = true; move.increments = true; break;
+    case 0xCA: move.indexX = true; move.increments = false; break;
+    case 0xC8: move.indexX = false; move.increments = true; break;
+    case 0x88: move.indexX = false; move.increments = false; break;
+    default:
+        return;
+    }
+    if ((move.destinationMode == AbsoluteX) != move.indexX || (move.copies && (move.sourceMode == AbsoluteX) != move.indexX)) {
+        return;
+    }
+    move.tripCycles += opcodes_[opcode].cycles;
+    move.tripInstructions++;
+    ip += opcodes_[opcode].length;
+
+    move.exit = static_cast<TargetAddress>(ip + 2);
+    if (memory_->peekByte(ip) != 0xD0 || static_cast<TargetAddress>(move.exit + static_cast<int8_t>(memory_->peekByte(ip + 1))) != move.loop) {
+        return;
+    }
+    if (move.exit < move.loop || memory_->bankAt(move.exit - 1) != blockBank_) {
+        return;
+    }
+    move.tripCycles += opcodes_[0xD0].cycles;
+    move.tripInstructions++;
+    move.branchCycles = (move.loop & 0xFF00) == (move.exit & 0xFF00) ? 1 : 2;
+
+    blockMoves_.push_back(move);
+    counters_.countBlockMoveLoop();
+    jit_noteExit(move.exit);
+
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.a), BL);
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.p), BH);
+    assembler_->encodeMoveRegConstant(EAX, static_cast<uint32_t>(blockMoves_.size() - 1));
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::moveBlock));
+    assembler_->encodeTestRegReg8(AL, AL);
+    auto cannot = assembler_->encodeJumpConditionalForward(CC_Z);
+    assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.a));
+    assembler_->encodeMoveReg8PtrOffset(BH, EBP, offsetof(VMContext, cpu.p));
+    jit_exitBlockToStoredPC();
+    assembler_->patchJump(cannot);
 }
 
-auto Jitter6502::buildFlagTranslationMap()->void
+// Translates a word operation at ip as one helper call rather than an
+// instruction at a time, each reaching memory through a helper of its own. Only
+// done in binary mode, and when no byte it touches is a device's; the helper
+// runs the instructions in order, so overlapping addresses come out the same.
+//
+auto Jitter6502::jit_wordOperation(TargetAddress *ip)->bool
 {
-    for (int i = 0; i < 0x100; i++) {
-        uint8_t flags6502 = 0x00;
-        
-        if ((i & X86_CARRY) != 0) {
-            flags6502 |= M6502_CARRY;
+    auto word = WordOperation{};
+    auto at = *ip;
+    uint8_t fused[MAX_WORD_BYTES * 3 + 1];
+    auto count = 0;
+
+    // Takes the instruction at at if it is one of opcodes, returning which
+    auto take = [&](const uint8_t *opcodes, size_t length, uint16_t *operand) {
+        auto opcode = memory_->peekByte(at);
+        auto found = std::find(opcodes, opcodes + length, opcode);
+        if (found == opcodes + length) {
+            return -1;
         }
+        auto next = static_cast<TargetAddress>(at + 1);
+        *operand = memory_->peekByte(next);
+        if (opcodes_[opcode].length == 3) {
+            *operand |= memory_->peekByte(static_cast<TargetAddress>(next + 1)) << 8;
+        }
+        fused[count++] = opcode;
+        at += opcodes_[opcode].length;
+        return static_cast<int>(found - opcodes);
+    };
 
-        if ((i & X86_ZERO) != 0) {
-            flags6502 |= M6502_ZERO;
+    // Takes the next byte's instructions, or nothing
+    auto step = [&](unsigned i) {
+        auto start = at;
+        auto taken = count;
+        if (take(WORD_LOADS, 2, &word.left[i]) < 0) {
+            return false;
         }
+        if (i == 0) {
+            uint16_t none;
+            auto carry = take(WORD_CARRIES, 2, &none);
+            word.setsCarry = carry >= 0;
+            word.carry = carry == 1;
 
-        if ((i & X86_SIGN) != 0) {
-            flags6502 |= M6502_SIGN;
+            auto opcode = memory_->peekByte(at);
+            auto op = 0;
+            while (op < 3 && std::find(WORD_OPERATORS[op], WORD_OPERATORS[op] + 3, opcode) == WORD_OPERATORS[op] + 3) {
+                op++;
+            }
+            if (op == 3) {
+                return false;
+            }
+            word.op = static_cast<WordOperator>(op);
         }
 
-        flagTranslationMap_[i] = flags6502;
+        // A compare's higher bytes are subtracted with the borrow from below
+        auto mode = take(WORD_OPERATORS[i != 0 && word.op == WordCompare ? WordSubtract : word.op], 3, &word.right[i]);
+        if (mode >= 0) {
+            word.immediate[i] = mode == 2;
+            if (word.op == WordCompare || take(WORD_STORES, 2, &word.result[i]) >= 0) {
+                return true;
+            }
+        }
+        at = start;
+        count = taken;
+        return false;
+    };
+    while (word.bytes < MAX_WORD_BYTES && step(word.bytes)) {
+        word.bytes++;
+    }
+    if (word.bytes < 2) {
+        return false;
+    }
+
+    for (auto i = 0u; i < word.bytes; i++) {
+        if (memory_->deviceAt(word.left[i]) != nullptr ||
+            (!word.immediate[i] && memory_->deviceAt(word.right[i]) != nullptr) ||
+            (word.op != WordCompare && memory_->deviceAt(word.result[i]) != nullptr)) {
+            return false;
+        }
+    }
+    if (static_cast<TargetAddress>(at - 1) < *ip ||
+        blockInstructions_ + count > MAX_BLOCK_INSTRUCTIONS ||
+        memory_->bankAt(static_cast<TargetAddress>(at - 1)) != blockBank_) {
+        return false;
+    }
+    if (jit_decimalMode()) {
+        return false;
+    }
+
+    wordOperations_.push_back(word);
+    counters_.countWordOperation();
+
+    assembler_->encodeMovePtrOffsetReg8(EBP, offsetof(VMContext, cpu.p), BH);
+    assembler_->encodeMoveRegConstant(EAX, static_cast<uint32_t>(wordOperations_.size() - 1));
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::operateOnWord));
+    assembler_->encodeMoveReg8PtrOffset(BL, EBP, offsetof(VMContext, cpu.a));
+    assembler_->encodeMoveReg8PtrOffset(BH, EBP, offsetof(VMContext, cpu.p));
+
+    for (auto i = 0; i < count; i++) {
+        instruction_ = &opcodes_[fused[i]];
+        jit_noteEffects(*instruction_);
+        jit_countInstruction();
     }
+    *ip = at;
+    return true;
 }
 
+// Adds what the opcode table says an instruction reads and writes to the
+// block's effects. Whether a read reaches a device depends on the address, so
+// jit_readMemory notes that.
+//
+auto Jitter6502::jit_noteEffects(const OpcodeInfo &info)->void
+{
+    addEffects(&blockEffects_, info);
+}
 
-auto Jitter6502::invalidOpcodeStub(TargetAddress addr)->void 
+auto Jitter6502::addEffects(BlockEffects *effects, const OpcodeInfo &info)->void
 {
-    oss()
-        << "Execution terminated at "
-        << setw(4) << setfill('0') << hex << addr
-        << "; invalid opcode"
-        << throwError;
+    effects->registersRead |= info.registersRead & ~effects->registersWritten;
+    effects->flagsRead |= info.flagsRead & ~effects->flagsWritten;
+    effects->registersWritten |= info.registersWritten;
+    effects->flagsWritten |= info.flagsWritten;
+    if ((info.access & (AccessWrite | AccessStack)) != 0) {
+        effects->sideEffects = true;
+    }
 }
 
-auto Jitter6502::jitInvalidOpcode(TargetAddress *ip)->bool
+auto Jitter6502::jit_noteSideEffect()->void
 {
-    assembler_->encodeMoveRegConstant(EAX, *ip - 1);
-    assembler_->encodePushRegister(EAX);
-    assembler_->encodeCall(ToNativeAddress(&invalidOpcodeStub));
-    // no need to clean up, exception will have been thrown
-    return false;
+    blockEffects_.sideEffects = true;
 }
 
-auto Jitter6502::jitLDA_IMM(TargetAddress *ip)->bool
+// Sets the guest flags in mask from the host flags the last operation left: C,
+// Z and N through the flag translation map, V from OF. AL is left alone.
+//
+auto Jitter6502::jit_setFlags(uint8_t mask)->void
 {
-    jit_getImmediateIntoAL(ip);
-    assembler_->encodeMoveRegReg8(BL, AL);
-    assembler_->encodeOrRegReg8(BL, BL);
+    assembler_->encodeLAHF();
+    assembler_->encodeMoveZeroExtendReg8(ECX, AH);
+    if ((mask & M6502_OVERFLOW) != 0) {
+        assembler_->encodeSetConditionReg8(CC_O, AH);
+    }
+    assembler_->encodeMoveRegPointer(EDX, flagTranslationMap_.data());
+    assembler_->encodeMoveReg8Indexed(DL, EDX, ECX);
+    if ((mask & M6502_OVERFLOW) != 0) {
+        assembler_->encodeShiftLeftReg8(AH, 6);
+        assembler_->encodeOrRegReg8(DL, AH);
+    }
+    assembler_->encodeAndReg8Constant(DL, mask);
+    assembler_->encodeAndReg8Constant(BH, ~mask);
+    assembler_->encodeOrRegReg8(BH, DL);
+}
+
+// Sets Z and N from the value in reg
+//
+auto Jitter6502::jit_setFlagsFromValue(X86Register8 reg)->void
+{
+    assembler_->encodeTestRegReg8(reg, reg);
     jit_setFlags(M6502_ZERO | M6502_SIGN);
-    return true;
 }
 
-auto Jitter6502::jit_getImmediateIntoAL(TargetAddress *ip)->void
+auto Jitter6502::jit_countInstruction()->void
 {
-    auto imm = memory_->readByte(*ip);
-    (*ip)++;
-    assembler_->encodeMoveReg8Constant(AL, imm);
+    blockCycles_ += instruction_->cycles;
+    blockInstructions_++;
 }
 
-auto Jitter6502::jit_setFlags(uint8_t mask)->void
+// Reads guest memory into AL. accessCycle is the cycle of the instruction on
+// which the 6502 makes the access, for devices asking when it happened. An
+// address only known at run time may be a device's; one in ROM is read now.
+//
+auto Jitter6502::jit_readMemory(EffectiveAddress address, unsigned accessCycle)->void
+{
+    if (address.known && memory_->isROM(address.address)) {
+        counters_.countROMReadsFolded(1);
+        assembler_->encodeMoveRegConstant(EAX, memory_->peekByte(address.address));
+        return;
+    }
+    auto device = address.known ? memory_->deviceAt(address.address) : nullptr;
+    if (!address.known || device != nullptr) {
+        jit_recordIOSite(accessCycle);
+        jit_noteSideEffect();
+    }
+    if (address.known) {
+        assembler_->encodeMoveRegConstant(EAX, address.address);
+    }
+    if (device != nullptr) {
+        jit_callDevice(reinterpret_cast<NativeAddress>(device->read), device->device, false);
+        return;
+    }
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::readMemory));
+}
+
+// Leaves the pointer at a zero page address in EAX. One in ROM is known now,
+// as is what it points at.
+//
+auto Jitter6502::jit_readPointer(uint16_t operand)->EffectiveAddress
+{
+    auto high = static_cast<TargetAddress>((operand + 1) & 0xFF);
+    if (memory_->isROM(operand) && memory_->isROM(high)) {
+        counters_.countROMReadsFolded(2);
+        auto pointer = static_cast<uint16_t>(memory_->peekByte(operand) | memory_->peekByte(high) << 8);
+        assembler_->encodeMoveRegConstant(EAX, pointer);
+        return EffectiveAddress{ true, pointer };
+    }
+
+    assembler_->encodeMoveRegConstant(EAX, operand);
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::readPointer));
+    assembler_->encodeMoveZeroExtendReg16(EAX, EAX);
+    return EffectiveAddress{ false, 0 };
+}
+
+// Writes the value data loads into AL to guest memory
+//
+auto Jitter6502::jit_writeMemory(EffectiveAddress address, unsigned accessCycle, Emitter data)->void
+{
+    auto device = address.known ? memory_->deviceAt(address.address) : nullptr;
+    if (!address.known || device != nullptr) {
+        jit_recordIOSite(accessCycle);
+    }
+    if (address.known) {
+        assembler_->encodeMoveRegConstant(EAX, address.address << 8);
+    }
+    else {
+        assembler_->encodeShiftLeftReg(EAX, 8);
+    }
+    (this->*data)();
+    if (device != nullptr) {
+        jit_callDevice(reinterpret_cast<NativeAddress>(device->write), device->device, true);
+        return;
+    }
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::writeMemory));
+}
+
+auto Jitter6502::jit_modifiedData()->void
+{
+    assembler_->encodeMoveRegReg8(AL, CL);
+}
+
+// Pushes data, which must not be in EAX
+//
+auto Jitter6502::jit_push(X86Register8 data)->void
+{
+    assembler_->encodeMoveZeroExtendPtrOffset8(EAX, EBP, offsetof(VMContext, cpu.s));
+    assembler_->encodeOrReg8Constant(AH, STACK_PAGE >> 8);
+    assembler_->encodeShiftLeftReg(EAX, 8);
+    assembler_->encodeMoveRegReg8(AL, data);
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::writeMemory));
+    assembler_->encodeDecPtrOffset8(EBP, offsetof(VMContext, cpu.s));
+}
+
+// Pulls into AL
+//
+auto Jitter6502::jit_pull()->void
+{
+    assembler_->encodeIncPtrOffset8(EBP, offsetof(VMContext, cpu.s));
+    assembler_->encodeMoveZeroExtendPtrOffset8(EAX, EBP, offsetof(VMContext, cpu.s));
+    assembler_->encodeOrReg8Constant(AH, STACK_PAGE >> 8);
+    jit_callHelper(reinterpret_cast<NativeAddress>(&Jitter6502::readMemory));
+}
+
+// Records the instruction being translated as an IO site, and stores its key
+// for the helper about to be called
+//
+auto Jitter6502::jit_recordIOSite(unsigned accessCycle)->void
+{
+    ioSites_.push_back(IOSite{ instructionStart_, blockCycles_ + accessCycle });
+    assembler_->encodeMovePtrOffsetConstant32(EBP, offsetof(VMContext, ioSite), static_cast<uint32_t>(ioSites_.size()));
+}
+
+// Calls a memory helper with the translator and the value in EAX. Guest A and
+// P stay in BL and BH, which the host ABIs preserve across calls.
+//
+auto Jitter6502::jit_callHelper(NativeAddress helper)->void
+{
+    if (AssemblerX86::X64) {
+        assembler_->encodeMoveRegReg(ARG1, EAX);
+        assembler_->encodeMoveRegPointer(ARG0, this);
+        assembler_->encodeCall(helper);
+    }
+    else {
+        assembler_->encodePushRegister(EAX);
+        assembler_->encodeMoveRegPointer(EAX, this);
+        assembler_->encodePushRegister(EAX);
+        assembler_->encodeCall(helper);
+        assembler_->encodeAddRegConstant(ESP, 8);
+    }
+}
+
+// Calls a device bound at an address known now straight through its binding,
+// rather than through a helper finding it again. A read takes the address in
+// EAX and leaves the data in AL; a write takes the access in EAX, as
+// writeMemory does. The IO site key is cleared after, as the helpers do.
+//
+auto Jitter6502::jit_callDevice(NativeAddress function, void *device, bool writing)->void
+{
+    if (AssemblerX86::X64) {
+        if (writing) {
+#ifdef _WIN32
+            assembler_->encodeMoveZeroExtendReg8(ARG1, AL);
+            assembler_->encodeMoveR8Reg(ARG1);
+#else
+            assembler_->encodeMoveZeroExtendReg8(ARG2, AL);
+#endif
+        }
+        assembler_->encodeMoveRegReg(ARG1, EAX);
+        if (writing) {
+            assembler_->encodeShiftRightReg(ARG1, 8);
+        }
+        assembler_->encodeMoveRegPointer(ARG0, device);
+        assembler_->encodeCall(function);
+    }
+    else {
+        if (writing) {
+            assembler_->encodeMoveZeroExtendReg8(ECX, AL);
+            assembler_->encodePushRegister(ECX);
+            assembler_->encodeShiftRightReg(EAX, 8);
+        }
+        assembler_->encodePushRegister(EAX);
+        assembler_->encodeMoveRegPointer(EAX, device);
+        assembler_->encodePushRegister(EAX);
+        assembler_->encodeCall(function);
+        assembler_->encodeAddRegConstant(ESP, writing ? 12 : 8);
+    }
+    assembler_->encodeMovePtrOffsetConstant32(EBP, offsetof(VMContext, ioSite), NO_IO_SITE);
+}
+
+// Adds count to a 64-bit counter in the context
+//
+auto Jitter6502::jit_addCounter(size_t offset, uint32_t count)->void
+{
+    if (AssemblerX86::X64) {
+        assembler_->encodeAddPtrOffsetConstant64(EBP, static_cast<uint32_t>(offset), count);
+    }
+    else {
+        assembler_->encodeAddPtrOffsetConstant(EBP, static_cast<uint32_t>(offset), count);
+        assembler_->encodeAdcPtrOffsetConstant(EBP, static_cast<uint32_t>(offset + 4), 0);
+    }
+}
+
+// Leaves the block, continuing at guest address next, or with a reason for the
+// dispatcher to deal with first. extraCycles are those of the way out taken,
+// on top of the instructions the block has run.
+//
+auto Jitter6502::jit_exitBlock(TargetAddress next, unsigned extraCycles, ExitReason reason)->void
+{
+    // A way back round to the start; what a trip costs is only known here,
+    // and a loop with ways back of different costs has no one trip to skip
+    if (next == blockStart_) {
+        if (blockIdleCycles_ == 0) {
+            blockIdleCycles_ = blockCycles_ + extraCycles;
+            blockIdleInstructions_ = blockInstructions_;
+        }
+        else if (blockIdleCycles_ != blockCycles_ + extraCycles || blockIdleInstructions_ != blockInstructions_) {
+            blockCyclesVary_ = true;
+        }
+    }
+    if (reason != ExitInvalidOpcode) {
+        jit_noteExit(next);
+    }
+
+    assembler_->encodeMovePtrOffsetConstant16(EBP, offsetof(VMContext, cpu.pc), next);
+    jit_leaveBlock(extraCycles, reason);
+}
+
+// Takes a branch or jump. One back to an instruction already translated in
+// this block, with D as it was there, loops round to it: the trip's cycles are
+// added as it goes round, and the block left for the target once they, with
+// the cycles before the target, reach the deadline. Those are only counted
+// then.
+//
+auto Jitter6502::jit_takeBranch(TargetAddress target, unsigned extraCycles)->void
+{
+    auto label = std::find_if(begin(blockLabels_), end(blockLabels_), [target](const BlockLabel &label) {
+        return label.pc == target;
+    });
+    if (label == end(blockLabels_) || label->decimal != blockDecimal_ || loopMayIdle(target)) {
+        jit_exitBlock(target, extraCycles);
+        return;
+    }
+    counters_.countNativeLoop();
+
+    jit_addCounter(offsetof(VMContext, cpu.cycles), blockCycles_ + extraCycles - label->cycles);
+    jit_addCounter(offsetof(VMContext, instructions), blockInstructions_ - label->instructions);
+    if (AssemblerX86::X64) {
+        assembler_->encodeMoveRegPtrOffset(EAX, EBP, offsetof(VMContext, cpu.cycles));
+        assembler_->encodeAddRegConstant(EAX, label->cycles);
+        assembler_->encodeCmpRegPtrOffset(EAX, EBP, offsetof(VMContext, deadline));
+        assembler_->encodeJumpConditional(CC_C, label->code);
+    }
+    else {
+        assembler_->encodeMoveRegPtrOffset(EAX, EBP, offsetof(VMContext, cpu.cycles));
+        assembler_->encodeMoveRegPtrOffset(EDX, EBP, offsetof(VMContext, cpu.cycles) + 4);
+        assembler_->encodeAddRegConstant(EAX, label->cycles);
+        assembler_->encodeAdcRegConstant(EDX, 0);
+        assembler_->encodeCmpRegPtrOffset(EDX, EBP, offsetof(VMContext, deadline) + 4);
+        assembler_->encodeJumpConditional(CC_C, label->code);
+        auto above = assembler_->encodeJumpConditionalForward(CC_NZ);
+        assembler_->encodeCmpRegPtrOffset(EAX, EBP, offsetof(VMContext, deadline));
+        assembler_->encodeJumpConditional(CC_C, label->code);
+        assembler_->patchJump(above);
+    }
+
+    jit_noteExit(target);
+    assembler_->encodeMovePtrOffsetConstant16(EBP, offsetof(VMContext, cpu.pc), target);
+    jit_addCounter(offsetof(VMContext, cpu.cycles), label->cycles);
+    jit_addCounter(offsetof(VMContext, instructions), label->instructions);
+    assembler_->encodeJump(exitStub_);
+}
+
+// Notes a guest address the block can go on to with a known PC, so that
+// pretranslate() can translate it too
+//
+auto Jitter6502::jit_noteExit(TargetAddress next)->void
+{
+    blockExits_.push_back(BlockExit{ next, blockDecimal_ });
+}
+
+// Leaves the block for the guest address translated code has stored in cpu.pc
+//
+auto Jitter6502::jit_exitBlockToStoredPC()->void
+{
+    jit_leaveBlock(0, ExitNone);
+}
+
+auto Jitter6502::jit_leaveBlock(unsigned extraCycles, ExitReason reason)->void
 {
-    if ((mask & (M6502_CARRY | M6502_ZERO | M6502_SIGN)) != 0) {
-        assembler_->encodeMoveRegConstant(EAX, 0);
-        assembler_->encodeLAHF();
-        assembler_->encodeShiftRightReg(EAX, 8);
-        assembler_->encodeMoveReg8PtrOffset(AL, EAX, reinterpret_cast<uint32_t>(&this->flagTranslationMap_));
-        assembler_->encodeAndReg8Constant(AL, mask);
-        assembler_->encodeAndReg8Constant(BH, ~mask);
-        assembler_->encodeOrRegReg8(BH, AL);
+    jit_addCounter(offsetof(VMContext, cpu.cycles), blockCycles_ + extraCycles);
+    jit_addCounter(offsetof(VMContext, instructions), blockInstructions_);
+    if (reason != ExitNone) {
+        assembler_->encodeMovePtrOffsetConstant16(EBP, offsetof(VMContext, exitReason), reason);
     }
+    assembler_->encodeJump(exitStub_);
 }
 
-array<Jitter6502::InstructionJitter, 256> Jitter6502::jitters_ = {
-    /*00*/ &Jitter6502::jitInvalidOpcode,
-    /*01*/ &Jitter6502::jitInvalidOpcode,
+const Jitter6502::JitterTable Jitter6502::nmosJitters_ = {
+    /*00*/ &Jitter6502::jitBRK,
+    /*01*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opORA>,
     /*02*/ &Jitter6502::jitInvalidOpcode,
     /*03*/ &Jitter6502::jitInvalidOpcode,
     /*04*/ &Jitter6502::jitInvalidOpcode,
-    /*05*/ &Jitter6502::jitInvalidOpcode,
-    /*06*/ &Jitter6502::jitInvalidOpcode,
+    /*05*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opORA>,
+    /*06*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opASL>,
     /*07*/ &Jitter6502::jitInvalidOpcode,
-    /*08*/ &Jitter6502::jitInvalidOpcode,
-    /*09*/ &Jitter6502::jitInvalidOpcode,
-    /*0A*/ &Jitter6502::jitInvalidOpcode,
+    /*08*/ &Jitter6502::jitImplied<&Jitter6502::opPHP>,
+    /*09*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opORA>,
+    /*0A*/ &Jitter6502::jitModifyA<&Jitter6502::opASL>,
     /*0B*/ &Jitter6502::jitInvalidOpcode,
     /*0C*/ &Jitter6502::jitInvalidOpcode,
-    /*0D*/ &Jitter6502::jitInvalidOpcode,
-    /*0E*/ &Jitter6502::jitInvalidOpcode,
+    /*0D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opORA>,
+    /*0E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opASL>,
     /*0F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*10*/ &Jitter6502::jitInvalidOpcode,
-    /*11*/ &Jitter6502::jitInvalidOpcode,
+    /*10*/ &Jitter6502::jitBranch<M6502_SIGN, false>,
+    /*11*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opORA>,
     /*12*/ &Jitter6502::jitInvalidOpcode,
     /*13*/ &Jitter6502::jitInvalidOpcode,
     /*14*/ &Jitter6502::jitInvalidOpcode,
-    /*15*/ &Jitter6502::jitInvalidOpcode,
-    /*16*/ &Jitter6502::jitInvalidOpcode,
+    /*15*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opORA>,
+    /*16*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opASL>,
     /*17*/ &Jitter6502::jitInvalidOpcode,
-    /*18*/ &Jitter6502::jitInvalidOpcode,
-    /*19*/ &Jitter6502::jitInvalidOpcode,
+    /*18*/ &Jitter6502::jitImplied<&Jitter6502::opCLC>,
+    /*19*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opORA>,
     /*1A*/ &Jitter6502::jitInvalidOpcode,
     /*1B*/ &Jitter6502::jitInvalidOpcode,
     /*1C*/ &Jitter6502::jitInvalidOpcode,
-    /*1D*/ &Jitter6502::jitInvalidOpcode,
-    /*1E*/ &Jitter6502::jitInvalidOpcode,
+    /*1D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opORA>,
+    /*1E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opASL>,
     /*1F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*20*/ &Jitter6502::jitInvalidOpcode,
-    /*21*/ &Jitter6502::jitInvalidOpcode,
+    /*20*/ &Jitter6502::jitJSR,
+    /*21*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opAND>,
     /*22*/ &Jitter6502::jitInvalidOpcode,
     /*23*/ &Jitter6502::jitInvalidOpcode,
-    /*24*/ &Jitter6502::jitInvalidOpcode,
-    /*25*/ &Jitter6502::jitInvalidOpcode,
-    /*26*/ &Jitter6502::jitInvalidOpcode,
+    /*24*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opBIT>,
+    /*25*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opAND>,
+    /*26*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROL>,
     /*27*/ &Jitter6502::jitInvalidOpcode,
-    /*28*/ &Jitter6502::jitInvalidOpcode,
-    /*29*/ &Jitter6502::jitInvalidOpcode,
-    /*2A*/ &Jitter6502::jitInvalidOpcode,
+    /*28*/ &Jitter6502::jitImplied<&Jitter6502::opPLP, true>,
+    /*29*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opAND>,
+    /*2A*/ &Jitter6502::jitModifyA<&Jitter6502::opROL>,
     /*2B*/ &Jitter6502::jitInvalidOpcode,
-    /*2C*/ &Jitter6502::jitInvalidOpcode,
-    /*2D*/ &Jitter6502::jitInvalidOpcode,
-    /*2E*/ &Jitter6502::jitInvalidOpcode,
+    /*2C*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opBIT>,
+    /*2D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opAND>,
+    /*2E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROL>,
     /*2F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*30*/ &Jitter6502::jitInvalidOpcode,
-    /*31*/ &Jitter6502::jitInvalidOpcode,
+    /*30*/ &Jitter6502::jitBranch<M6502_SIGN, true>,
+    /*31*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opAND>,
     /*32*/ &Jitter6502::jitInvalidOpcode,
     /*33*/ &Jitter6502::jitInvalidOpcode,
     /*34*/ &Jitter6502::jitInvalidOpcode,
-    /*35*/ &Jitter6502::jitInvalidOpcode,
-    /*36*/ &Jitter6502::jitInvalidOpcode,
+    /*35*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opAND>,
+    /*36*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROL>,
     /*37*/ &Jitter6502::jitInvalidOpcode,
-    /*38*/ &Jitter6502::jitInvalidOpcode,
-    /*39*/ &Jitter6502::jitInvalidOpcode,
+    /*38*/ &Jitter6502::jitImplied<&Jitter6502::opSEC>,
+    /*39*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opAND>,
     /*3A*/ &Jitter6502::jitInvalidOpcode,
     /*3B*/ &Jitter6502::jitInvalidOpcode,
     /*3C*/ &Jitter6502::jitInvalidOpcode,
-    /*3D*/ &Jitter6502::jitInvalidOpcode,
-    /*3E*/ &Jitter6502::jitInvalidOpcode,
+    /*3D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opAND>,
+    /*3E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROL>,
     /*3F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*40*/ &Jitter6502::jitInvalidOpcode,
-    /*41*/ &Jitter6502::jitInvalidOpcode,
+    /*40*/ &Jitter6502::jitRTI,
+    /*41*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opEOR>,
     /*42*/ &Jitter6502::jitInvalidOpcode,
     /*43*/ &Jitter6502::jitInvalidOpcode,
     /*44*/ &Jitter6502::jitInvalidOpcode,
-    /*45*/ &Jitter6502::jitInvalidOpcode,
-    /*46*/ &Jitter6502::jitInvalidOpcode,
+    /*45*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opEOR>,
+    /*46*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opLSR>,
     /*47*/ &Jitter6502::jitInvalidOpcode,
-    /*48*/ &Jitter6502::jitInvalidOpcode,
-    /*49*/ &Jitter6502::jitInvalidOpcode,
-    /*4A*/ &Jitter6502::jitInvalidOpcode,
+    /*48*/ &Jitter6502::jitImplied<&Jitter6502::opPHA>,
+    /*49*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opEOR>,
+    /*4A*/ &Jitter6502::jitModifyA<&Jitter6502::opLSR>,
     /*4B*/ &Jitter6502::jitInvalidOpcode,
-    /*4C*/ &Jitter6502::jitInvalidOpcode,
-    /*4D*/ &Jitter6502::jitInvalidOpcode,
-    /*4E*/ &Jitter6502::jitInvalidOpcode,
+    /*4C*/ &Jitter6502::jitJMP_ABS,
+    /*4D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opEOR>,
+    /*4E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opLSR>,
     /*4F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*50*/ &Jitter6502::jitInvalidOpcode,
-    /*51*/ &Jitter6502::jitInvalidOpcode,
+    /*50*/ &Jitter6502::jitBranch<M6502_OVERFLOW, false>,
+    /*51*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opEOR>,
     /*52*/ &Jitter6502::jitInvalidOpcode,
     /*53*/ &Jitter6502::jitInvalidOpcode,
     /*54*/ &Jitter6502::jitInvalidOpcode,
-    /*55*/ &Jitter6502::jitInvalidOpcode,
-    /*56*/ &Jitter6502::jitInvalidOpcode,
+    /*55*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opEOR>,
+    /*56*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opLSR>,
     /*57*/ &Jitter6502::jitInvalidOpcode,
-    /*58*/ &Jitter6502::jitInvalidOpcode,
-    /*59*/ &Jitter6502::jitInvalidOpcode,
+    /*58*/ &Jitter6502::jitImplied<&Jitter6502::opCLI, true>,
+    /*59*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opEOR>,
     /*5A*/ &Jitter6502::jitInvalidOpcode,
     /*5B*/ &Jitter6502::jitInvalidOpcode,
     /*5C*/ &Jitter6502::jitInvalidOpcode,
-    /*5D*/ &Jitter6502::jitInvalidOpcode,
-    /*5E*/ &Jitter6502::jitInvalidOpcode,
+    /*5D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opEOR>,
+    /*5E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opLSR>,
     /*5F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*60*/ &Jitter6502::jitInvalidOpcode,
-    /*61*/ &Jitter6502::jitInvalidOpcode,
+    /*60*/ &Jitter6502::jitRTS,
+    /*61*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opADC<CPU_NMOS>>,
     /*62*/ &Jitter6502::jitInvalidOpcode,
     /*63*/ &Jitter6502::jitInvalidOpcode,
     /*64*/ &Jitter6502::jitInvalidOpcode,
-    /*65*/ &Jitter6502::jitInvalidOpcode,
-    /*66*/ &Jitter6502::jitInvalidOpcode,
+    /*65*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opADC<CPU_NMOS>>,
+    /*66*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROR>,
     /*67*/ &Jitter6502::jitInvalidOpcode,
-    /*68*/ &Jitter6502::jitInvalidOpcode,
-    /*69*/ &Jitter6502::jitInvalidOpcode,
-    /*6A*/ &Jitter6502::jitInvalidOpcode,
+    /*68*/ &Jitter6502::jitImplied<&Jitter6502::opPLA>,
+    /*69*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opADC<CPU_NMOS>>,
+    /*6A*/ &Jitter6502::jitModifyA<&Jitter6502::opROR>,
     /*6B*/ &Jitter6502::jitInvalidOpcode,
-    /*6C*/ &Jitter6502::jitInvalidOpcode,
-    /*6D*/ &Jitter6502::jitInvalidOpcode,
-    /*6E*/ &Jitter6502::jitInvalidOpcode,
+    /*6C*/ &Jitter6502::jitJMP_IND<CPU_NMOS>,
+    /*6D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opADC<CPU_NMOS>>,
+    /*6E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROR>,
     /*6F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*70*/ &Jitter6502::jitInvalidOpcode,
-    /*71*/ &Jitter6502::jitInvalidOpcode,
+    /*70*/ &Jitter6502::jitBranch<M6502_OVERFLOW, true>,
+    /*71*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opADC<CPU_NMOS>>,
     /*72*/ &Jitter6502::jitInvalidOpcode,
     /*73*/ &Jitter6502::jitInvalidOpcode,
     /*74*/ &Jitter6502::jitInvalidOpcode,
-    /*75*/ &Jitter6502::jitInvalidOpcode,
-    /*76*/ &Jitter6502::jitInvalidOpcode,
+    /*75*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opADC<CPU_NMOS>>,
+    /*76*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROR>,
     /*77*/ &Jitter6502::jitInvalidOpcode,
-    /*78*/ &Jitter6502::jitInvalidOpcode,
-    /*79*/ &Jitter6502::jitInvalidOpcode,
+    /*78*/ &Jitter6502::jitImplied<&Jitter6502::opSEI>,
+    /*79*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opADC<CPU_NMOS>>,
     /*7A*/ &Jitter6502::jitInvalidOpcode,
     /*7B*/ &Jitter6502::jitInvalidOpcode,
     /*7C*/ &Jitter6502::jitInvalidOpcode,
-    /*7D*/ &Jitter6502::jitInvalidOpcode,
-    /*7E*/ &Jitter6502::jitInvalidOpcode,
+    /*7D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opADC<CPU_NMOS>>,
+    /*7E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROR>,
     /*7F*/ &Jitter6502::jitInvalidOpcode,
 
     /*80*/ &Jitter6502::jitInvalidOpcode,
-    /*81*/ &Jitter6502::jitInvalidOpcode,
+    /*81*/ &Jitter6502::jitStore<IndirectX, &Jitter6502::opSTA>,
     /*82*/ &Jitter6502::jitInvalidOpcode,
     /*83*/ &Jitter6502::jitInvalidOpcode,
-    /*84*/ &Jitter6502::jitInvalidOpcode,
-    /*85*/ &Jitter6502::jitInvalidOpcode,
-    /*86*/ &Jitter6502::jitInvalidOpcode,
+    /*84*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTY>,
+    /*85*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTA>,
+    /*86*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTX>,
     /*87*/ &Jitter6502::jitInvalidOpcode,
-    /*88*/ &Jitter6502::jitInvalidOpcode,
+    /*88*/ &Jitter6502::jitImplied<&Jitter6502::opDEY>,
     /*89*/ &Jitter6502::jitInvalidOpcode,
-    /*8A*/ &Jitter6502::jitInvalidOpcode,
+    /*8A*/ &Jitter6502::jitImplied<&Jitter6502::opTXA>,
     /*8B*/ &Jitter6502::jitInvalidOpcode,
-    /*8C*/ &Jitter6502::jitInvalidOpcode,
-    /*8D*/ &Jitter6502::jitInvalidOpcode,
-    /*8E*/ &Jitter6502::jitInvalidOpcode,
+    /*8C*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTY>,
+    /*8D*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTA>,
+    /*8E*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTX>,
     /*8F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*90*/ &Jitter6502::jitInvalidOpcode,
-    /*91*/ &Jitter6502::jitInvalidOpcode,
+    /*90*/ &Jitter6502::jitBranch<M6502_CARRY, false>,
+    /*91*/ &Jitter6502::jitStore<IndirectY, &Jitter6502::opSTA>,
     /*92*/ &Jitter6502::jitInvalidOpcode,
     /*93*/ &Jitter6502::jitInvalidOpcode,
-    /*94*/ &Jitter6502::jitInvalidOpcode,
-    /*95*/ &Jitter6502::jitInvalidOpcode,
-    /*96*/ &Jitter6502::jitInvalidOpcode,
+    /*94*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTY>,
+    /*95*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTA>,
+    /*96*/ &Jitter6502::jitStore<ZeroPageY, &Jitter6502::opSTX>,
     /*97*/ &Jitter6502::jitInvalidOpcode,
-    /*98*/ &Jitter6502::jitInvalidOpcode,
-    /*99*/ &Jitter6502::jitInvalidOpcode,
-    /*9A*/ &Jitter6502::jitInvalidOpcode,
+    /*98*/ &Jitter6502::jitImplied<&Jitter6502::opTYA>,
+    /*99*/ &Jitter6502::jitStore<AbsoluteY, &Jitter6502::opSTA>,
+    /*9A*/ &Jitter6502::jitImplied<&Jitter6502::opTXS>,
     /*9B*/ &Jitter6502::jitInvalidOpcode,
     /*9C*/ &Jitter6502::jitInvalidOpcode,
-    /*9D*/ &Jitter6502::jitInvalidOpcode,
+    /*9D*/ &Jitter6502::jitStore<AbsoluteX, &Jitter6502::opSTA>,
     /*9E*/ &Jitter6502::jitInvalidOpcode,
     /*9F*/ &Jitter6502::jitInvalidOpcode,
 
-    /*A0*/ &Jitter6502::jitInvalidOpcode,
-    /*A1*/ &Jitter6502::jitInvalidOpcode,
-    /*A2*/ &Jitter6502::jitInvalidOpcode,
+    /*A0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDY>,
+    /*A1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opLDA>,
+    /*A2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDX>,
     /*A3*/ &Jitter6502::jitInvalidOpcode,
-    /*A4*/ &Jitter6502::jitInvalidOpcode,
-    /*A5*/ &Jitter6502::jitInvalidOpcode,
-    /*A6*/ &Jitter6502::jitInvalidOpcode,
+    /*A4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDY>,
+    /*A5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDA>,
+    /*A6*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDX>,
     /*A7*/ &Jitter6502::jitInvalidOpcode,
-    /*A8*/ &Jitter6502::jitInvalidOpcode,
-    /*A9*/ &Jitter6502::jitLDA_IMM,
-    /*AA*/ &Jitter6502::jitInvalidOpcode,
+    /*A8*/ &Jitter6502::jitImplied<&Jitter6502::opTAY>,
+    /*A9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDA>,
+    /*AA*/ &Jitter6502::jitImplied<&Jitter6502::opTAX>,
     /*AB*/ &Jitter6502::jitInvalidOpcode,
-    /*AC*/ &Jitter6502::jitInvalidOpcode,
-    /*AD*/ &Jitter6502::jitInvalidOpcode,
-    /*AE*/ &Jitter6502::jitInvalidOpcode,
+    /*AC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDY>,
+    /*AD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDA>,
+    /*AE*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDX>,
     /*AF*/ &Jitter6502::jitInvalidOpcode,
 
-    /*B0*/ &Jitter6502::jitInvalidOpcode,
-    /*B1*/ &Jitter6502::jitInvalidOpcode,
+    /*B0*/ &Jitter6502::jitBranch<M6502_CARRY, true>,
+    /*B1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opLDA>,
     /*B2*/ &Jitter6502::jitInvalidOpcode,
     /*B3*/ &Jitter6502::jitInvalidOpcode,
-    /*B4*/ &Jitter6502::jitInvalidOpcode,
-    /*B5*/ &Jitter6502::jitInvalidOpcode,
-    /*B6*/ &Jitter6502::jitInvalidOpcode,
+    /*B4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDY>,
+    /*B5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDA>,
+    /*B6*/ &Jitter6502::jitRead<ZeroPageY, &Jitter6502::opLDX>,
     /*B7*/ &Jitter6502::jitInvalidOpcode,
-    /*B8*/ &Jitter6502::jitInvalidOpcode,
-    /*B9*/ &Jitter6502::jitInvalidOpcode,
-    /*BA*/ &Jitter6502::jitInvalidOpcode,
+    /*B8*/ &Jitter6502::jitImplied<&Jitter6502::opCLV>,
+    /*B9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDA>,
+    /*BA*/ &Jitter6502::jitImplied<&Jitter6502::opTSX>,
     /*BB*/ &Jitter6502::jitInvalidOpcode,
-    /*BC*/ &Jitter6502::jitInvalidOpcode,
-    /*BD*/ &Jitter6502::jitInvalidOpcode,
-    /*BE*/ &Jitter6502::jitInvalidOpcode,
+    /*BC*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDY>,
+    /*BD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDA>,
+    /*BE*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDX>,
     /*BF*/ &Jitter6502::jitInvalidOpcode,
 
-    /*C0*/ &Jitter6502::jitInvalidOpcode,
-    /*C1*/ &Jitter6502::jitInvalidOpcode,
+    /*C0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPY>,
+    /*C1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opCMP>,
     /*C2*/ &Jitter6502::jitInvalidOpcode,
     /*C3*/ &Jitter6502::jitInvalidOpcode,
-    /*C4*/ &Jitter6502::jitInvalidOpcode,
-    /*C5*/ &Jitter6502::jitInvalidOpcode,
-    /*C6*/ &Jitter6502::jitInvalidOpcode,
+    /*C4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPY>,
+    /*C5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCMP>,
+    /*C6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opDEC>,
     /*C7*/ &Jitter6502::jitInvalidOpcode,
-    /*C8*/ &Jitter6502::jitInvalidOpcode,
-    /*C9*/ &Jitter6502::jitInvalidOpcode,
-    /*CA*/ &Jitter6502::jitInvalidOpcode,
+    /*C8*/ &Jitter6502::jitImplied<&Jitter6502::opINY>,
+    /*C9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCMP>,
+    /*CA*/ &Jitter6502::jitImplied<&Jitter6502::opDEX>,
     /*CB*/ &Jitter6502::jitInvalidOpcode,
-    /*CC*/ &Jitter6502::jitInvalidOpcode,
-    /*CD*/ &Jitter6502::jitInvalidOpcode,
-    /*CE*/ &Jitter6502::jitInvalidOpcode,
+    /*CC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPY>,
+    /*CD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCMP>,
+    /*CE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opDEC>,
     /*CF*/ &Jitter6502::jitInvalidOpcode,
 
-    /*D0*/ &Jitter6502::jitInvalidOpcode,
-    /*D1*/ &Jitter6502::jitInvalidOpcode,
+    /*D0*/ &Jitter6502::jitBranch<M6502_ZERO, false>,
+    /*D1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opCMP>,
     /*D2*/ &Jitter6502::jitInvalidOpcode,
     /*D3*/ &Jitter6502::jitInvalidOpcode,
     /*D4*/ &Jitter6502::jitInvalidOpcode,
-    /*D5*/ &Jitter6502::jitInvalidOpcode,
-    /*D6*/ &Jitter6502::jitInvalidOpcode,
+    /*D5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opCMP>,
+    /*D6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opDEC>,
     /*D7*/ &Jitter6502::jitInvalidOpcode,
-    /*D8*/ &Jitter6502::jitInvalidOpcode,
-    /*D9*/ &Jitter6502::jitInvalidOpcode,
+    /*D8*/ &Jitter6502::jitImplied<&Jitter6502::opCLD>,
+    /*D9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opCMP>,
     /*DA*/ &Jitter6502::jitInvalidOpcode,
     /*DB*/ &Jitter6502::jitInvalidOpcode,
     /*DC*/ &Jitter6502::jitInvalidOpcode,
-    /*DD*/ &Jitter6502::jitInvalidOpcode,
-    /*DE*/ &Jitter6502::jitInvalidOpcode,
+    /*DD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opCMP>,
+    /*DE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opDEC>,
     /*DF*/ &Jitter6502::jitInvalidOpcode,
 
-    /*E0*/ &Jitter6502::jitInvalidOpcode,
-    /*E1*/ &Jitter6502::jitInvalidOpcode,
+    /*E0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPX>,
+    /*E1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opSBC<CPU_NMOS>>,
     /*E2*/ &Jitter6502::jitInvalidOpcode,
     /*E3*/ &Jitter6502::jitInvalidOpcode,
-    /*E4*/ &Jitter6502::jitInvalidOpcode,
-    /*E5*/ &Jitter6502::jitInvalidOpcode,
-    /*E6*/ &Jitter6502::jitInvalidOpcode,
+    /*E4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPX>,
+    /*E5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opSBC<CPU_NMOS>>,
+    /*E6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opINC>,
     /*E7*/ &Jitter6502::jitInvalidOpcode,
-    /*E8*/ &Jitter6502::jitInvalidOpcode,
-    /*E9*/ &Jitter6502::jitInvalidOpcode,
-    /*EA*/ &Jitter6502::jitInvalidOpcode,
+    /*E8*/ &Jitter6502::jitImplied<&Jitter6502::opINX>,
+    /*E9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opSBC<CPU_NMOS>>,
+    /*EA*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
     /*EB*/ &Jitter6502::jitInvalidOpcode,
-    /*EC*/ &Jitter6502::jitInvalidOpcode,
-    /*ED*/ &Jitter6502::jitInvalidOpcode,
-    /*EE*/ &Jitter6502::jitInvalidOpcode,
+    /*EC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPX>,
+    /*ED*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opSBC<CPU_NMOS>>,
+    /*EE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opINC>,
     /*EF*/ &Jitter6502::jitInvalidOpcode,
 
-    /*F0*/ &Jitter6502::jitInvalidOpcode,
-    /*F1*/ &Jitter6502::jitInvalidOpcode,
+    /*F0*/ &Jitter6502::jitBranch<M6502_ZERO, true>,
+    /*F1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opSBC<CPU_NMOS>>,
     /*F2*/ &Jitter6502::jitInvalidOpcode,
     /*F3*/ &Jitter6502::jitInvalidOpcode,
     /*F4*/ &Jitter6502::jitInvalidOpcode,
-    /*F5*/ &Jitter6502::jitInvalidOpcode,
-    /*F6*/ &Jitter6502::jitInvalidOpcode,
+    /*F5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opSBC<CPU_NMOS>>,
+    /*F6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opINC>,
     /*F7*/ &Jitter6502::jitInvalidOpcode,
-    /*F8*/ &Jitter6502::jitInvalidOpcode,
-    /*F9*/ &Jitter6502::jitInvalidOpcode,
+    /*F8*/ &Jitter6502::jitImplied<&Jitter6502::opSED>,
+    /*F9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opSBC<CPU_NMOS>>,
     /*FA*/ &Jitter6502::jitInvalidOpcode,
     /*FB*/ &Jitter6502::jitInvalidOpcode,
     /*FC*/ &Jitter6502::jitInvalidOpcode,
-    /*FD*/ &Jitter6502::jitInvalidOpcode,
-    /*FE*/ &Jitter6502::jitInvalidOpcode,
+    /*FD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opSBC<CPU_NMOS>>,
+    /*FE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opINC>,
     /*FF*/ &Jitter6502::jitInvalidOpcode,
 };
+
+const Jitter6502::JitterTable Jitter6502::nmosUndocumentedJitters_ = {
+    /*00*/ &Jitter6502::jitBRK,
+    /*01*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opORA>,
+    /*02*/ &Jitter6502::jitInvalidOpcode,
+    /*03*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opSLO>,
+    /*04*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opNOP>,
+    /*05*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opORA>,
+    /*06*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opASL>,
+    /*07*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opSLO>,
+    /*08*/ &Jitter6502::jitImplied<&Jitter6502::opPHP>,
+    /*09*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opORA>,
+    /*0A*/ &Jitter6502::jitModifyA<&Jitter6502::opASL>,
+    /*0B*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opANC>,
+    /*0C*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opNOP>,
+    /*0D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opORA>,
+    /*0E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opASL>,
+    /*0F*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opSLO>,
+
+    /*10*/ &Jitter6502::jitBranch<M6502_SIGN, false>,
+    /*11*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opORA>,
+    /*12*/ &Jitter6502::jitInvalidOpcode,
+    /*13*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opSLO>,
+    /*14*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*15*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opORA>,
+    /*16*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opASL>,
+    /*17*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opSLO>,
+    /*18*/ &Jitter6502::jitImplied<&Jitter6502::opCLC>,
+    /*19*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opORA>,
+    /*1A*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*1B*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opSLO>,
+    /*1C*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*1D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opORA>,
+    /*1E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opASL>,
+    /*1F*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opSLO>,
+
+    /*20*/ &Jitter6502::jitJSR,
+    /*21*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opAND>,
+    /*22*/ &Jitter6502::jitInvalidOpcode,
+    /*23*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opRLA>,
+    /*24*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opBIT>,
+    /*25*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opAND>,
+    /*26*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROL>,
+    /*27*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opRLA>,
+    /*28*/ &Jitter6502::jitImplied<&Jitter6502::opPLP, true>,
+    /*29*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opAND>,
+    /*2A*/ &Jitter6502::jitModifyA<&Jitter6502::opROL>,
+    /*2B*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opANC>,
+    /*2C*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opBIT>,
+    /*2D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opAND>,
+    /*2E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROL>,
+    /*2F*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opRLA>,
+
+    /*30*/ &Jitter6502::jitBranch<M6502_SIGN, true>,
+    /*31*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opAND>,
+    /*32*/ &Jitter6502::jitInvalidOpcode,
+    /*33*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opRLA>,
+    /*34*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*35*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opAND>,
+    /*36*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROL>,
+    /*37*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opRLA>,
+    /*38*/ &Jitter6502::jitImplied<&Jitter6502::opSEC>,
+    /*39*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opAND>,
+    /*3A*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*3B*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opRLA>,
+    /*3C*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*3D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opAND>,
+    /*3E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROL>,
+    /*3F*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opRLA>,
+
+    /*40*/ &Jitter6502::jitRTI,
+    /*41*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opEOR>,
+    /*42*/ &Jitter6502::jitInvalidOpcode,
+    /*43*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opSRE>,
+    /*44*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opNOP>,
+    /*45*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opEOR>,
+    /*46*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opLSR>,
+    /*47*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opSRE>,
+    /*48*/ &Jitter6502::jitImplied<&Jitter6502::opPHA>,
+    /*49*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opEOR>,
+    /*4A*/ &Jitter6502::jitModifyA<&Jitter6502::opLSR>,
+    /*4B*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opALR>,
+    /*4C*/ &Jitter6502::jitJMP_ABS,
+    /*4D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opEOR>,
+    /*4E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opLSR>,
+    /*4F*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opSRE>,
+
+    /*50*/ &Jitter6502::jitBranch<M6502_OVERFLOW, false>,
+    /*51*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opEOR>,
+    /*52*/ &Jitter6502::jitInvalidOpcode,
+    /*53*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opSRE>,
+    /*54*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*55*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opEOR>,
+    /*56*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opLSR>,
+    /*57*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opSRE>,
+    /*58*/ &Jitter6502::jitImplied<&Jitter6502::opCLI, true>,
+    /*59*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opEOR>,
+    /*5A*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*5B*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opSRE>,
+    /*5C*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*5D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opEOR>,
+    /*5E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opLSR>,
+    /*5F*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opSRE>,
+
+    /*60*/ &Jitter6502::jitRTS,
+    /*61*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*62*/ &Jitter6502::jitInvalidOpcode,
+    /*63*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+    /*64*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opNOP>,
+    /*65*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*66*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROR>,
+    /*67*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+    /*68*/ &Jitter6502::jitImplied<&Jitter6502::opPLA>,
+    /*69*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*6A*/ &Jitter6502::jitModifyA<&Jitter6502::opROR>,
+    /*6B*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opARR>,
+    /*6C*/ &Jitter6502::jitJMP_IND<CPU_NMOS_UNDOCUMENTED>,
+    /*6D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*6E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROR>,
+    /*6F*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+
+    /*70*/ &Jitter6502::jitBranch<M6502_OVERFLOW, true>,
+    /*71*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*72*/ &Jitter6502::jitInvalidOpcode,
+    /*73*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+    /*74*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*75*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*76*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROR>,
+    /*77*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+    /*78*/ &Jitter6502::jitImplied<&Jitter6502::opSEI>,
+    /*79*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*7A*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*7B*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+    /*7C*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*7D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opADC<CPU_NMOS_UNDOCUMENTED>>,
+    /*7E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROR>,
+    /*7F*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opRRA<CPU_NMOS_UNDOCUMENTED>>,
+
+    /*80*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*81*/ &Jitter6502::jitStore<IndirectX, &Jitter6502::opSTA>,
+    /*82*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*83*/ &Jitter6502::jitStore<IndirectX, &Jitter6502::opSAX>,
+    /*84*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTY>,
+    /*85*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTA>,
+    /*86*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTX>,
+    /*87*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSAX>,
+    /*88*/ &Jitter6502::jitImplied<&Jitter6502::opDEY>,
+    /*89*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*8A*/ &Jitter6502::jitImplied<&Jitter6502::opTXA>,
+    /*8B*/ &Jitter6502::jitInvalidOpcode,
+    /*8C*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTY>,
+    /*8D*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTA>,
+    /*8E*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTX>,
+    /*8F*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSAX>,
+
+    /*90*/ &Jitter6502::jitBranch<M6502_CARRY, false>,
+    /*91*/ &Jitter6502::jitStore<IndirectY, &Jitter6502::opSTA>,
+    /*92*/ &Jitter6502::jitInvalidOpcode,
+    /*93*/ &Jitter6502::jitInvalidOpcode,
+    /*94*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTY>,
+    /*95*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTA>,
+    /*96*/ &Jitter6502::jitStore<ZeroPageY, &Jitter6502::opSTX>,
+    /*97*/ &Jitter6502::jitStore<ZeroPageY, &Jitter6502::opSAX>,
+    /*98*/ &Jitter6502::jitImplied<&Jitter6502::opTYA>,
+    /*99*/ &Jitter6502::jitStore<AbsoluteY, &Jitter6502::opSTA>,
+    /*9A*/ &Jitter6502::jitImplied<&Jitter6502::opTXS>,
+    /*9B*/ &Jitter6502::jitInvalidOpcode,
+    /*9C*/ &Jitter6502::jitInvalidOpcode,
+    /*9D*/ &Jitter6502::jitStore<AbsoluteX, &Jitter6502::opSTA>,
+    /*9E*/ &Jitter6502::jitInvalidOpcode,
+    /*9F*/ &Jitter6502::jitInvalidOpcode,
+
+    /*A0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDY>,
+    /*A1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opLDA>,
+    /*A2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDX>,
+    /*A3*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opLAX>,
+    /*A4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDY>,
+    /*A5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDA>,
+    /*A6*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDX>,
+    /*A7*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLAX>,
+    /*A8*/ &Jitter6502::jitImplied<&Jitter6502::opTAY>,
+    /*A9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDA>,
+    /*AA*/ &Jitter6502::jitImplied<&Jitter6502::opTAX>,
+    /*AB*/ &Jitter6502::jitInvalidOpcode,
+    /*AC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDY>,
+    /*AD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDA>,
+    /*AE*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDX>,
+    /*AF*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLAX>,
+
+    /*B0*/ &Jitter6502::jitBranch<M6502_CARRY, true>,
+    /*B1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opLDA>,
+    /*B2*/ &Jitter6502::jitInvalidOpcode,
+    /*B3*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opLAX>,
+    /*B4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDY>,
+    /*B5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDA>,
+    /*B6*/ &Jitter6502::jitRead<ZeroPageY, &Jitter6502::opLDX>,
+    /*B7*/ &Jitter6502::jitRead<ZeroPageY, &Jitter6502::opLAX>,
+    /*B8*/ &Jitter6502::jitImplied<&Jitter6502::opCLV>,
+    /*B9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDA>,
+    /*BA*/ &Jitter6502::jitImplied<&Jitter6502::opTSX>,
+    /*BB*/ &Jitter6502::jitInvalidOpcode,
+    /*BC*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDY>,
+    /*BD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDA>,
+    /*BE*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDX>,
+    /*BF*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLAX>,
+
+    /*C0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPY>,
+    /*C1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opCMP>,
+    /*C2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*C3*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opDCP>,
+    /*C4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPY>,
+    /*C5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCMP>,
+    /*C6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opDEC>,
+    /*C7*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opDCP>,
+    /*C8*/ &Jitter6502::jitImplied<&Jitter6502::opINY>,
+    /*C9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCMP>,
+    /*CA*/ &Jitter6502::jitImplied<&Jitter6502::opDEX>,
+    /*CB*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opSBX>,
+    /*CC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPY>,
+    /*CD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCMP>,
+    /*CE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opDEC>,
+    /*CF*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opDCP>,
+
+    /*D0*/ &Jitter6502::jitBranch<M6502_ZERO, false>,
+    /*D1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opCMP>,
+    /*D2*/ &Jitter6502::jitInvalidOpcode,
+    /*D3*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opDCP>,
+    /*D4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*D5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opCMP>,
+    /*D6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opDEC>,
+    /*D7*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opDCP>,
+    /*D8*/ &Jitter6502::jitImplied<&Jitter6502::opCLD>,
+    /*D9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opCMP>,
+    /*DA*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*DB*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opDCP>,
+    /*DC*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*DD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opCMP>,
+    /*DE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opDEC>,
+    /*DF*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opDCP>,
+
+    /*E0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPX>,
+    /*E1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*E2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*E3*/ &Jitter6502::jitModify<IndirectX, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+    /*E4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPX>,
+    /*E5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*E6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opINC>,
+    /*E7*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+    /*E8*/ &Jitter6502::jitImplied<&Jitter6502::opINX>,
+    /*E9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*EA*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*EB*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*EC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPX>,
+    /*ED*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*EE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opINC>,
+    /*EF*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+
+    /*F0*/ &Jitter6502::jitBranch<M6502_ZERO, true>,
+    /*F1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*F2*/ &Jitter6502::jitInvalidOpcode,
+    /*F3*/ &Jitter6502::jitModify<IndirectY, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+    /*F4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*F5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*F6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opINC>,
+    /*F7*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+    /*F8*/ &Jitter6502::jitImplied<&Jitter6502::opSED>,
+    /*F9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*FA*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*FB*/ &Jitter6502::jitModify<AbsoluteY, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+    /*FC*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opNOP>,
+    /*FD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opSBC<CPU_NMOS_UNDOCUMENTED>>,
+    /*FE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opINC>,
+    /*FF*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opISC<CPU_NMOS_UNDOCUMENTED>>,
+};
+
+const Jitter6502::JitterTable Jitter6502::cmosJitters_ = {
+    /*00*/ &Jitter6502::jitBRK,
+    /*01*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opORA>,
+    /*02*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*03*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*04*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opTSB>,
+    /*05*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opORA>,
+    /*06*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opASL>,
+    /*07*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*08*/ &Jitter6502::jitImplied<&Jitter6502::opPHP>,
+    /*09*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opORA>,
+    /*0A*/ &Jitter6502::jitModifyA<&Jitter6502::opASL>,
+    /*0B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*0C*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opTSB>,
+    /*0D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opORA>,
+    /*0E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opASL>,
+    /*0F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*10*/ &Jitter6502::jitBranch<M6502_SIGN, false>,
+    /*11*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opORA>,
+    /*12*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opORA>,
+    /*13*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*14*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opTRB>,
+    /*15*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opORA>,
+    /*16*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opASL>,
+    /*17*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*18*/ &Jitter6502::jitImplied<&Jitter6502::opCLC>,
+    /*19*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opORA>,
+    /*1A*/ &Jitter6502::jitModifyA<&Jitter6502::opINC>,
+    /*1B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*1C*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opTRB>,
+    /*1D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opORA>,
+    /*1E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opASL>,
+    /*1F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*20*/ &Jitter6502::jitJSR,
+    /*21*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opAND>,
+    /*22*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*23*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*24*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opBIT>,
+    /*25*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opAND>,
+    /*26*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROL>,
+    /*27*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*28*/ &Jitter6502::jitImplied<&Jitter6502::opPLP, true>,
+    /*29*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opAND>,
+    /*2A*/ &Jitter6502::jitModifyA<&Jitter6502::opROL>,
+    /*2B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*2C*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opBIT>,
+    /*2D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opAND>,
+    /*2E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROL>,
+    /*2F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*30*/ &Jitter6502::jitBranch<M6502_SIGN, true>,
+    /*31*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opAND>,
+    /*32*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opAND>,
+    /*33*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*34*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opBIT>,
+    /*35*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opAND>,
+    /*36*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROL>,
+    /*37*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*38*/ &Jitter6502::jitImplied<&Jitter6502::opSEC>,
+    /*39*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opAND>,
+    /*3A*/ &Jitter6502::jitModifyA<&Jitter6502::opDEC>,
+    /*3B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*3C*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opBIT>,
+    /*3D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opAND>,
+    /*3E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROL>,
+    /*3F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*40*/ &Jitter6502::jitRTI,
+    /*41*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opEOR>,
+    /*42*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*43*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*44*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opNOP>,
+    /*45*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opEOR>,
+    /*46*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opLSR>,
+    /*47*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*48*/ &Jitter6502::jitImplied<&Jitter6502::opPHA>,
+    /*49*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opEOR>,
+    /*4A*/ &Jitter6502::jitModifyA<&Jitter6502::opLSR>,
+    /*4B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*4C*/ &Jitter6502::jitJMP_ABS,
+    /*4D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opEOR>,
+    /*4E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opLSR>,
+    /*4F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*50*/ &Jitter6502::jitBranch<M6502_OVERFLOW, false>,
+    /*51*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opEOR>,
+    /*52*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opEOR>,
+    /*53*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*54*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*55*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opEOR>,
+    /*56*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opLSR>,
+    /*57*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*58*/ &Jitter6502::jitImplied<&Jitter6502::opCLI, true>,
+    /*59*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opEOR>,
+    /*5A*/ &Jitter6502::jitImplied<&Jitter6502::opPHY>,
+    /*5B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*5C*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opNOP>,
+    /*5D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opEOR>,
+    /*5E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opLSR>,
+    /*5F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*60*/ &Jitter6502::jitRTS,
+    /*61*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opADC<CPU_65C02>>,
+    /*62*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*63*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*64*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTZ>,
+    /*65*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opADC<CPU_65C02>>,
+    /*66*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opROR>,
+    /*67*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*68*/ &Jitter6502::jitImplied<&Jitter6502::opPLA>,
+    /*69*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opADC<CPU_65C02>>,
+    /*6A*/ &Jitter6502::jitModifyA<&Jitter6502::opROR>,
+    /*6B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*6C*/ &Jitter6502::jitJMP_IND<CPU_65C02>,
+    /*6D*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opADC<CPU_65C02>>,
+    /*6E*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opROR>,
+    /*6F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*70*/ &Jitter6502::jitBranch<M6502_OVERFLOW, true>,
+    /*71*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opADC<CPU_65C02>>,
+    /*72*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opADC<CPU_65C02>>,
+    /*73*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*74*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTZ>,
+    /*75*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opADC<CPU_65C02>>,
+    /*76*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opROR>,
+    /*77*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*78*/ &Jitter6502::jitImplied<&Jitter6502::opSEI>,
+    /*79*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opADC<CPU_65C02>>,
+    /*7A*/ &Jitter6502::jitImplied<&Jitter6502::opPLY>,
+    /*7B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*7C*/ &Jitter6502::jitJMP_INDX,
+    /*7D*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opADC<CPU_65C02>>,
+    /*7E*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opROR>,
+    /*7F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*80*/ &Jitter6502::jitBRA,
+    /*81*/ &Jitter6502::jitStore<IndirectX, &Jitter6502::opSTA>,
+    /*82*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*83*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*84*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTY>,
+    /*85*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTA>,
+    /*86*/ &Jitter6502::jitStore<ZeroPage, &Jitter6502::opSTX>,
+    /*87*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*88*/ &Jitter6502::jitImplied<&Jitter6502::opDEY>,
+    /*89*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opBITImmediate>,
+    /*8A*/ &Jitter6502::jitImplied<&Jitter6502::opTXA>,
+    /*8B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*8C*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTY>,
+    /*8D*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTA>,
+    /*8E*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTX>,
+    /*8F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*90*/ &Jitter6502::jitBranch<M6502_CARRY, false>,
+    /*91*/ &Jitter6502::jitStore<IndirectY, &Jitter6502::opSTA>,
+    /*92*/ &Jitter6502::jitStore<ZeroPageIndirect, &Jitter6502::opSTA>,
+    /*93*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*94*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTY>,
+    /*95*/ &Jitter6502::jitStore<ZeroPageX, &Jitter6502::opSTA>,
+    /*96*/ &Jitter6502::jitStore<ZeroPageY, &Jitter6502::opSTX>,
+    /*97*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*98*/ &Jitter6502::jitImplied<&Jitter6502::opTYA>,
+    /*99*/ &Jitter6502::jitStore<AbsoluteY, &Jitter6502::opSTA>,
+    /*9A*/ &Jitter6502::jitImplied<&Jitter6502::opTXS>,
+    /*9B*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*9C*/ &Jitter6502::jitStore<Absolute, &Jitter6502::opSTZ>,
+    /*9D*/ &Jitter6502::jitStore<AbsoluteX, &Jitter6502::opSTA>,
+    /*9E*/ &Jitter6502::jitStore<AbsoluteX, &Jitter6502::opSTZ>,
+    /*9F*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*A0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDY>,
+    /*A1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opLDA>,
+    /*A2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDX>,
+    /*A3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*A4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDY>,
+    /*A5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDA>,
+    /*A6*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opLDX>,
+    /*A7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*A8*/ &Jitter6502::jitImplied<&Jitter6502::opTAY>,
+    /*A9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opLDA>,
+    /*AA*/ &Jitter6502::jitImplied<&Jitter6502::opTAX>,
+    /*AB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*AC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDY>,
+    /*AD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDA>,
+    /*AE*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opLDX>,
+    /*AF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*B0*/ &Jitter6502::jitBranch<M6502_CARRY, true>,
+    /*B1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opLDA>,
+    /*B2*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opLDA>,
+    /*B3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*B4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDY>,
+    /*B5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opLDA>,
+    /*B6*/ &Jitter6502::jitRead<ZeroPageY, &Jitter6502::opLDX>,
+    /*B7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*B8*/ &Jitter6502::jitImplied<&Jitter6502::opCLV>,
+    /*B9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDA>,
+    /*BA*/ &Jitter6502::jitImplied<&Jitter6502::opTSX>,
+    /*BB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*BC*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDY>,
+    /*BD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opLDA>,
+    /*BE*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opLDX>,
+    /*BF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*C0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPY>,
+    /*C1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opCMP>,
+    /*C2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*C3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*C4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPY>,
+    /*C5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCMP>,
+    /*C6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opDEC>,
+    /*C7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*C8*/ &Jitter6502::jitImplied<&Jitter6502::opINY>,
+    /*C9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCMP>,
+    /*CA*/ &Jitter6502::jitImplied<&Jitter6502::opDEX>,
+    /*CB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*CC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPY>,
+    /*CD*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCMP>,
+    /*CE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opDEC>,
+    /*CF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*D0*/ &Jitter6502::jitBranch<M6502_ZERO, false>,
+    /*D1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opCMP>,
+    /*D2*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opCMP>,
+    /*D3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*D4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*D5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opCMP>,
+    /*D6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opDEC>,
+    /*D7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*D8*/ &Jitter6502::jitImplied<&Jitter6502::opCLD>,
+    /*D9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opCMP>,
+    /*DA*/ &Jitter6502::jitImplied<&Jitter6502::opPHX>,
+    /*DB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*DC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opNOP>,
+    /*DD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opCMP>,
+    /*DE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opDEC>,
+    /*DF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*E0*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opCPX>,
+    /*E1*/ &Jitter6502::jitRead<IndirectX, &Jitter6502::opSBC<CPU_65C02>>,
+    /*E2*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opNOP>,
+    /*E3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*E4*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opCPX>,
+    /*E5*/ &Jitter6502::jitRead<ZeroPage, &Jitter6502::opSBC<CPU_65C02>>,
+    /*E6*/ &Jitter6502::jitModify<ZeroPage, &Jitter6502::opINC>,
+    /*E7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*E8*/ &Jitter6502::jitImplied<&Jitter6502::opINX>,
+    /*E9*/ &Jitter6502::jitRead<Immediate, &Jitter6502::opSBC<CPU_65C02>>,
+    /*EA*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*EB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*EC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opCPX>,
+    /*ED*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opSBC<CPU_65C02>>,
+    /*EE*/ &Jitter6502::jitModify<Absolute, &Jitter6502::opINC>,
+    /*EF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+
+    /*F0*/ &Jitter6502::jitBranch<M6502_ZERO, true>,
+    /*F1*/ &Jitter6502::jitRead<IndirectY, &Jitter6502::opSBC<CPU_65C02>>,
+    /*F2*/ &Jitter6502::jitRead<ZeroPageIndirect, &Jitter6502::opSBC<CPU_65C02>>,
+    /*F3*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*F4*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opNOP>,
+    /*F5*/ &Jitter6502::jitRead<ZeroPageX, &Jitter6502::opSBC<CPU_65C02>>,
+    /*F6*/ &Jitter6502::jitModify<ZeroPageX, &Jitter6502::opINC>,
+    /*F7*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*F8*/ &Jitter6502::jitImplied<&Jitter6502::opSED>,
+    /*F9*/ &Jitter6502::jitRead<AbsoluteY, &Jitter6502::opSBC<CPU_65C02>>,
+    /*FA*/ &Jitter6502::jitImplied<&Jitter6502::opPLX>,
+    /*FB*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+    /*FC*/ &Jitter6502::jitRead<Absolute, &Jitter6502::opNOP>,
+    /*FD*/ &Jitter6502::jitRead<AbsoluteX, &Jitter6502::opSBC<CPU_65C02>>,
+    /*FE*/ &Jitter6502::jitModify<AbsoluteX, &Jitter6502::opINC>,
+    /*FF*/ &Jitter6502::jitImplied<&Jitter6502::opNOP>,
+};
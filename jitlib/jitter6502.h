@@ -1,59 +1,434 @@
 #pragma once
 
+#include "assembler_x86.h"
+#include "guestpctable.h"
+#include "jitstats.h"
+#include "opcodes.h"
+#include "scheduler.h"
 #include "types.h"
+#include "vmcontext.h"
 
 #include <array>
+#include <bitset>
 #include <unordered_map>
+#include <vector>
 
 class JitVM;
-class AssemblerX86;
 class SystemMemory;
 
-enum M6502Flags 
+enum RunStatus
 {
-    M6502_CARRY = 0x01,
-    M6502_ZERO = 0x02,
-    M6502_INTERRUPT = 0x04,
-    M6502_DECIMAL = 0x08,
-    M6502_BRK = 0x10,
-    M6502_ALWAYS = 0x20,
-    M6502_OVERFLOW = 0x40,
-    M6502_SIGN = 0x80,
+    CycleLimitReached,
+    // The guest is jumping to itself, the usual way 6502 code stops, or is
+    // idling with nothing scheduled that could wake it
+    Trapped,
+    // The guest ran into an opcode with no translation; cpu.pc is at it
+    InvalidOpcode,
 };
 
+//
+// Jitter6502 translates for one CpuModel, chosen when it is constructed. The
+// instruction translators are instantiated for each model, where they differ,
+// so translated code never asks which it is running.
+//
 class Jitter6502
 {
 public:
-    Jitter6502(JitVM *vm, AssemblerX86 *assembler, SystemMemory *memory);
+    Jitter6502(JitVM *vm, AssemblerX86 *assembler, SystemMemory *memory, CpuModel model = CPU_NMOS);
 
     auto boot()->void;
+    auto reset()->void;
+
+    // Run translated code until the guest cycle count reaches cycleLimit, or
+    // the guest traps or stops at an invalid opcode
+    auto run(uint64_t cycleLimit)->RunStatus;
+
+    // Interrupt lines, sampled by the dispatcher between blocks. IRQ is level
+    // triggered and taken while the I flag is clear; NMI is edge triggered.
+    auto setIRQ(bool asserted)->void;
+    auto triggerNMI()->void;
+
+    // Translates ahead of time every block of fixed ROM the guest can reach
+    // from its PC and its reset and interrupt vectors, as far as the blocks'
+    // ways out can be known without running them, so that its first frames
+    // wait on no translation there. Returns the number of blocks translated.
+    auto pretranslate()->size_t;
 
     auto jit(TargetAddress ip)->NativeAddress;
 
+    auto context()->VMContext &;
+    auto scheduler()->Scheduler &;
+    auto model() const->CpuModel;
+
+    // The guest PC and cycle count as a device sees them: while translated
+    // code is calling one, those of the access it is making; otherwise the
+    // context's
+    auto currentPC() const->TargetAddress;
+    auto currentCycle() const->uint64_t;
+
+    // May be called from any thread, including while the guest runs
+    auto stats() const->JitStats;
+
+    // Where each guest instruction's translation starts, for profilers
+    auto guestPCTable() const->const GuestPCTable &;
+
 private:
     using InstructionJitter = bool(Jitter6502::*)(TargetAddress *ip);
-    using Entry = void(*)(JitVM *, NativeAddress entry);
-    using Exit = void(*)(void);
+    using JitterTable = std::array<InstructionJitter, 256>;
+    using Entry = void(*)(VMContext *, NativeAddress entry);
     using FlagTranslationMap = std::array<uint8_t, 256>;
 
+    struct Block
+    {
+        NativeAddress code;
+        bool trap;
+
+        // For an idle loop, the cycles and instructions of one trip round it;
+        // zero for any other block
+        unsigned idleCycles;
+        unsigned idleInstructions;
+    };
+
+    // What the block being translated reads before writing it, what it
+    // writes, as M6502Registers and M6502Flags bits, and whether it does
+    // anything else visible outside the CPU: writes memory, reads a device,
+    // pushes or pulls the stack
+    struct BlockEffects
+    {
+        uint8_t registersRead;
+        uint8_t registersWritten;
+        uint8_t flagsRead;
+        uint8_t flagsWritten;
+        bool sideEffects;
+    };
+
+    // Where an instruction of the block being translated starts, and the
+    // cycles and instructions before it, so a branch back to it can loop
+    // without leaving the block. Its code assumes the D flag as it was there.
+    struct BlockLabel
+    {
+        TargetAddress pc;
+        NativeAddress code;
+        uint32_t cycles;
+        uint32_t instructions;
+        bool decimal;
+    };
+
+    // Blocks are keyed by guest PC and the bank switched in there, so code in
+    // a bank stays translated while other banks are switched in over it, and
+    // by the D flag, which decimal arithmetic is translated for
+    using BlockKey = uint64_t;
+    static const BlockKey DECIMAL_KEY = 0x10000;
+    using BlockMap = std::unordered_map<BlockKey, Block>;
+
+    // A guest address a block goes on to with a known PC, and the D flag it
+    // leaves for it with
+    struct BlockExit
+    {
+        TargetAddress pc;
+        bool decimal;
+    };
+
+    // Where translated code calls a device: the guest instruction making the
+    // access, and the cycles run from the start of its block to the access.
+    // Translated code only stores the site's key, so exact state costs
+    // nothing until a device asks for it.
+    struct IOSite
+    {
+        TargetAddress pc;
+        uint32_t cycles;
+    };
+
+    // A loop copying or filling memory a byte a trip,
+    // LDA src / STA dst / step / BNE back to the LDA, or without the LDA to
+    // fill with A. Both operands are indexed by the register the step counts
+    // up or down, so the loop runs until that reaches zero.
+    struct BlockMove
+    {
+        TargetAddress loop;
+        TargetAddress exit;
+        bool copies;
+        AddressingMode sourceMode;
+        uint16_t source;
+        bool sourcePenalty;
+        AddressingMode destinationMode;
+        uint16_t destination;
+        bool indexX;
+        bool increments;
+
+        // A trip with the branch not taken, and what taking it adds
+        unsigned tripCycles;
+        unsigned tripInstructions;
+        unsigned branchCycles;
+
+        // The cycles of the block ahead of the loop, which it only adds as it
+        // leaves
+        unsigned blockCycles;
+    };
+
+    // A 16-bit add or subtract built from bytes, LDA left / ADC or SBC right /
+    // STA result for the low bytes and again for the high, or a compare, LDA
+    // left / CMP right then LDA left / SBC right, which leaves only A and the
+    // flags. Each byte is at its own address, or right may be immediate. The
+    // carry chain may go on to 32 bits, and a CLC or SEC may come between the
+    // first LDA and ADC or SBC.
+    enum { MAX_WORD_BYTES = 4 };
+
+    enum WordOperator : uint8_t
+    {
+        WordAdd,
+        WordSubtract,
+        WordCompare,
+    };
+
+    struct WordOperation
+    {
+        WordOperator op;
+        unsigned bytes;
+        bool setsCarry;
+        bool carry;
+        std::array<uint16_t, MAX_WORD_BYTES> left;
+        std::array<uint16_t, MAX_WORD_BYTES> right;
+        std::array<bool, MAX_WORD_BYTES> immediate;
+        std::array<uint16_t, MAX_WORD_BYTES> result;
+    };
+
+    enum { MAX_BLOCK_INSTRUCTIONS = 64 };
+
+    auto blockKey(TargetAddress pc) const->BlockKey;
+    auto blockKey(TargetAddress pc, bool decimal) const->BlockKey;
+    auto addBlock(TargetAddress pc, bool decimal)->BlockMap::iterator;
+    auto jit(TargetAddress ip, bool decimal)->NativeAddress;
+
     auto buildReentryStub()->void;
     auto buildFlagTranslationMap()->void;
 
-    static auto invalidOpcodeStub(TargetAddress addr)->void;
+    auto isIdleLoop() const->bool;
+    auto loopMayIdle(TargetAddress loop) const->bool;
+    static auto addEffects(BlockEffects *effects, const OpcodeInfo &info)->void;
+    auto skipIdleLoop(const Block &loop)->void;
+
+    auto runBlockMove(const BlockMove &move)->bool;
+    auto blockMoveBase(AddressingMode mode, uint16_t operand, TargetAddress *base) const->bool;
+
+    auto enterInterrupt(TargetAddress vector, bool software)->void;
+
+    // Helpers translated code calls to reach memory; a write's access is its
+    // address shifted left by eight, or'd with the data
+    static auto readMemory(Jitter6502 *jitter, uint32_t address)->uint8_t;
+    static auto writeMemory(Jitter6502 *jitter, uint32_t access)->void;
+
+    // Reads the pointer at a zero page address, wrapping within the page
+    static auto readPointer(Jitter6502 *jitter, uint32_t address)->uint16_t;
+
+    // ARR in decimal mode, on A and P in the context
+    static auto arrDecimal(Jitter6502 *jitter, uint32_t operand)->void;
+
+    // Runs a block move loop to its end in one go, on A and P in the context,
+    // and returns 1 with cpu.pc at its exit; or returns 0 having changed
+    // nothing, if it would touch anything but plain memory or the code and
+    // pointers it runs on, or run past the deadline
+    static auto moveBlock(Jitter6502 *jitter, uint32_t move)->uint8_t;
+
+    // Runs a word operation's instructions in turn, on A and P in the context
+    static auto operateOnWord(Jitter6502 *jitter, uint32_t operation)->void;
+
+    //
+    // Instruction translators are built from templates: one per kind of
+    // instruction, combining the addressing mode's operand access with an
+    // operation emitter, both chosen at compile time. An opcode's entry in
+    // its model's table is then one instantiation, such as
+    // jitRead<AbsoluteX, &Jitter6502::opLDA>. Where models differ, the
+    // emitter takes the model too, as in opADC<CPU_65C02>.
+    //
+    // Operation emitters work on AL. For reads it holds the operand; for
+    // read-modify-writes the value, which they modify in place; stores load it
+    // with the value to store.
+    //
+    using Emitter = void(Jitter6502::*)();
+
+    // Where an operand is: known when translating, or computed into EAX by
+    // the code jit_address emits
+    struct EffectiveAddress
+    {
+        bool known;
+        TargetAddress address;
+    };
+
+    template<AddressingMode Mode, Emitter Operation> auto jitRead(TargetAddress *ip)->bool;
+    template<AddressingMode Mode, Emitter Operation> auto jitStore(TargetAddress *ip)->bool;
+    template<AddressingMode Mode, Emitter Operation> auto jitModify(TargetAddress *ip)->bool;
+    template<Emitter Operation> auto jitModifyA(TargetAddress *ip)->bool;
+    template<Emitter Operation, bool EndsBlock = false> auto jitImplied(TargetAddress *ip)->bool;
+    template<M6502Flags Flag, bool Set> auto jitBranch(TargetAddress *ip)->bool;
+
     auto jitInvalidOpcode(TargetAddress *ip)->bool;
+    auto jitBRA(TargetAddress *ip)->bool;
+    auto jitBRK(TargetAddress *ip)->bool;
+    auto jitJMP_ABS(TargetAddress *ip)->bool;
+    template<CpuModel Model> auto jitJMP_IND(TargetAddress *ip)->bool;
+    auto jitJMP_INDX(TargetAddress *ip)->bool;
+    auto jitJSR(TargetAddress *ip)->bool;
+    auto jitRTI(TargetAddress *ip)->bool;
+    auto jitRTS(TargetAddress *ip)->bool;
 
-    auto jitLDA_IMM(TargetAddress *ip)->bool;
+    template<CpuModel Model> auto opADC()->void;
+    auto opAND()->void;
+    auto opBIT()->void;
+    auto opBITImmediate()->void;
+    auto opCMP()->void;
+    auto opCPX()->void;
+    auto opCPY()->void;
+    auto opEOR()->void;
+    auto opLDA()->void;
+    auto opLDX()->void;
+    auto opLDY()->void;
+    auto opORA()->void;
+    template<CpuModel Model> auto opSBC()->void;
 
-    auto jit_getImmediateIntoAL(TargetAddress *ip)->void;
+    auto opSTA()->void;
+    auto opSTX()->void;
+    auto opSTY()->void;
+    auto opSTZ()->void;
+
+    auto opASL()->void;
+    auto opDEC()->void;
+    auto opINC()->void;
+    auto opLSR()->void;
+    auto opROL()->void;
+    auto opROR()->void;
+    auto opTRB()->void;
+    auto opTSB()->void;
+
+    auto opCLC()->void;
+    auto opCLD()->void;
+    auto opCLI()->void;
+    auto opCLV()->void;
+    auto opDEX()->void;
+    auto opDEY()->void;
+    auto opINX()->void;
+    auto opINY()->void;
+    auto opNOP()->void;
+    auto opPHA()->void;
+    auto opPHP()->void;
+    auto opPHX()->void;
+    auto opPHY()->void;
+    auto opPLA()->void;
+    auto opPLP()->void;
+    auto opPLX()->void;
+    auto opPLY()->void;
+    auto opSEC()->void;
+    auto opSED()->void;
+    auto opSEI()->void;
+    auto opTAX()->void;
+    auto opTAY()->void;
+    auto opTSX()->void;
+    auto opTXA()->void;
+    auto opTXS()->void;
+    auto opTYA()->void;
+
+    // The NMOS undocumented opcodes, most of them two documented operations
+    // in one
+    auto opALR()->void;
+    auto opANC()->void;
+    auto opARR()->void;
+    auto opDCP()->void;
+    template<CpuModel Model> auto opISC()->void;
+    auto opLAX()->void;
+    auto opRLA()->void;
+    template<CpuModel Model> auto opRRA()->void;
+    auto opSAX()->void;
+    auto opSBX()->void;
+    auto opSLO()->void;
+    auto opSRE()->void;
+
+    auto jit_fetchOperand(TargetAddress *ip)->uint16_t;
+    // An address worked out again, for a read-modify-write's write, has
+    // already been charged for crossing a page
+    template<AddressingMode Mode> auto jit_address(uint16_t operand, bool again = false)->EffectiveAddress;
+    template<AddressingMode Mode> auto jit_loadOperand(uint16_t operand)->void;
+    auto jit_indexAddress(size_t index, bool again = false)->void;
+
+    auto jit_blockMove(TargetAddress ip)->void;
+    auto jit_wordOperation(TargetAddress *ip)->bool;
+    auto jit_noteEffects(const OpcodeInfo &info)->void;
+    auto jit_noteSideEffect()->void;
+
+    auto jit_addDecimal()->void;
+    template<CpuModel Model> auto jit_subtractDecimal()->void;
+    auto jit_decimalFlags()->void;
+    auto jit_decimalMode()->bool;
 
     auto jit_setFlags(uint8_t mask)->void;
+    auto jit_setFlagsFromValue(X86Register8 reg)->void;
+    auto jit_countInstruction()->void;
+    auto jit_readMemory(EffectiveAddress address, unsigned accessCycle)->void;
+    auto jit_readPointer(uint16_t operand)->EffectiveAddress;
+    auto jit_writeMemory(EffectiveAddress address, unsigned accessCycle, Emitter data)->void;
+    auto jit_push(X86Register8 data)->void;
+    auto jit_pull()->void;
+    auto jit_recordIOSite(unsigned accessCycle)->void;
+    auto jit_callHelper(NativeAddress helper)->void;
+    auto jit_callDevice(NativeAddress function, void *device, bool writing)->void;
+    auto jit_addCounter(size_t offset, uint32_t count)->void;
+    auto jit_exitBlock(TargetAddress next, unsigned extraCycles = 0, ExitReason reason = ExitNone)->void;
+    auto jit_exitBlockToStoredPC()->void;
+    auto jit_takeBranch(TargetAddress target, unsigned extraCycles)->void;
+    auto jit_noteExit(TargetAddress next)->void;
+    auto jit_leaveBlock(unsigned extraCycles, ExitReason reason)->void;
 
-    static std::array<InstructionJitter, 256> jitters_;
+    // Loads a read-modify-write's result, kept in CL, for its write
+    auto jit_modifiedData()->void;
+
+    static const JitterTable nmosJitters_;
+    static const JitterTable nmosUndocumentedJitters_;
+    static const JitterTable cmosJitters_;
 
     JitVM *vm_;
     AssemblerX86 *assembler_;
     SystemMemory *memory_;
+    CpuModel model_;
+    const OpcodeInfo *opcodes_;
+    const JitterTable *jitters_;
     Entry entryStub_;
-    Exit exitStub_;
+    NativeAddress exitStub_;
     FlagTranslationMap flagTranslationMap_;
+    VMContext context_;
+    Scheduler scheduler_;
+    bool irqLine_;
+    bool nmiPending_;
+    BlockMap blocks_;
+
+    // The guest pages holding code of any block translated, one bit per 256
+    // bytes; translations are never dropped, so pages are never unmarked
+    std::bitset<0x100> translatedPages_;
+
+    JitCounters counters_;
+    GuestPCTable pcTable_;
+    std::vector<IOSite> ioSites_;
+    std::vector<BlockMove> blockMoves_;
+    std::vector<WordOperation> wordOperations_;
+
+    // Translation state for the block being built
+    TargetAddress blockStart_;
+    TargetAddress blockEnd_;
+    uint32_t blockBank_;
+    TargetAddress instructionStart_;
+    const OpcodeInfo *instruction_;
+    unsigned blockCycles_;
+    unsigned blockInstructions_;
+    bool blockIsTrap_;
+    bool blockCyclesVary_;
+
+    // The D flag as translation assumes it: the one the block is entered
+    // with, until SED or CLD; and whether any instruction depends on the one
+    // it is entered with
+    bool blockDecimal_;
+    bool blockDecimalFromEntry_;
+    bool blockDependsOnDecimal_;
+    BlockEffects blockEffects_;
+    std::vector<BlockLabel> blockLabels_;
+    std::vector<BlockExit> blockExits_;
+    unsigned blockIdleCycles_;
+    unsigned blockIdleInstructions_;
 };
@@ -4,6 +4,11 @@
 #include <stdexcept>
 
 #include "jitvm.h"
+#include "perfmap.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 
 using std::runtime_error;
 
@@ -15,7 +20,13 @@ namespace
 
 JitVM::JitVM(uint32_t reserveSize)
 {
+#ifdef _WIN32
     regionBase_ = static_cast<uint8_t*>(VirtualAlloc(nullptr, reserveSize, MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+#else
+    // Reserve address space only; pages are made accessible as they're committed
+    auto region = mmap(nullptr, reserveSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    regionBase_ = region == MAP_FAILED ? nullptr : static_cast<uint8_t*>(region);
+#endif
     if (regionBase_ == nullptr) {
         throw runtime_error("Failed to reserve address space for JIT VM");
     }
@@ -25,11 +36,17 @@ JitVM::JitVM(uint32_t reserveSize)
     nextFree_ = regionBase_;
     currentFragmentStart_ = nullptr;
     nextFragmentByte_ = nullptr;
+    committedBytes_ = 0;
+    usedBytes_ = 0;
  }
 
 JitVM::~JitVM()
 {
+#ifdef _WIN32
     VirtualFree(regionBase_, 0, MEM_RELEASE);
+#else
+    munmap(regionBase_, regionTop_ - regionBase_);
+#endif
 }
 
 auto JitVM::beginCodeFragment() -> void
@@ -41,18 +58,27 @@ auto JitVM::beginCodeFragment() -> void
     nextFragmentByte_ = nextFree_;
 }
 
-auto JitVM::endCodeFragment() -> NativeAddress
+auto JitVM::endCodeFragment(const char *name) -> NativeAddress
 {
     assert(currentFragmentStart_ != nullptr);
     assert(nextFragmentByte_ != nullptr);
 
+#ifdef _WIN32
     if (!FlushInstructionCache(GetCurrentProcess(), currentFragmentStart_, nextFragmentByte_ - currentFragmentStart_)) {
         throw runtime_error("JitVM failed to flush the instruction cache");
     }
+#else
+    __builtin___clear_cache(reinterpret_cast<char *>(currentFragmentStart_), reinterpret_cast<char *>(nextFragmentByte_));
+#endif
     
     auto start = currentFragmentStart_;
 
+    if (auto perfMap = PerfMap::active()) {
+        perfMap->record(start, nextFragmentByte_ - start, name);
+    }
+
     nextFree_ = nextFragmentByte_;
+    usedBytes_.store(nextFree_ - regionBase_, std::memory_order_relaxed);
 
     currentFragmentStart_ = nullptr;
     nextFragmentByte_ = nullptr;
@@ -74,11 +100,37 @@ auto JitVM::nextByte()->NativeAddress
     return nextFragmentByte_;
 }
 
+auto JitVM::reservedBytes() const -> size_t
+{
+    return regionTop_ - regionBase_;
+}
+
+auto JitVM::committedBytes() const -> size_t
+{
+    return committedBytes_.load(std::memory_order_relaxed);
+}
+
+auto JitVM::usedBytes() const -> size_t
+{
+    return usedBytes_.load(std::memory_order_relaxed);
+}
+
 
 auto JitVM::expandRegion() -> void
 {
+    if (regionAllocTop_ + EXPAND_SIZE > regionTop_) {
+        throw runtime_error("JitVM is out of reserved address space.");
+    }
+
+#ifdef _WIN32
     if (VirtualAlloc(regionAllocTop_, EXPAND_SIZE, MEM_COMMIT, PAGE_EXECUTE_READWRITE) == nullptr) {
         throw runtime_error("JitVM failed to allocate more pages.");
     }
+#else
+    if (mprotect(regionAllocTop_, EXPAND_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        throw runtime_error("JitVM failed to allocate more pages.");
+    }
+#endif
     regionAllocTop_ += EXPAND_SIZE;
+    committedBytes_.store(regionAllocTop_ - regionBase_, std::memory_order_relaxed);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
 
 #include "assembler_x86.h"
 #include "types.h"
@@ -12,10 +13,16 @@ public:
 	~JitVM();
 
     auto beginCodeFragment() -> void;
-    auto endCodeFragment() -> NativeAddress;
+    // name identifies the fragment to profilers
+    auto endCodeFragment(const char *name) -> NativeAddress;
     auto addByte(uint8_t byte) -> void;
     auto nextByte() -> NativeAddress;
 
+    // Sizes of the code cache. These may be read from any thread.
+    auto reservedBytes() const -> size_t;
+    auto committedBytes() const -> size_t;
+    auto usedBytes() const -> size_t;
+
 private:
     auto expandRegion() -> void;
 
@@ -37,4 +44,8 @@ private:
     // The next available byte of the current fragment being constructed (or NULL)
     uint8_t *nextFragmentByte_;
 
+    // Mirrors of regionAllocTop_ and nextFree_ as offsets, for other threads
+    std::atomic<size_t> committedBytes_;
+    std::atomic<size_t> usedBytes_;
+
 };
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "stdafx.h"
+
+#include "exceptions.h"
+#include "mappedfile.h"
+
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+
+using oss = std::ostringstream;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string &path)
+    : path_(path)
+    , data_(nullptr)
+    , size_(0)
+    , file_(INVALID_HANDLE_VALUE)
+    , mapping_(nullptr)
+{
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        oss() << "Could not open " << path << throwError;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+        CloseHandle(file_);
+        oss() << "Could not get size of " << path << throwError;
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+
+    // An empty file cannot be mapped, but is still a valid (empty) view.
+    if (size_ == 0) {
+        return;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+        CloseHandle(file_);
+        oss() << "Could not create file mapping for " << path << throwError;
+    }
+
+    data_ = static_cast<const uint8_t *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (data_ == nullptr) {
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        oss() << "Could not map view of " << path << throwError;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(const string &path)
+    : path_(path)
+    , data_(nullptr)
+    , size_(0)
+    , file_(nullptr)
+    , mapping_(nullptr)
+{
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        oss() << "Could not open " << path << throwError;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        oss() << "Could not get size of " << path << throwError;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    // The mapping holds its own reference to the file.
+    if (size_ != 0) {
+        auto view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            close(fd);
+            oss() << "Could not map view of " << path << throwError;
+        }
+        data_ = static_cast<const uint8_t *>(view);
+    }
+
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+}
+
+#endif
+
+auto MappedFile::data() const->const uint8_t *
+{
+    return data_;
+}
+
+auto MappedFile::size() const->size_t
+{
+    return size_;
+}
+
+auto MappedFile::path() const->const string &
+{
+    return path_;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+//
+// MappedFile maps an entire file read-only into the address space. Pages of
+// the file are faulted in by the OS as they are touched, so opening even a
+// very large file costs the same as opening a small one.
+//
+class MappedFile
+{
+public:
+    MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &)->MappedFile & = delete;
+
+    auto data() const->const uint8_t *;
+    auto size() const->size_t;
+    auto path() const->const std::string &;
+
+private:
+    std::string path_;
+    const uint8_t *data_;
+    size_t size_;
+
+    // Platform handles; a file handle and a mapping handle on Windows, a
+    // file descriptor elsewhere.
+    void *file_;
+    void *mapping_;
+};
@@ -0,0 +1,66 @@
+#include "stdafx.h"
+
+#include "opcodes.h"
+
+#include <stdio.h>
+
+using std::string;
+
+auto disassemble(TargetAddress pc, const uint8_t *bytes, CpuModel model)->string
+{
+    auto &info = opcodeTable(model)[bytes[0]];
+    auto byte = bytes[1];
+    auto word = bytes[1] | (bytes[2] << 8);
+
+    char text[16];
+    switch (info.mode) {
+    case Implied:
+        snprintf(text, sizeof(text), "%s", info.mnemonic);
+        break;
+    case Accumulator:
+        snprintf(text, sizeof(text), "%s A", info.mnemonic);
+        break;
+    case Immediate:
+        snprintf(text, sizeof(text), "%s #$%02X", info.mnemonic, byte);
+        break;
+    case ZeroPage:
+        snprintf(text, sizeof(text), "%s $%02X", info.mnemonic, byte);
+        break;
+    case ZeroPageX:
+        snprintf(text, sizeof(text), "%s $%02X,X", info.mnemonic, byte);
+        break;
+    case ZeroPageY:
+        snprintf(text, sizeof(text), "%s $%02X,Y", info.mnemonic, byte);
+        break;
+    case Absolute:
+        snprintf(text, sizeof(text), "%s $%04X", info.mnemonic, word);
+        break;
+    case AbsoluteX:
+        snprintf(text, sizeof(text), "%s $%04X,X", info.mnemonic, word);
+        break;
+    case AbsoluteY:
+        snprintf(text, sizeof(text), "%s $%04X,Y", info.mnemonic, word);
+        break;
+    case Indirect:
+        snprintf(text, sizeof(text), "%s ($%04X)", info.mnemonic, word);
+        break;
+    case IndirectX:
+        snprintf(text, sizeof(text), "%s ($%02X,X)", info.mnemonic, byte);
+        break;
+    case IndirectY:
+        snprintf(text, sizeof(text), "%s ($%02X),Y", info.mnemonic, byte);
+        break;
+    case Relative:
+        // Shown as the branch target, as assemblers take it
+        snprintf(text, sizeof(text), "%s $%04X", info.mnemonic,
+            static_cast<TargetAddress>(pc + 2 + static_cast<int8_t>(byte)));
+        break;
+    case ZeroPageIndirect:
+        snprintf(text, sizeof(text), "%s ($%02X)", info.mnemonic, byte);
+        break;
+    case AbsoluteIndirectX:
+        snprintf(text, sizeof(text), "%s ($%04X,X)", info.mnemonic, word);
+        break;
+    }
+    return text;
+}
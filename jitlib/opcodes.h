@@ -0,0 +1,930 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "cpustate.h"
+#include "types.h"
+
+//
+// OPCODES describes every 6502 opcode: what it is called, how it addresses
+// its operand, how long it is and takes, and what it reads, writes and does
+// to control flow. The translator, its block analysis, the profiler and the
+// disassembler all take their knowledge of the instruction set from here, so
+// they cannot disagree. Opcodes the NMOS 6502 does not document are invalid.
+//
+// Each CpuModel has its own table. OPCODES_UNDOCUMENTED adds the NMOS
+// opcodes that behave the same on every chip; those that do not, and those
+// that hang it, stay invalid. OPCODES_65C02 has the CMOS instructions and
+// timings, and no invalid opcodes: the 65C02 treats them all as NOPs.
+//
+// The table is built at compile time; opcode() fills in what follows from
+// the addressing mode, the length and any index register read.
+//
+
+enum AddressingMode : uint8_t
+{
+    Implied,
+    Accumulator,
+    Immediate,
+    ZeroPage,
+    ZeroPageX,
+    ZeroPageY,
+    Absolute,
+    AbsoluteX,
+    AbsoluteY,
+    Indirect,
+    IndirectX,
+    IndirectY,
+    Relative,
+
+    // 65C02 only: (zp), and JMP (abs,X)
+    ZeroPageIndirect,
+    AbsoluteIndirectX,
+};
+
+enum CpuModel : uint8_t
+{
+    CPU_NMOS,
+    CPU_NMOS_UNDOCUMENTED,
+    CPU_65C02,
+};
+
+enum ControlFlow : uint8_t
+{
+    FlowNext,
+    FlowBranch,
+    FlowJump,
+    FlowJumpIndirect,
+    FlowCall,
+    FlowReturn,
+    FlowReturnFromInterrupt,
+    FlowBreak,
+    FlowInvalid,
+};
+
+// How an instruction uses memory besides fetching itself. Stack accesses are
+// also reads or writes.
+enum MemoryAccess : uint8_t
+{
+    AccessNone = 0x00,
+    AccessRead = 0x01,
+    AccessWrite = 0x02,
+    AccessStack = 0x04,
+};
+
+enum M6502Registers : uint8_t
+{
+    M6502_A = 0x01,
+    M6502_X = 0x02,
+    M6502_Y = 0x04,
+    M6502_S = 0x08,
+};
+
+// The flags P holds; B and bit 5 only exist in copies pushed to the stack
+const uint8_t M6502_FLAGS = M6502_CARRY | M6502_ZERO | M6502_INTERRUPT | M6502_DECIMAL | M6502_OVERFLOW | M6502_SIGN;
+
+struct OpcodeInfo
+{
+    const char *mnemonic;
+    AddressingMode mode;
+    uint8_t length;
+    uint8_t cycles;
+
+    // One more cycle when indexing crosses a page. Taken branches always
+    // cost one more, and this one more again if they land on another page.
+    bool pageCrossPenalty;
+
+    uint8_t flagsRead;
+    uint8_t flagsWritten;
+    uint8_t registersRead;
+    uint8_t registersWritten;
+    uint8_t access;
+    ControlFlow flow;
+};
+
+constexpr auto instructionLength(AddressingMode mode)->uint8_t
+{
+    return
+        mode == Implied || mode == Accumulator ? 1 :
+        mode == Absolute || mode == AbsoluteX || mode == AbsoluteY || mode == Indirect || mode == AbsoluteIndirectX ? 3 :
+        2;
+}
+
+constexpr auto indexRegister(AddressingMode mode)->uint8_t
+{
+    return
+        mode == ZeroPageX || mode == AbsoluteX || mode == IndirectX || mode == AbsoluteIndirectX ? M6502_X :
+        mode == ZeroPageY || mode == AbsoluteY || mode == IndirectY ? M6502_Y :
+        0;
+}
+
+constexpr auto opcode(
+    const char *mnemonic, AddressingMode mode, uint8_t cycles, bool pageCrossPenalty,
+    uint8_t flagsRead, uint8_t flagsWritten, uint8_t registersRead, uint8_t registersWritten,
+    uint8_t access, ControlFlow flow = FlowNext)->OpcodeInfo
+{
+    return OpcodeInfo{
+        mnemonic, mode, instructionLength(mode), cycles, pageCrossPenalty,
+        flagsRead, flagsWritten, static_cast<uint8_t>(registersRead | indexRegister(mode)), registersWritten,
+        access, flow };
+}
+
+// Invalid opcodes stop the guest, so nothing about them matters but that
+constexpr OpcodeInfo INVALID_OPCODE = { "???", Implied, 1, 0, false, 0, 0, 0, 0, AccessNone, FlowInvalid };
+
+constexpr OpcodeInfo OPCODES[256] = {
+    /*00*/ opcode("BRK", Implied, 7, false, M6502_FLAGS, M6502_INTERRUPT, M6502_S, M6502_S, AccessWrite | AccessStack, FlowBreak),
+    /*01*/ opcode("ORA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*02*/ INVALID_OPCODE,
+    /*03*/ INVALID_OPCODE,
+    /*04*/ INVALID_OPCODE,
+    /*05*/ opcode("ORA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*06*/ opcode("ASL", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*07*/ INVALID_OPCODE,
+    /*08*/ opcode("PHP", Implied, 3, false, M6502_FLAGS, 0, M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*09*/ opcode("ORA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0A*/ opcode("ASL", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0B*/ INVALID_OPCODE,
+    /*0C*/ INVALID_OPCODE,
+    /*0D*/ opcode("ORA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*0E*/ opcode("ASL", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*0F*/ INVALID_OPCODE,
+    /*10*/ opcode("BPL", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*11*/ opcode("ORA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*12*/ INVALID_OPCODE,
+    /*13*/ INVALID_OPCODE,
+    /*14*/ INVALID_OPCODE,
+    /*15*/ opcode("ORA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*16*/ opcode("ASL", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*17*/ INVALID_OPCODE,
+    /*18*/ opcode("CLC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*19*/ opcode("ORA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1A*/ INVALID_OPCODE,
+    /*1B*/ INVALID_OPCODE,
+    /*1C*/ INVALID_OPCODE,
+    /*1D*/ opcode("ORA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1E*/ opcode("ASL", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*1F*/ INVALID_OPCODE,
+    /*20*/ opcode("JSR", Absolute, 6, false, 0, 0, M6502_S, M6502_S, AccessWrite | AccessStack, FlowCall),
+    /*21*/ opcode("AND", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*22*/ INVALID_OPCODE,
+    /*23*/ INVALID_OPCODE,
+    /*24*/ opcode("BIT", ZeroPage, 3, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*25*/ opcode("AND", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*26*/ opcode("ROL", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*27*/ INVALID_OPCODE,
+    /*28*/ opcode("PLP", Implied, 4, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack),
+    /*29*/ opcode("AND", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2A*/ opcode("ROL", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2B*/ INVALID_OPCODE,
+    /*2C*/ opcode("BIT", Absolute, 4, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*2D*/ opcode("AND", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*2E*/ opcode("ROL", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*2F*/ INVALID_OPCODE,
+    /*30*/ opcode("BMI", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*31*/ opcode("AND", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*32*/ INVALID_OPCODE,
+    /*33*/ INVALID_OPCODE,
+    /*34*/ INVALID_OPCODE,
+    /*35*/ opcode("AND", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*36*/ opcode("ROL", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*37*/ INVALID_OPCODE,
+    /*38*/ opcode("SEC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*39*/ opcode("AND", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3A*/ INVALID_OPCODE,
+    /*3B*/ INVALID_OPCODE,
+    /*3C*/ INVALID_OPCODE,
+    /*3D*/ opcode("AND", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3E*/ opcode("ROL", AbsoluteX, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*3F*/ INVALID_OPCODE,
+    /*40*/ opcode("RTI", Implied, 6, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturnFromInterrupt),
+    /*41*/ opcode("EOR", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*42*/ INVALID_OPCODE,
+    /*43*/ INVALID_OPCODE,
+    /*44*/ INVALID_OPCODE,
+    /*45*/ opcode("EOR", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*46*/ opcode("LSR", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*47*/ INVALID_OPCODE,
+    /*48*/ opcode("PHA", Implied, 3, false, 0, 0, M6502_A | M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*49*/ opcode("EOR", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4A*/ opcode("LSR", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4B*/ INVALID_OPCODE,
+    /*4C*/ opcode("JMP", Absolute, 3, false, 0, 0, 0, 0, AccessNone, FlowJump),
+    /*4D*/ opcode("EOR", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*4E*/ opcode("LSR", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*4F*/ INVALID_OPCODE,
+    /*50*/ opcode("BVC", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*51*/ opcode("EOR", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*52*/ INVALID_OPCODE,
+    /*53*/ INVALID_OPCODE,
+    /*54*/ INVALID_OPCODE,
+    /*55*/ opcode("EOR", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*56*/ opcode("LSR", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*57*/ INVALID_OPCODE,
+    /*58*/ opcode("CLI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*59*/ opcode("EOR", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5A*/ INVALID_OPCODE,
+    /*5B*/ INVALID_OPCODE,
+    /*5C*/ INVALID_OPCODE,
+    /*5D*/ opcode("EOR", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5E*/ opcode("LSR", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*5F*/ INVALID_OPCODE,
+    /*60*/ opcode("RTS", Implied, 6, false, 0, 0, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturn),
+    /*61*/ opcode("ADC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*62*/ INVALID_OPCODE,
+    /*63*/ INVALID_OPCODE,
+    /*64*/ INVALID_OPCODE,
+    /*65*/ opcode("ADC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*66*/ opcode("ROR", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*67*/ INVALID_OPCODE,
+    /*68*/ opcode("PLA", Implied, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_A | M6502_S, AccessRead | AccessStack),
+    /*69*/ opcode("ADC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6A*/ opcode("ROR", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6B*/ INVALID_OPCODE,
+    /*6C*/ opcode("JMP", Indirect, 5, false, 0, 0, 0, 0, AccessRead, FlowJumpIndirect),
+    /*6D*/ opcode("ADC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*6E*/ opcode("ROR", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*6F*/ INVALID_OPCODE,
+    /*70*/ opcode("BVS", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*71*/ opcode("ADC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*72*/ INVALID_OPCODE,
+    /*73*/ INVALID_OPCODE,
+    /*74*/ INVALID_OPCODE,
+    /*75*/ opcode("ADC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*76*/ opcode("ROR", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*77*/ INVALID_OPCODE,
+    /*78*/ opcode("SEI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*79*/ opcode("ADC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7A*/ INVALID_OPCODE,
+    /*7B*/ INVALID_OPCODE,
+    /*7C*/ INVALID_OPCODE,
+    /*7D*/ opcode("ADC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7E*/ opcode("ROR", AbsoluteX, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*7F*/ INVALID_OPCODE,
+    /*80*/ INVALID_OPCODE,
+    /*81*/ opcode("STA", IndirectX, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*82*/ INVALID_OPCODE,
+    /*83*/ INVALID_OPCODE,
+    /*84*/ opcode("STY", ZeroPage, 3, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*85*/ opcode("STA", ZeroPage, 3, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*86*/ opcode("STX", ZeroPage, 3, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*87*/ INVALID_OPCODE,
+    /*88*/ opcode("DEY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*89*/ INVALID_OPCODE,
+    /*8A*/ opcode("TXA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_A, AccessNone),
+    /*8B*/ INVALID_OPCODE,
+    /*8C*/ opcode("STY", Absolute, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*8D*/ opcode("STA", Absolute, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*8E*/ opcode("STX", Absolute, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*8F*/ INVALID_OPCODE,
+    /*90*/ opcode("BCC", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*91*/ opcode("STA", IndirectY, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*92*/ INVALID_OPCODE,
+    /*93*/ INVALID_OPCODE,
+    /*94*/ opcode("STY", ZeroPageX, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*95*/ opcode("STA", ZeroPageX, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*96*/ opcode("STX", ZeroPageY, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*97*/ INVALID_OPCODE,
+    /*98*/ opcode("TYA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_A, AccessNone),
+    /*99*/ opcode("STA", AbsoluteY, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9A*/ opcode("TXS", Implied, 2, false, 0, 0, M6502_X, M6502_S, AccessNone),
+    /*9B*/ INVALID_OPCODE,
+    /*9C*/ INVALID_OPCODE,
+    /*9D*/ opcode("STA", AbsoluteX, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9E*/ INVALID_OPCODE,
+    /*9F*/ INVALID_OPCODE,
+    /*A0*/ opcode("LDY", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessNone),
+    /*A1*/ opcode("LDA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A2*/ opcode("LDX", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessNone),
+    /*A3*/ INVALID_OPCODE,
+    /*A4*/ opcode("LDY", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*A5*/ opcode("LDA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A6*/ opcode("LDX", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*A7*/ INVALID_OPCODE,
+    /*A8*/ opcode("TAY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_Y, AccessNone),
+    /*A9*/ opcode("LDA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessNone),
+    /*AA*/ opcode("TAX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_X, AccessNone),
+    /*AB*/ INVALID_OPCODE,
+    /*AC*/ opcode("LDY", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*AD*/ opcode("LDA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*AE*/ opcode("LDX", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*AF*/ INVALID_OPCODE,
+    /*B0*/ opcode("BCS", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*B1*/ opcode("LDA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B2*/ INVALID_OPCODE,
+    /*B3*/ INVALID_OPCODE,
+    /*B4*/ opcode("LDY", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*B5*/ opcode("LDA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B6*/ opcode("LDX", ZeroPageY, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*B7*/ INVALID_OPCODE,
+    /*B8*/ opcode("CLV", Implied, 2, false, 0, M6502_OVERFLOW, 0, 0, AccessNone),
+    /*B9*/ opcode("LDA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BA*/ opcode("TSX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_X, AccessNone),
+    /*BB*/ INVALID_OPCODE,
+    /*BC*/ opcode("LDY", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*BD*/ opcode("LDA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BE*/ opcode("LDX", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*BF*/ INVALID_OPCODE,
+    /*C0*/ opcode("CPY", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessNone),
+    /*C1*/ opcode("CMP", IndirectX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C2*/ INVALID_OPCODE,
+    /*C3*/ INVALID_OPCODE,
+    /*C4*/ opcode("CPY", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*C5*/ opcode("CMP", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C6*/ opcode("DEC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*C7*/ INVALID_OPCODE,
+    /*C8*/ opcode("INY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*C9*/ opcode("CMP", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessNone),
+    /*CA*/ opcode("DEX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*CB*/ INVALID_OPCODE,
+    /*CC*/ opcode("CPY", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*CD*/ opcode("CMP", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*CE*/ opcode("DEC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*CF*/ INVALID_OPCODE,
+    /*D0*/ opcode("BNE", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*D1*/ opcode("CMP", IndirectY, 5, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D2*/ INVALID_OPCODE,
+    /*D3*/ INVALID_OPCODE,
+    /*D4*/ INVALID_OPCODE,
+    /*D5*/ opcode("CMP", ZeroPageX, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D6*/ opcode("DEC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*D7*/ INVALID_OPCODE,
+    /*D8*/ opcode("CLD", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*D9*/ opcode("CMP", AbsoluteY, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DA*/ INVALID_OPCODE,
+    /*DB*/ INVALID_OPCODE,
+    /*DC*/ INVALID_OPCODE,
+    /*DD*/ opcode("CMP", AbsoluteX, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DE*/ opcode("DEC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*DF*/ INVALID_OPCODE,
+    /*E0*/ opcode("CPX", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessNone),
+    /*E1*/ opcode("SBC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E2*/ INVALID_OPCODE,
+    /*E3*/ INVALID_OPCODE,
+    /*E4*/ opcode("CPX", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*E5*/ opcode("SBC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E6*/ opcode("INC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*E7*/ INVALID_OPCODE,
+    /*E8*/ opcode("INX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*E9*/ opcode("SBC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*EA*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*EB*/ INVALID_OPCODE,
+    /*EC*/ opcode("CPX", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*ED*/ opcode("SBC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*EE*/ opcode("INC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*EF*/ INVALID_OPCODE,
+    /*F0*/ opcode("BEQ", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*F1*/ opcode("SBC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F2*/ INVALID_OPCODE,
+    /*F3*/ INVALID_OPCODE,
+    /*F4*/ INVALID_OPCODE,
+    /*F5*/ opcode("SBC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F6*/ opcode("INC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*F7*/ INVALID_OPCODE,
+    /*F8*/ opcode("SED", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*F9*/ opcode("SBC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FA*/ INVALID_OPCODE,
+    /*FB*/ INVALID_OPCODE,
+    /*FC*/ INVALID_OPCODE,
+    /*FD*/ opcode("SBC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FE*/ opcode("INC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*FF*/ INVALID_OPCODE,
+};
+
+constexpr OpcodeInfo OPCODES_UNDOCUMENTED[256] = {
+    /*00*/ opcode("BRK", Implied, 7, false, M6502_FLAGS, M6502_INTERRUPT, M6502_S, M6502_S, AccessWrite | AccessStack, FlowBreak),
+    /*01*/ opcode("ORA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*02*/ INVALID_OPCODE,
+    /*03*/ opcode("SLO", IndirectX, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*04*/ opcode("NOP", ZeroPage, 3, false, 0, 0, 0, 0, AccessRead),
+    /*05*/ opcode("ORA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*06*/ opcode("ASL", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*07*/ opcode("SLO", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*08*/ opcode("PHP", Implied, 3, false, M6502_FLAGS, 0, M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*09*/ opcode("ORA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0A*/ opcode("ASL", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0B*/ opcode("ANC", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0C*/ opcode("NOP", Absolute, 4, false, 0, 0, 0, 0, AccessRead),
+    /*0D*/ opcode("ORA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*0E*/ opcode("ASL", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*0F*/ opcode("SLO", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*10*/ opcode("BPL", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*11*/ opcode("ORA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*12*/ INVALID_OPCODE,
+    /*13*/ opcode("SLO", IndirectY, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*14*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*15*/ opcode("ORA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*16*/ opcode("ASL", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*17*/ opcode("SLO", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*18*/ opcode("CLC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*19*/ opcode("ORA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1A*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*1B*/ opcode("SLO", AbsoluteY, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*1C*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*1D*/ opcode("ORA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1E*/ opcode("ASL", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*1F*/ opcode("SLO", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*20*/ opcode("JSR", Absolute, 6, false, 0, 0, M6502_S, M6502_S, AccessWrite | AccessStack, FlowCall),
+    /*21*/ opcode("AND", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*22*/ INVALID_OPCODE,
+    /*23*/ opcode("RLA", IndirectX, 8, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*24*/ opcode("BIT", ZeroPage, 3, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*25*/ opcode("AND", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*26*/ opcode("ROL", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*27*/ opcode("RLA", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*28*/ opcode("PLP", Implied, 4, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack),
+    /*29*/ opcode("AND", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2A*/ opcode("ROL", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2B*/ opcode("ANC", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2C*/ opcode("BIT", Absolute, 4, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*2D*/ opcode("AND", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*2E*/ opcode("ROL", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*2F*/ opcode("RLA", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*30*/ opcode("BMI", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*31*/ opcode("AND", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*32*/ INVALID_OPCODE,
+    /*33*/ opcode("RLA", IndirectY, 8, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*34*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*35*/ opcode("AND", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*36*/ opcode("ROL", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*37*/ opcode("RLA", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*38*/ opcode("SEC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*39*/ opcode("AND", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3A*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*3B*/ opcode("RLA", AbsoluteY, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*3C*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*3D*/ opcode("AND", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3E*/ opcode("ROL", AbsoluteX, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*3F*/ opcode("RLA", AbsoluteX, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*40*/ opcode("RTI", Implied, 6, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturnFromInterrupt),
+    /*41*/ opcode("EOR", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*42*/ INVALID_OPCODE,
+    /*43*/ opcode("SRE", IndirectX, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*44*/ opcode("NOP", ZeroPage, 3, false, 0, 0, 0, 0, AccessRead),
+    /*45*/ opcode("EOR", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*46*/ opcode("LSR", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*47*/ opcode("SRE", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*48*/ opcode("PHA", Implied, 3, false, 0, 0, M6502_A | M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*49*/ opcode("EOR", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4A*/ opcode("LSR", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4B*/ opcode("ALR", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4C*/ opcode("JMP", Absolute, 3, false, 0, 0, 0, 0, AccessNone, FlowJump),
+    /*4D*/ opcode("EOR", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*4E*/ opcode("LSR", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*4F*/ opcode("SRE", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*50*/ opcode("BVC", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*51*/ opcode("EOR", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*52*/ INVALID_OPCODE,
+    /*53*/ opcode("SRE", IndirectY, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*54*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*55*/ opcode("EOR", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*56*/ opcode("LSR", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*57*/ opcode("SRE", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*58*/ opcode("CLI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*59*/ opcode("EOR", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5A*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*5B*/ opcode("SRE", AbsoluteY, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*5C*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*5D*/ opcode("EOR", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5E*/ opcode("LSR", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*5F*/ opcode("SRE", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*60*/ opcode("RTS", Implied, 6, false, 0, 0, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturn),
+    /*61*/ opcode("ADC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*62*/ INVALID_OPCODE,
+    /*63*/ opcode("RRA", IndirectX, 8, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*64*/ opcode("NOP", ZeroPage, 3, false, 0, 0, 0, 0, AccessRead),
+    /*65*/ opcode("ADC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*66*/ opcode("ROR", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*67*/ opcode("RRA", ZeroPage, 5, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*68*/ opcode("PLA", Implied, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_A | M6502_S, AccessRead | AccessStack),
+    /*69*/ opcode("ADC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6A*/ opcode("ROR", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6B*/ opcode("ARR", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6C*/ opcode("JMP", Indirect, 5, false, 0, 0, 0, 0, AccessRead, FlowJumpIndirect),
+    /*6D*/ opcode("ADC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*6E*/ opcode("ROR", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*6F*/ opcode("RRA", Absolute, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*70*/ opcode("BVS", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*71*/ opcode("ADC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*72*/ INVALID_OPCODE,
+    /*73*/ opcode("RRA", IndirectY, 8, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*74*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*75*/ opcode("ADC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*76*/ opcode("ROR", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*77*/ opcode("RRA", ZeroPageX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*78*/ opcode("SEI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*79*/ opcode("ADC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7A*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*7B*/ opcode("RRA", AbsoluteY, 7, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*7C*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*7D*/ opcode("ADC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7E*/ opcode("ROR", AbsoluteX, 7, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*7F*/ opcode("RRA", AbsoluteX, 7, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*80*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*81*/ opcode("STA", IndirectX, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*82*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*83*/ opcode("SAX", IndirectX, 6, false, 0, 0, M6502_A | M6502_X, 0, AccessWrite),
+    /*84*/ opcode("STY", ZeroPage, 3, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*85*/ opcode("STA", ZeroPage, 3, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*86*/ opcode("STX", ZeroPage, 3, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*87*/ opcode("SAX", ZeroPage, 3, false, 0, 0, M6502_A | M6502_X, 0, AccessWrite),
+    /*88*/ opcode("DEY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*89*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*8A*/ opcode("TXA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_A, AccessNone),
+    /*8B*/ INVALID_OPCODE,
+    /*8C*/ opcode("STY", Absolute, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*8D*/ opcode("STA", Absolute, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*8E*/ opcode("STX", Absolute, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*8F*/ opcode("SAX", Absolute, 4, false, 0, 0, M6502_A | M6502_X, 0, AccessWrite),
+    /*90*/ opcode("BCC", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*91*/ opcode("STA", IndirectY, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*92*/ INVALID_OPCODE,
+    /*93*/ INVALID_OPCODE,
+    /*94*/ opcode("STY", ZeroPageX, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*95*/ opcode("STA", ZeroPageX, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*96*/ opcode("STX", ZeroPageY, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*97*/ opcode("SAX", ZeroPageY, 4, false, 0, 0, M6502_A | M6502_X, 0, AccessWrite),
+    /*98*/ opcode("TYA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_A, AccessNone),
+    /*99*/ opcode("STA", AbsoluteY, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9A*/ opcode("TXS", Implied, 2, false, 0, 0, M6502_X, M6502_S, AccessNone),
+    /*9B*/ INVALID_OPCODE,
+    /*9C*/ INVALID_OPCODE,
+    /*9D*/ opcode("STA", AbsoluteX, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9E*/ INVALID_OPCODE,
+    /*9F*/ INVALID_OPCODE,
+    /*A0*/ opcode("LDY", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessNone),
+    /*A1*/ opcode("LDA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A2*/ opcode("LDX", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessNone),
+    /*A3*/ opcode("LAX", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*A4*/ opcode("LDY", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*A5*/ opcode("LDA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A6*/ opcode("LDX", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*A7*/ opcode("LAX", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*A8*/ opcode("TAY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_Y, AccessNone),
+    /*A9*/ opcode("LDA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessNone),
+    /*AA*/ opcode("TAX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_X, AccessNone),
+    /*AB*/ INVALID_OPCODE,
+    /*AC*/ opcode("LDY", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*AD*/ opcode("LDA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*AE*/ opcode("LDX", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*AF*/ opcode("LAX", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*B0*/ opcode("BCS", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*B1*/ opcode("LDA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B2*/ INVALID_OPCODE,
+    /*B3*/ opcode("LAX", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*B4*/ opcode("LDY", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*B5*/ opcode("LDA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B6*/ opcode("LDX", ZeroPageY, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*B7*/ opcode("LAX", ZeroPageY, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*B8*/ opcode("CLV", Implied, 2, false, 0, M6502_OVERFLOW, 0, 0, AccessNone),
+    /*B9*/ opcode("LDA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BA*/ opcode("TSX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_X, AccessNone),
+    /*BB*/ INVALID_OPCODE,
+    /*BC*/ opcode("LDY", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*BD*/ opcode("LDA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BE*/ opcode("LDX", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*BF*/ opcode("LAX", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A | M6502_X, AccessRead),
+    /*C0*/ opcode("CPY", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessNone),
+    /*C1*/ opcode("CMP", IndirectX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C2*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*C3*/ opcode("DCP", IndirectX, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*C4*/ opcode("CPY", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*C5*/ opcode("CMP", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C6*/ opcode("DEC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*C7*/ opcode("DCP", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*C8*/ opcode("INY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*C9*/ opcode("CMP", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessNone),
+    /*CA*/ opcode("DEX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*CB*/ opcode("SBX", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A | M6502_X, M6502_X, AccessNone),
+    /*CC*/ opcode("CPY", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*CD*/ opcode("CMP", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*CE*/ opcode("DEC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*CF*/ opcode("DCP", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*D0*/ opcode("BNE", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*D1*/ opcode("CMP", IndirectY, 5, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D2*/ INVALID_OPCODE,
+    /*D3*/ opcode("DCP", IndirectY, 8, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*D4*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*D5*/ opcode("CMP", ZeroPageX, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D6*/ opcode("DEC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*D7*/ opcode("DCP", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*D8*/ opcode("CLD", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*D9*/ opcode("CMP", AbsoluteY, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DA*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*DB*/ opcode("DCP", AbsoluteY, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*DC*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*DD*/ opcode("CMP", AbsoluteX, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DE*/ opcode("DEC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*DF*/ opcode("DCP", AbsoluteX, 7, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead | AccessWrite),
+    /*E0*/ opcode("CPX", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessNone),
+    /*E1*/ opcode("SBC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E2*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*E3*/ opcode("ISC", IndirectX, 8, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*E4*/ opcode("CPX", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*E5*/ opcode("SBC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E6*/ opcode("INC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*E7*/ opcode("ISC", ZeroPage, 5, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*E8*/ opcode("INX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*E9*/ opcode("SBC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*EA*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*EB*/ opcode("SBC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*EC*/ opcode("CPX", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*ED*/ opcode("SBC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*EE*/ opcode("INC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*EF*/ opcode("ISC", Absolute, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*F0*/ opcode("BEQ", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*F1*/ opcode("SBC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F2*/ INVALID_OPCODE,
+    /*F3*/ opcode("ISC", IndirectY, 8, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*F4*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*F5*/ opcode("SBC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F6*/ opcode("INC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*F7*/ opcode("ISC", ZeroPageX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*F8*/ opcode("SED", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*F9*/ opcode("SBC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FA*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*FB*/ opcode("ISC", AbsoluteY, 7, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+    /*FC*/ opcode("NOP", AbsoluteX, 4, true, 0, 0, 0, 0, AccessRead),
+    /*FD*/ opcode("SBC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FE*/ opcode("INC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*FF*/ opcode("ISC", AbsoluteX, 7, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead | AccessWrite),
+};
+
+constexpr OpcodeInfo OPCODES_65C02[256] = {
+    /*00*/ opcode("BRK", Implied, 7, false, M6502_FLAGS, M6502_INTERRUPT, M6502_S, M6502_S, AccessWrite | AccessStack, FlowBreak),
+    /*01*/ opcode("ORA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*02*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*03*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*04*/ opcode("TSB", ZeroPage, 5, false, 0, M6502_ZERO, M6502_A, 0, AccessRead | AccessWrite),
+    /*05*/ opcode("ORA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*06*/ opcode("ASL", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*07*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*08*/ opcode("PHP", Implied, 3, false, M6502_FLAGS, 0, M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*09*/ opcode("ORA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0A*/ opcode("ASL", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*0B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*0C*/ opcode("TSB", Absolute, 6, false, 0, M6502_ZERO, M6502_A, 0, AccessRead | AccessWrite),
+    /*0D*/ opcode("ORA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*0E*/ opcode("ASL", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*0F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*10*/ opcode("BPL", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*11*/ opcode("ORA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*12*/ opcode("ORA", ZeroPageIndirect, 5, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*13*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*14*/ opcode("TRB", ZeroPage, 5, false, 0, M6502_ZERO, M6502_A, 0, AccessRead | AccessWrite),
+    /*15*/ opcode("ORA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*16*/ opcode("ASL", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*17*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*18*/ opcode("CLC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*19*/ opcode("ORA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1A*/ opcode("INC", Accumulator, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*1B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*1C*/ opcode("TRB", Absolute, 6, false, 0, M6502_ZERO, M6502_A, 0, AccessRead | AccessWrite),
+    /*1D*/ opcode("ORA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*1E*/ opcode("ASL", AbsoluteX, 6, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*1F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*20*/ opcode("JSR", Absolute, 6, false, 0, 0, M6502_S, M6502_S, AccessWrite | AccessStack, FlowCall),
+    /*21*/ opcode("AND", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*22*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*23*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*24*/ opcode("BIT", ZeroPage, 3, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*25*/ opcode("AND", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*26*/ opcode("ROL", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*27*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*28*/ opcode("PLP", Implied, 4, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack),
+    /*29*/ opcode("AND", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2A*/ opcode("ROL", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*2B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*2C*/ opcode("BIT", Absolute, 4, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*2D*/ opcode("AND", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*2E*/ opcode("ROL", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*2F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*30*/ opcode("BMI", Relative, 2, true, M6502_SIGN, 0, 0, 0, AccessNone, FlowBranch),
+    /*31*/ opcode("AND", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*32*/ opcode("AND", ZeroPageIndirect, 5, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*33*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*34*/ opcode("BIT", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*35*/ opcode("AND", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*36*/ opcode("ROL", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*37*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*38*/ opcode("SEC", Implied, 2, false, 0, M6502_CARRY, 0, 0, AccessNone),
+    /*39*/ opcode("AND", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3A*/ opcode("DEC", Accumulator, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*3B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*3C*/ opcode("BIT", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*3D*/ opcode("AND", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*3E*/ opcode("ROL", AbsoluteX, 6, true, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*3F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*40*/ opcode("RTI", Implied, 6, false, 0, M6502_FLAGS, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturnFromInterrupt),
+    /*41*/ opcode("EOR", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*42*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*43*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*44*/ opcode("NOP", ZeroPage, 3, false, 0, 0, 0, 0, AccessRead),
+    /*45*/ opcode("EOR", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*46*/ opcode("LSR", ZeroPage, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*47*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*48*/ opcode("PHA", Implied, 3, false, 0, 0, M6502_A | M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*49*/ opcode("EOR", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4A*/ opcode("LSR", Accumulator, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*4B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*4C*/ opcode("JMP", Absolute, 3, false, 0, 0, 0, 0, AccessNone, FlowJump),
+    /*4D*/ opcode("EOR", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*4E*/ opcode("LSR", Absolute, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*4F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*50*/ opcode("BVC", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*51*/ opcode("EOR", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*52*/ opcode("EOR", ZeroPageIndirect, 5, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*53*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*54*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*55*/ opcode("EOR", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*56*/ opcode("LSR", ZeroPageX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*57*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*58*/ opcode("CLI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*59*/ opcode("EOR", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5A*/ opcode("PHY", Implied, 3, false, 0, 0, M6502_Y | M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*5B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*5C*/ opcode("NOP", Absolute, 8, false, 0, 0, 0, 0, AccessRead),
+    /*5D*/ opcode("EOR", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*5E*/ opcode("LSR", AbsoluteX, 6, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*5F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*60*/ opcode("RTS", Implied, 6, false, 0, 0, M6502_S, M6502_S, AccessRead | AccessStack, FlowReturn),
+    /*61*/ opcode("ADC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*62*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*63*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*64*/ opcode("STZ", ZeroPage, 3, false, 0, 0, 0, 0, AccessWrite),
+    /*65*/ opcode("ADC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*66*/ opcode("ROR", ZeroPage, 5, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*67*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*68*/ opcode("PLA", Implied, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_A | M6502_S, AccessRead | AccessStack),
+    /*69*/ opcode("ADC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6A*/ opcode("ROR", Accumulator, 2, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*6B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*6C*/ opcode("JMP", Indirect, 6, false, 0, 0, 0, 0, AccessRead, FlowJumpIndirect),
+    /*6D*/ opcode("ADC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*6E*/ opcode("ROR", Absolute, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*6F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*70*/ opcode("BVS", Relative, 2, true, M6502_OVERFLOW, 0, 0, 0, AccessNone, FlowBranch),
+    /*71*/ opcode("ADC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*72*/ opcode("ADC", ZeroPageIndirect, 5, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*73*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*74*/ opcode("STZ", ZeroPageX, 4, false, 0, 0, 0, 0, AccessWrite),
+    /*75*/ opcode("ADC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*76*/ opcode("ROR", ZeroPageX, 6, false, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*77*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*78*/ opcode("SEI", Implied, 2, false, 0, M6502_INTERRUPT, 0, 0, AccessNone),
+    /*79*/ opcode("ADC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7A*/ opcode("PLY", Implied, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_Y | M6502_S, AccessRead | AccessStack),
+    /*7B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*7C*/ opcode("JMP", AbsoluteIndirectX, 6, false, 0, 0, 0, 0, AccessRead, FlowJumpIndirect),
+    /*7D*/ opcode("ADC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*7E*/ opcode("ROR", AbsoluteX, 6, true, M6502_CARRY, M6502_CARRY | M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*7F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*80*/ opcode("BRA", Relative, 3, true, 0, 0, 0, 0, AccessNone, FlowJump),
+    /*81*/ opcode("STA", IndirectX, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*82*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*83*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*84*/ opcode("STY", ZeroPage, 3, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*85*/ opcode("STA", ZeroPage, 3, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*86*/ opcode("STX", ZeroPage, 3, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*87*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*88*/ opcode("DEY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*89*/ opcode("BIT", Immediate, 2, false, 0, M6502_ZERO, M6502_A, 0, AccessNone),
+    /*8A*/ opcode("TXA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_A, AccessNone),
+    /*8B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*8C*/ opcode("STY", Absolute, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*8D*/ opcode("STA", Absolute, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*8E*/ opcode("STX", Absolute, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*8F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*90*/ opcode("BCC", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*91*/ opcode("STA", IndirectY, 6, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*92*/ opcode("STA", ZeroPageIndirect, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*93*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*94*/ opcode("STY", ZeroPageX, 4, false, 0, 0, M6502_Y, 0, AccessWrite),
+    /*95*/ opcode("STA", ZeroPageX, 4, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*96*/ opcode("STX", ZeroPageY, 4, false, 0, 0, M6502_X, 0, AccessWrite),
+    /*97*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*98*/ opcode("TYA", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_A, AccessNone),
+    /*99*/ opcode("STA", AbsoluteY, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9A*/ opcode("TXS", Implied, 2, false, 0, 0, M6502_X, M6502_S, AccessNone),
+    /*9B*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*9C*/ opcode("STZ", Absolute, 4, false, 0, 0, 0, 0, AccessWrite),
+    /*9D*/ opcode("STA", AbsoluteX, 5, false, 0, 0, M6502_A, 0, AccessWrite),
+    /*9E*/ opcode("STZ", AbsoluteX, 5, false, 0, 0, 0, 0, AccessWrite),
+    /*9F*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*A0*/ opcode("LDY", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessNone),
+    /*A1*/ opcode("LDA", IndirectX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A2*/ opcode("LDX", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessNone),
+    /*A3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*A4*/ opcode("LDY", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*A5*/ opcode("LDA", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*A6*/ opcode("LDX", ZeroPage, 3, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*A7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*A8*/ opcode("TAY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_Y, AccessNone),
+    /*A9*/ opcode("LDA", Immediate, 2, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessNone),
+    /*AA*/ opcode("TAX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_A, M6502_X, AccessNone),
+    /*AB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*AC*/ opcode("LDY", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*AD*/ opcode("LDA", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*AE*/ opcode("LDX", Absolute, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*AF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*B0*/ opcode("BCS", Relative, 2, true, M6502_CARRY, 0, 0, 0, AccessNone, FlowBranch),
+    /*B1*/ opcode("LDA", IndirectY, 5, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B2*/ opcode("LDA", ZeroPageIndirect, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*B4*/ opcode("LDY", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*B5*/ opcode("LDA", ZeroPageX, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*B6*/ opcode("LDX", ZeroPageY, 4, false, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*B7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*B8*/ opcode("CLV", Implied, 2, false, 0, M6502_OVERFLOW, 0, 0, AccessNone),
+    /*B9*/ opcode("LDA", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BA*/ opcode("TSX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_X, AccessNone),
+    /*BB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*BC*/ opcode("LDY", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_Y, AccessRead),
+    /*BD*/ opcode("LDA", AbsoluteX, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_A, AccessRead),
+    /*BE*/ opcode("LDX", AbsoluteY, 4, true, 0, M6502_ZERO | M6502_SIGN, 0, M6502_X, AccessRead),
+    /*BF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*C0*/ opcode("CPY", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessNone),
+    /*C1*/ opcode("CMP", IndirectX, 6, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C2*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*C3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*C4*/ opcode("CPY", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*C5*/ opcode("CMP", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*C6*/ opcode("DEC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*C7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*C8*/ opcode("INY", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_Y, M6502_Y, AccessNone),
+    /*C9*/ opcode("CMP", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessNone),
+    /*CA*/ opcode("DEX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*CB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*CC*/ opcode("CPY", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_Y, 0, AccessRead),
+    /*CD*/ opcode("CMP", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*CE*/ opcode("DEC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*CF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*D0*/ opcode("BNE", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*D1*/ opcode("CMP", IndirectY, 5, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D2*/ opcode("CMP", ZeroPageIndirect, 5, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*D4*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*D5*/ opcode("CMP", ZeroPageX, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*D6*/ opcode("DEC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*D7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*D8*/ opcode("CLD", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*D9*/ opcode("CMP", AbsoluteY, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DA*/ opcode("PHX", Implied, 3, false, 0, 0, M6502_X | M6502_S, M6502_S, AccessWrite | AccessStack),
+    /*DB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*DC*/ opcode("NOP", Absolute, 4, false, 0, 0, 0, 0, AccessRead),
+    /*DD*/ opcode("CMP", AbsoluteX, 4, true, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_A, 0, AccessRead),
+    /*DE*/ opcode("DEC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*DF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*E0*/ opcode("CPX", Immediate, 2, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessNone),
+    /*E1*/ opcode("SBC", IndirectX, 6, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E2*/ opcode("NOP", Immediate, 2, false, 0, 0, 0, 0, AccessNone),
+    /*E3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*E4*/ opcode("CPX", ZeroPage, 3, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*E5*/ opcode("SBC", ZeroPage, 3, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*E6*/ opcode("INC", ZeroPage, 5, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*E7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*E8*/ opcode("INX", Implied, 2, false, 0, M6502_ZERO | M6502_SIGN, M6502_X, M6502_X, AccessNone),
+    /*E9*/ opcode("SBC", Immediate, 2, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessNone),
+    /*EA*/ opcode("NOP", Implied, 2, false, 0, 0, 0, 0, AccessNone),
+    /*EB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*EC*/ opcode("CPX", Absolute, 4, false, 0, M6502_CARRY | M6502_ZERO | M6502_SIGN, M6502_X, 0, AccessRead),
+    /*ED*/ opcode("SBC", Absolute, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*EE*/ opcode("INC", Absolute, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*EF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*F0*/ opcode("BEQ", Relative, 2, true, M6502_ZERO, 0, 0, 0, AccessNone, FlowBranch),
+    /*F1*/ opcode("SBC", IndirectY, 5, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F2*/ opcode("SBC", ZeroPageIndirect, 5, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F3*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*F4*/ opcode("NOP", ZeroPageX, 4, false, 0, 0, 0, 0, AccessRead),
+    /*F5*/ opcode("SBC", ZeroPageX, 4, false, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*F6*/ opcode("INC", ZeroPageX, 6, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*F7*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*F8*/ opcode("SED", Implied, 2, false, 0, M6502_DECIMAL, 0, 0, AccessNone),
+    /*F9*/ opcode("SBC", AbsoluteY, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FA*/ opcode("PLX", Implied, 4, false, 0, M6502_ZERO | M6502_SIGN, M6502_S, M6502_X | M6502_S, AccessRead | AccessStack),
+    /*FB*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+    /*FC*/ opcode("NOP", Absolute, 4, false, 0, 0, 0, 0, AccessRead),
+    /*FD*/ opcode("SBC", AbsoluteX, 4, true, M6502_CARRY | M6502_DECIMAL, M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN, M6502_A, M6502_A, AccessRead),
+    /*FE*/ opcode("INC", AbsoluteX, 7, false, 0, M6502_ZERO | M6502_SIGN, 0, 0, AccessRead | AccessWrite),
+    /*FF*/ opcode("NOP", Implied, 1, false, 0, 0, 0, 0, AccessNone),
+};
+
+static_assert(OPCODES[0xB1].length == 2 && OPCODES[0xB1].registersRead == M6502_Y && OPCODES[0xB1].pageCrossPenalty, "LDA (zp),Y");
+static_assert(OPCODES[0x9D].cycles == 5 && !OPCODES[0x9D].pageCrossPenalty, "Indexed stores always take the extra cycle");
+static_assert(OPCODES[0x6C].flow == FlowJumpIndirect && OPCODES[0x6C].length == 3, "JMP (abs)");
+static_assert(OPCODES_UNDOCUMENTED[0xB3].registersWritten == (M6502_A | M6502_X) && OPCODES_UNDOCUMENTED[0xB3].pageCrossPenalty, "LAX (zp),Y");
+static_assert(OPCODES_65C02[0x7C].length == 3 && OPCODES_65C02[0x7C].registersRead == M6502_X, "JMP (abs,X)");
+static_assert(OPCODES_65C02[0x03].length == 1 && OPCODES_65C02[0x03].cycles == 1, "The 65C02's unused opcodes are one cycle NOPs");
+
+constexpr auto opcodeTable(CpuModel model)->const OpcodeInfo *
+{
+    return
+        model == CPU_NMOS_UNDOCUMENTED ? OPCODES_UNDOCUMENTED :
+        model == CPU_65C02 ? OPCODES_65C02 :
+        OPCODES;
+}
+
+// The instruction at pc as assembly source, such as "LDA $1234,X"; bytes are
+// the instruction's, at least as many as its length
+auto disassemble(TargetAddress pc, const uint8_t *bytes, CpuModel model = CPU_NMOS)->std::string;
@@ -0,0 +1,212 @@
+#include "stdafx.h"
+
+#include "exceptions.h"
+#include "perfmap.h"
+
+#include <sstream>
+#include <string.h>
+
+#ifdef __linux__
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using std::lock_guard;
+using std::mutex;
+using std::string;
+using std::unique_ptr;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    // Record layouts from tools/perf/Documentation/jitdump-specification.txt
+    // in the kernel tree. All fields are in host byte order.
+    struct JitDumpHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t totalSize;
+        uint32_t elfMachine;
+        uint32_t pad;
+        uint32_t pid;
+        uint64_t timestamp;
+        uint64_t flags;
+    };
+
+    struct JitDumpRecordHeader
+    {
+        uint32_t id;
+        uint32_t totalSize;
+        uint64_t timestamp;
+    };
+
+    // Followed by the NUL terminated name, then the code
+    struct JitDumpCodeLoad
+    {
+        JitDumpRecordHeader header;
+        uint32_t pid;
+        uint32_t tid;
+        uint64_t vma;
+        uint64_t codeAddress;
+        uint64_t codeSize;
+        uint64_t codeIndex;
+    };
+
+    enum {
+        JITDUMP_MAGIC = 0x4A695444,
+        JITDUMP_VERSION = 1,
+        JIT_CODE_LOAD = 0,
+        JIT_CODE_CLOSE = 3,
+    };
+
+#ifdef __linux__
+    // perf record -k 1 timestamps samples with the monotonic clock
+    auto timestamp()->uint64_t
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+#endif
+}
+
+unique_ptr<PerfMap> PerfMap::active_;
+
+PerfMap::PerfMap(unsigned formats, const string &directory)
+    : map_(nullptr)
+    , dumpFile_(-1)
+    , dumpMarker_(nullptr)
+    , codeIndex_(0)
+{
+#ifdef __linux__
+    if ((formats & MapFormat) != 0) {
+        openMap();
+    }
+    if ((formats & JitDumpFormat) != 0) {
+        openJitDump(directory);
+    }
+#else
+    oss() << "Perf maps are only supported on Linux." << throwError;
+#endif
+}
+
+PerfMap::~PerfMap()
+{
+#ifdef __linux__
+    if (map_ != nullptr) {
+        fclose(map_);
+    }
+
+    if (dumpFile_ != -1) {
+        // Best effort; perf reads a dump without the closing record just as well
+        auto close = JitDumpRecordHeader{ JIT_CODE_CLOSE, sizeof(JitDumpRecordHeader), timestamp() };
+        auto written = write(dumpFile_, &close, sizeof(close));
+        static_cast<void>(written);
+        munmap(dumpMarker_, sysconf(_SC_PAGESIZE));
+        ::close(dumpFile_);
+    }
+#endif
+}
+
+auto PerfMap::enable(unsigned formats, const string &directory)->void
+{
+    active_.reset(new PerfMap(formats, directory));
+}
+
+auto PerfMap::active()->PerfMap *
+{
+    return active_.get();
+}
+
+auto PerfMap::record(const void *code, size_t size, const char *name)->void
+{
+#ifdef __linux__
+    lock_guard<mutex> lock(lock_);
+    auto address = reinterpret_cast<uintptr_t>(code);
+
+    if (map_ != nullptr) {
+        fprintf(map_, "%llx %llx %s\n", static_cast<unsigned long long>(address), static_cast<unsigned long long>(size), name);
+        fflush(map_);
+    }
+
+    if (dumpFile_ != -1) {
+        auto nameSize = strlen(name) + 1;
+        auto load = JitDumpCodeLoad{};
+        load.header.id = JIT_CODE_LOAD;
+        load.header.totalSize = static_cast<uint32_t>(sizeof(load) + nameSize + size);
+        load.header.timestamp = timestamp();
+        load.pid = static_cast<uint32_t>(getpid());
+        load.tid = static_cast<uint32_t>(syscall(SYS_gettid));
+        load.vma = address;
+        load.codeAddress = address;
+        load.codeSize = size;
+        load.codeIndex = codeIndex_++;
+
+        writeJitDump(&load, sizeof(load));
+        writeJitDump(name, nameSize);
+        writeJitDump(code, size);
+    }
+#endif
+}
+
+#ifdef __linux__
+
+auto PerfMap::openMap()->void
+{
+    auto path = oss{};
+    path << "/tmp/perf-" << getpid() << ".map";
+
+    map_ = fopen(path.str().c_str(), "w");
+    if (map_ == nullptr) {
+        oss() << "Could not create " << path.str() << "." << throwError;
+    }
+}
+
+auto PerfMap::openJitDump(const string &directory)->void
+{
+    auto path = oss{};
+    path << directory << "/jit-" << getpid() << ".dump";
+
+    dumpFile_ = open(path.str().c_str(), O_CREAT | O_TRUNC | O_RDWR, 0666);
+    if (dumpFile_ == -1) {
+        oss() << "Could not create " << path.str() << "." << throwError;
+    }
+
+    // perf finds the dump through this executable mapping of it, which shows
+    // up as an mmap event in the recording.
+    dumpMarker_ = mmap(nullptr, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, dumpFile_, 0);
+    if (dumpMarker_ == MAP_FAILED) {
+        ::close(dumpFile_);
+        dumpFile_ = -1;
+        oss() << "Could not map " << path.str() << "." << throwError;
+    }
+
+    auto header = JitDumpHeader{};
+    header.magic = JITDUMP_MAGIC;
+    header.version = JITDUMP_VERSION;
+    header.totalSize = sizeof(header);
+    header.elfMachine = sizeof(void *) == 8 ? EM_X86_64 : EM_386;
+    header.pid = static_cast<uint32_t>(getpid());
+    header.timestamp = timestamp();
+    writeJitDump(&header, sizeof(header));
+}
+
+auto PerfMap::writeJitDump(const void *data, size_t size)->void
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+        auto written = write(dumpFile_, bytes, size);
+        if (written <= 0) {
+            oss() << "Could not write jitdump record." << throwError;
+        }
+        bytes += written;
+        size -= written;
+    }
+}
+
+#endif
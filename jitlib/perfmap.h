@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <memory>
+#include <mutex>
+#include <string>
+
+//
+// PerfMap tells the Linux perf tools what the generated code is. Once enabled,
+// every fragment JitVM finishes is listed by name in /tmp/perf-<pid>.map, which
+// perf report reads to symbolise addresses in anonymous memory. It can also
+// write the fragments, code included, to jit-<pid>.dump in the jitdump format:
+//
+//     perf record -k 1 jitrun ...
+//     perf inject --jit -i perf.data -o perf.jit.data
+//     perf report -i perf.jit.data
+//
+// Both files are named by pid, so recording is process wide. It is off unless
+// enabled, and then costs each finished fragment one test.
+//
+class PerfMap
+{
+public:
+    enum Format {
+        MapFormat = 0x01,
+        JitDumpFormat = 0x02,
+    };
+
+    ~PerfMap();
+
+    PerfMap(const PerfMap &) = delete;
+    auto operator=(const PerfMap &)->PerfMap & = delete;
+
+    // Starts recording in the given formats. The jitdump file is created in
+    // directory. Call before any code is generated.
+    static auto enable(unsigned formats, const std::string &directory = ".")->void;
+
+    // The map code is being recorded to, or null if recording is off
+    static auto active()->PerfMap *;
+
+    auto record(const void *code, size_t size, const char *name)->void;
+
+private:
+    PerfMap(unsigned formats, const std::string &directory);
+
+    auto openMap()->void;
+    auto openJitDump(const std::string &directory)->void;
+    auto writeJitDump(const void *data, size_t size)->void;
+
+    static std::unique_ptr<PerfMap> active_;
+
+    std::mutex lock_;
+    FILE *map_;
+    int dumpFile_;
+    void *dumpMarker_;
+    uint64_t codeIndex_;
+};
@@ -0,0 +1,333 @@
+#include "stdafx.h"
+
+#include "savestate.h"
+
+#include "exceptions.h"
+#include "systemmemory.h"
+
+#include <algorithm>
+#include <sstream>
+
+using std::equal;
+using std::ios_base;
+using std::string;
+using std::vector;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    const char MAGIC[4] = { 'J', '6', 'S', 'S' };
+    const size_t FILE_HEADER_SIZE = 16;
+    const size_t SECTION_HEADER_SIZE = 16;
+    const size_t SECTION_ALIGNMENT = 8;
+
+    auto get16(const uint8_t *p)->uint16_t
+    {
+        return p[0] | (p[1] << 8);
+    }
+
+    auto get32(const uint8_t *p)->uint32_t
+    {
+        return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+    }
+
+    auto get64(const uint8_t *p)->uint64_t
+    {
+        return get32(p) | (static_cast<uint64_t>(get32(p + 4)) << 32);
+    }
+
+    auto sectionName(uint32_t id)->string
+    {
+        auto name = string{};
+        for (auto i = 0; i < 4; i++) {
+            name += static_cast<char>((id >> (8 * i)) & 0xFF);
+        }
+        return name;
+    }
+}
+
+SaveStateWriter::SaveStateWriter(const string &path)
+    : path_(path)
+    , stm_(path, ios_base::out | ios_base::binary | ios_base::trunc)
+    , sectionStart_(0)
+    , inSection_(false)
+{
+    if (!stm_) {
+        oss() << "Could not create save state " << path << throwError;
+    }
+
+    write(MAGIC, sizeof(MAGIC));
+    write16(VERSION);
+    write16(FILE_HEADER_SIZE);
+    write64(0);
+}
+
+SaveStateWriter::~SaveStateWriter()
+{
+    if (stm_.is_open()) {
+        stm_.close();
+    }
+}
+
+auto SaveStateWriter::beginSection(uint32_t id, uint16_t version)->void
+{
+    assert(!inSection_);
+
+    sectionStart_ = offset();
+    inSection_ = true;
+
+    write32(id);
+    write16(version);
+    write16(0);
+
+    // size is patched by endSection
+    write64(0);
+}
+
+auto SaveStateWriter::endSection()->void
+{
+    assert(inSection_);
+
+    auto end = offset();
+    auto size = end - sectionStart_ - SECTION_HEADER_SIZE;
+
+    stm_.seekp(sectionStart_ + 8);
+    write64(size);
+    stm_.seekp(end);
+
+    alignTo(SECTION_ALIGNMENT);
+    inSection_ = false;
+}
+
+auto SaveStateWriter::close()->void
+{
+    assert(!inSection_);
+
+    stm_.close();
+    if (stm_.fail()) {
+        oss() << "Failed writing save state " << path_ << throwError;
+    }
+}
+
+auto SaveStateWriter::write(const void *data, size_t size)->void
+{
+    stm_.write(static_cast<const char *>(data), size);
+    if (!stm_) {
+        oss() << "Failed writing save state " << path_ << throwError;
+    }
+}
+
+auto SaveStateWriter::write8(uint8_t value)->void
+{
+    write(&value, 1);
+}
+
+auto SaveStateWriter::write16(uint16_t value)->void
+{
+    write8(value & 0xFF);
+    write8(value >> 8);
+}
+
+auto SaveStateWriter::write32(uint32_t value)->void
+{
+    write16(value & 0xFFFF);
+    write16(value >> 16);
+}
+
+auto SaveStateWriter::write64(uint64_t value)->void
+{
+    write32(value & 0xFFFFFFFF);
+    write32(value >> 32);
+}
+
+auto SaveStateWriter::alignTo(size_t alignment)->void
+{
+    static const uint8_t zeros[16] = {};
+
+    auto pad = (alignment - offset() % alignment) % alignment;
+    while (pad != 0) {
+        auto chunk = pad < sizeof(zeros) ? pad : sizeof(zeros);
+        write(zeros, chunk);
+        pad -= chunk;
+    }
+}
+
+auto SaveStateWriter::offset()->uint64_t
+{
+    return static_cast<uint64_t>(stm_.tellp());
+}
+
+SaveStateReader::SaveStateReader(const string &path)
+    : file_(path)
+    , version_(0)
+{
+    auto base = file_.data();
+    auto size = file_.size();
+
+    if (size < FILE_HEADER_SIZE || !equal(MAGIC, MAGIC + sizeof(MAGIC), base)) {
+        oss() << path << " is not a save state." << throwError;
+    }
+
+    version_ = get16(base + 4);
+    if (version_ > SaveStateWriter::VERSION) {
+        oss() << path << " is save state version " << version_ << ", which is newer than this build supports." << throwError;
+    }
+
+    // Only the section headers are touched here, so finding a section costs
+    // the same no matter how much payload the file carries.
+    size_t next = get16(base + 6);
+    while (next < size) {
+        if (size - next < SECTION_HEADER_SIZE) {
+            oss() << path << " has a truncated section header." << throwError;
+        }
+
+        auto header = base + next;
+        auto section = Section{};
+        section.id = get32(header);
+        section.version = get16(header + 4);
+        section.data = header + SECTION_HEADER_SIZE;
+
+        auto payloadSize = get64(header + 8);
+        if (payloadSize > size - next - SECTION_HEADER_SIZE) {
+            oss() << path << " section '" << sectionName(section.id) << "' runs off end of file." << throwError;
+        }
+        section.size = static_cast<size_t>(payloadSize);
+        sections_.push_back(section);
+
+        next += SECTION_HEADER_SIZE + section.size;
+        next += (SECTION_ALIGNMENT - next % SECTION_ALIGNMENT) % SECTION_ALIGNMENT;
+    }
+}
+
+auto SaveStateReader::version() const->uint16_t
+{
+    return version_;
+}
+
+auto SaveStateReader::sections() const->const vector<Section> &
+{
+    return sections_;
+}
+
+auto SaveStateReader::findSection(uint32_t id, size_t index) const->const Section *
+{
+    for (const auto &section : sections_) {
+        if (section.id == id) {
+            if (index == 0) {
+                return &section;
+            }
+            index--;
+        }
+    }
+    return nullptr;
+}
+
+auto SaveStateReader::fileOffsetOf(const uint8_t *p) const->size_t
+{
+    return p - file_.data();
+}
+
+SectionReader::SectionReader(const SaveStateReader::Section &section)
+    : section_(section)
+    , offset_(0)
+{
+}
+
+auto SectionReader::read8()->uint8_t
+{
+    return *bytes(1);
+}
+
+auto SectionReader::read16()->uint16_t
+{
+    return get16(bytes(2));
+}
+
+auto SectionReader::read32()->uint32_t
+{
+    return get32(bytes(4));
+}
+
+auto SectionReader::read64()->uint64_t
+{
+    return get64(bytes(8));
+}
+
+auto SectionReader::bytes(size_t size)->const uint8_t *
+{
+    if (size > remaining()) {
+        oss()
+            << "Save state section '"
+            << sectionName(section_.id)
+            << "' is truncated."
+            << throwError;
+    }
+
+    auto p = section_.data + offset_;
+    offset_ += size;
+    return p;
+}
+
+auto SectionReader::seek(size_t offset)->void
+{
+    if (offset > section_.size) {
+        oss()
+            << "Save state section '"
+            << sectionName(section_.id)
+            << "' is truncated."
+            << throwError;
+    }
+    offset_ = offset;
+}
+
+auto SectionReader::remaining() const->size_t
+{
+    return section_.size - offset_;
+}
+
+auto saveMachineState(const string &path, const CpuState &cpu, const SystemMemory &memory)->void
+{
+    SaveStateWriter writer(path);
+
+    writer.beginSection(CpuSectionId, 1);
+    writer.write8(cpu.a);
+    writer.write8(cpu.x);
+    writer.write8(cpu.y);
+    writer.write8(cpu.s);
+    writer.write8(cpu.p);
+    writer.write8(0);
+    writer.write16(cpu.pc);
+    writer.write64(cpu.cycles);
+    writer.endSection();
+
+    memory.saveState(&writer);
+
+    writer.close();
+}
+
+auto loadMachineState(const string &path, CpuState *cpu, SystemMemory *memory)->void
+{
+    SaveStateReader reader(path);
+
+    auto section = reader.findSection(CpuSectionId);
+    if (section == nullptr) {
+        oss() << path << " has no CPU state." << throwError;
+    }
+
+    auto cpuReader = SectionReader{ *section };
+    auto restored = CpuState{};
+    restored.a = cpuReader.read8();
+    restored.x = cpuReader.read8();
+    restored.y = cpuReader.read8();
+    restored.s = cpuReader.read8();
+    restored.p = cpuReader.read8();
+    cpuReader.read8();
+    restored.pc = cpuReader.read16();
+    restored.cycles = cpuReader.read64();
+
+    // Memory validates the layout before changing anything, so a failed
+    // restore leaves the machine as it was.
+    memory->restoreState(reader);
+    *cpu = restored;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cpustate.h"
+#include "mappedfile.h"
+
+class SystemMemory;
+
+//
+// A save state file is a small header followed by a stream of sections. Every
+// section carries its own id, version and payload size, so readers skip any
+// section they don't understand and newer writers can add sections without
+// breaking older readers. All multi-byte values are little-endian.
+//
+// Restores map the file rather than reading it and walk the section headers;
+// the payload of a section a reader skips is never touched. What it restores,
+// RAM included, is copied out in full. Large pieces of payload (RAM) are
+// aligned to host pages in the file, so a reader could map them in place.
+//
+constexpr auto saveStateId(char a, char b, char c, char d)->uint32_t
+{
+    return static_cast<uint32_t>(static_cast<uint8_t>(a))
+        | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+}
+
+enum SaveStateSectionId : uint32_t
+{
+    CpuSectionId = saveStateId('C', 'P', 'U', ' '),
+    MemoryMapSectionId = saveStateId('M', 'M', 'A', 'P'),
+    RAMSectionId = saveStateId('R', 'A', 'M', ' '),
+    DeviceSectionId = saveStateId('D', 'E', 'V', ' '),
+    BankSectionId = saveStateId('B', 'A', 'N', 'K'),
+};
+
+class SaveStateWriter
+{
+public:
+    enum { VERSION = 1 };
+
+    SaveStateWriter(const std::string &path);
+    ~SaveStateWriter();
+
+    auto beginSection(uint32_t id, uint16_t version)->void;
+    auto endSection()->void;
+    auto close()->void;
+
+    auto write(const void *data, size_t size)->void;
+    auto write8(uint8_t value)->void;
+    auto write16(uint16_t value)->void;
+    auto write32(uint32_t value)->void;
+    auto write64(uint64_t value)->void;
+
+    // Pad with zeros until the file offset is a multiple of alignment
+    auto alignTo(size_t alignment)->void;
+    auto offset()->uint64_t;
+
+private:
+    std::string path_;
+    std::ofstream stm_;
+    uint64_t sectionStart_;
+    bool inSection_;
+};
+
+class SaveStateReader
+{
+public:
+    struct Section
+    {
+        uint32_t id;
+        uint16_t version;
+        const uint8_t *data;
+        size_t size;
+    };
+
+    SaveStateReader(const std::string &path);
+
+    auto version() const->uint16_t;
+    auto sections() const->const std::vector<Section> &;
+    auto findSection(uint32_t id, size_t index = 0) const->const Section *;
+    auto fileOffsetOf(const uint8_t *p) const->size_t;
+
+private:
+    MappedFile file_;
+    uint16_t version_;
+    std::vector<Section> sections_;
+};
+
+//
+// SectionReader walks a section's payload, throwing if the payload is shorter
+// than the reader expects.
+//
+class SectionReader
+{
+public:
+    SectionReader(const SaveStateReader::Section &section);
+
+    auto read8()->uint8_t;
+    auto read16()->uint16_t;
+    auto read32()->uint32_t;
+    auto read64()->uint64_t;
+    auto bytes(size_t size)->const uint8_t *;
+    auto seek(size_t offset)->void;
+    auto remaining() const->size_t;
+
+private:
+    const SaveStateReader::Section &section_;
+    size_t offset_;
+};
+
+auto saveMachineState(const std::string &path, const CpuState &cpu, const SystemMemory &memory)->void;
+auto loadMachineState(const std::string &path, CpuState *cpu, SystemMemory *memory)->void;
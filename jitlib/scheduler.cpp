@@ -0,0 +1,84 @@
+#include "stdafx.h"
+
+#include "scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+using std::any_of;
+using std::move;
+using std::pop_heap;
+using std::push_heap;
+
+Scheduler::Scheduler(Clock clock)
+    : clock_(move(clock))
+    , nextId_(0)
+{
+}
+
+auto Scheduler::now() const->uint64_t
+{
+    return clock_();
+}
+
+auto Scheduler::schedule(uint64_t due, Callback callback)->EventId
+{
+    auto id = nextId_++;
+    events_.push_back(Event{ due, id, move(callback) });
+    push_heap(begin(events_), end(events_), later);
+    return id;
+}
+
+// Cancelled events stay in the heap until they reach the front. Ids of events
+// which have already fired or been cancelled are ignored.
+//
+auto Scheduler::cancel(EventId id)->void
+{
+    auto pending = any_of(begin(events_), end(events_), [id](const Event &event) {
+        return event.id == id;
+    });
+    if (pending) {
+        cancelled_.insert(id);
+    }
+}
+
+auto Scheduler::nextDeadline()->uint64_t
+{
+    discardCancelled();
+    return events_.empty() ? UINT64_MAX : events_.front().due;
+}
+
+auto Scheduler::runDue()->void
+{
+    while (nextDeadline() <= now()) {
+        pop_heap(begin(events_), end(events_), later);
+        auto event = move(events_.back());
+        events_.pop_back();
+
+        event.callback(event.due);
+    }
+}
+
+auto Scheduler::pending() const->size_t
+{
+    return events_.size() - cancelled_.size();
+}
+
+auto Scheduler::later(const Event &a, const Event &b)->bool
+{
+    return a.due != b.due ? a.due > b.due : a.id > b.id;
+}
+
+auto Scheduler::discardCancelled()->void
+{
+    while (!events_.empty() && !cancelled_.empty()) {
+        auto cancelled = cancelled_.find(events_.front().id);
+        if (cancelled == end(cancelled_)) {
+            break;
+        }
+
+        cancelled_.erase(cancelled);
+        pop_heap(begin(events_), end(events_), later);
+        events_.pop_back();
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+//
+// Scheduler keeps the guest's timed events, such as a timer running out or a
+// frame ending, in a min-heap ordered by the guest cycle they are due at.
+// Devices are not ticked: translated code runs freely until the earliest
+// deadline, and the dispatcher fires whatever has fallen due between blocks.
+//
+// Devices with state that changes over time bring it up to date lazily, when
+// the guest touches one of their registers or an event of theirs fires, by
+// asking now() for the current cycle. The clock is exact whenever a device is
+// called, even from the middle of a block, so the catch-up is exact too.
+//
+class Scheduler
+{
+public:
+    using EventId = uint64_t;
+
+    // Called with the cycle the event was due at; the guest may have run a
+    // few cycles past it, to the end of the block that crossed it.
+    using Callback = std::function<void(uint64_t due)>;
+
+    // The guest cycle count events are scheduled against
+    using Clock = std::function<uint64_t()>;
+
+    Scheduler(Clock clock);
+
+    auto now() const->uint64_t;
+
+    auto schedule(uint64_t due, Callback callback)->EventId;
+    auto cancel(EventId id)->void;
+
+    // The cycle the earliest pending event is due at, or UINT64_MAX
+    auto nextDeadline()->uint64_t;
+
+    // Fires, in order, every event due at or before now(). Events scheduled
+    // by the callbacks fire too if they are already due.
+    auto runDue()->void;
+
+    auto pending() const->size_t;
+
+private:
+    struct Event
+    {
+        uint64_t due;
+
+        // Orders events due on the same cycle by when they were scheduled
+        EventId id;
+        Callback callback;
+    };
+
+    // Heap comparison; the earliest event is at the front
+    static auto later(const Event &a, const Event &b)->bool;
+
+    // Drops cancelled events from the front of the heap
+    auto discardCancelled()->void;
+
+    Clock clock_;
+    std::vector<Event> events_;
+    std::unordered_set<EventId> cancelled_;
+    EventId nextId_;
+};
@@ -5,10 +5,12 @@
 
 #pragma once
 
+#ifdef _WIN32
 #include "targetver.h"
 
 #define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
 #include <windows.h>
+#endif
 
 // C RunTime Header Files
 #include <assert.h>
@@ -16,7 +18,9 @@
 #include <stdlib.h>
 #include <malloc.h>
 #include <memory.h>
+#ifdef _WIN32
 #include <tchar.h>
+#endif
 
 
 #include <algorithm>
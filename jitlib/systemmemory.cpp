@@ -1,6 +1,8 @@
 #include "stdafx.h"
 
 #include "exceptions.h"
+#include "mappedfile.h"
+#include "savestate.h"
 #include "systemmemory.h"
 
 #include <algorithm>
@@ -8,63 +10,193 @@
 #include <iomanip>
 #include <iterator>
 #include <sstream>
+#include <string.h>
 
 using std::begin;
 using std::copy;
 using std::end;
-using std::fill;
 using std::find_if;
 using std::hex;
+using std::min;
+using std::move;
+using std::pair;
 using std::runtime_error;
 using std::setfill;
 using std::setw;
+using std::sort;
 using std::string;
+using std::vector;
 
 using oss = std::ostringstream;
 
+namespace
+{
+    // Saved RAM is aligned to host pages in the file so it can be mapped directly
+    const size_t HOST_PAGE_SIZE = 4096;
+
+    // Bindings for devices installed through the IOHandler interface
+    auto readHandler(void *device, TargetAddress addr)->uint8_t
+    {
+        return static_cast<SystemMemory::IOHandler *>(device)->read(addr);
+    }
+
+    auto writeHandler(void *device, TargetAddress addr, uint8_t data)->void
+    {
+        static_cast<SystemMemory::IOHandler *>(device)->write(addr, data);
+    }
+}
+
 SystemMemory::IOHandler::~IOHandler()
 {
 }
 
+auto SystemMemory::IOHandler::saveState(vector<uint8_t> *blob) const->void
+{
+}
+
+auto SystemMemory::IOHandler::restoreState(const uint8_t *blob, size_t size)->void
+{
+}
+
 SystemMemory::SystemMemory()
-    : romHandler_(memory_)
+    : memory_()
+    , romHandler_(memory_)
     , ramHandler_(memory_)
+    , romBinding_{ &readDevice<ROMHandler>, &writeDevice<ROMHandler>, &romHandler_, nullptr }
+    , ramBinding_{ &readDevice<RAMHandler>, &writeDevice<RAMHandler>, &ramHandler_, nullptr }
+{
+    std::fill(begin(pageFlags_), end(pageFlags_), EmptyFlag);
+    std::fill(begin(pages_), end(pages_), PageDescriptor{ nullptr, nullptr, nullptr });
+    std::fill(begin(mappedPages_), end(mappedPages_), nullptr);
+    std::fill(begin(pageBanks_), end(pageBanks_), NO_BANK);
+}
+
+SystemMemory::~SystemMemory()
 {
-    fill(begin(pageFlags_), end(pageFlags_), EmptyFlag);
 }
 
 auto SystemMemory::installROM(TargetAddress baseAddress, const std::vector<uint8_t> &contents)->void
 {
-    installRange(baseAddress, contents.size(), ROM, &romHandler_);
+    installRange(baseAddress, contents.size(), ROM, &romBinding_);
     copy(begin(contents), end(contents), begin(memory_) + baseAddress);
 }
 
+auto SystemMemory::installROMFile(const string &path, TargetAddress baseAddress, size_t offset, size_t length)->void
+{
+    auto contents = mapROMFile(path, offset, &length);
+    installRange(baseAddress, length, ROM, &romBinding_);
+
+    for (auto done = size_t{ 0 }; done < length; ) {
+        auto address = static_cast<TargetAddress>(baseAddress + done);
+        auto page = pageOf(address);
+        auto run = min(length - done, static_cast<size_t>(PAGE_SIZE - pageOffsetOf(address)));
+
+        // A page left plain by installRange is all this ROM
+        if (pageFlags_[page] == ReadableFlag) {
+            mappedPages_[page] = const_cast<uint8_t *>(contents + done);
+            updateDescriptor(page);
+        }
+        else {
+            copy(contents + done, contents + done + run, begin(memory_) + address);
+        }
+
+        done += run;
+    }
+}
+
 auto SystemMemory::installRAM(TargetAddress baseAddress, TargetAddressSize length)->void
 {
-    installRange(baseAddress, length, ROM, &ramHandler_);
+    installRange(baseAddress, length, RAM, &ramBinding_);
 }
 
 auto SystemMemory::installIO(TargetAddress baseAddress, TargetAddressSize length, IOHandler *handler)->void
 {
-    installRange(baseAddress, length, IO, handler);
+    installDevice(baseAddress, length, DeviceBinding{ readHandler, writeHandler, handler, handler });
+}
+
+auto SystemMemory::installBankWindow(TargetAddress baseAddress, TargetAddressSize length)->BankWindow
+{
+    if (pageOffsetOf(baseAddress) != 0 || length % PAGE_SIZE != 0) {
+        oss()
+            << "Bank window at address "
+            << setw(4) << hex << setfill('0') << baseAddress
+            << " must be whole pages."
+            << throwError;
+    }
+
+    installRange(baseAddress, length, Banked, nullptr);
+    windows_.push_back(Window{ baseAddress, length, NO_BANK });
+    return static_cast<BankWindow>(windows_.size() - 1);
+}
+
+auto SystemMemory::addROMBank(BankWindow window, const vector<uint8_t> &contents)->BankId
+{
+    if (contents.size() != windowAt(window).length) {
+        oss() << "ROM bank is " << contents.size() << " bytes; window " << window << " is " << windowAt(window).length << "." << throwError;
+    }
+    return addBank(window, ROM, contents, nullptr);
+}
+
+auto SystemMemory::addROMBankFile(BankWindow window, const string &path, size_t offset)->BankId
+{
+    auto length = static_cast<size_t>(windowAt(window).length);
+    return addBank(window, ROM, vector<uint8_t>{}, mapROMFile(path, offset, &length));
+}
+
+auto SystemMemory::addRAMBank(BankWindow window)->BankId
+{
+    return addBank(window, RAM, vector<uint8_t>(windowAt(window).length), nullptr);
+}
+
+auto SystemMemory::selectBank(BankWindow window, BankId bank)->void
+{
+    if (window >= windows_.size() || bank == NO_BANK || bank > banks_.size() || banks_[bank - 1].window != window) {
+        oss() << "Bank " << bank << " is not a bank of window " << window << "." << throwError;
+    }
+
+    auto &target = windows_[window];
+    auto &source = banks_[bank - 1];
+    auto flags = static_cast<PageFlags>(BankedFlag | pageTypeToFlags(source.type));
+    auto first = pageOf(target.base);
+    for (auto i = 0u; i < target.length / PAGE_SIZE; i++) {
+        auto page = static_cast<PageIndex>(first + i);
+        pageFlags_[page] = flags;
+        pageBanks_[page] = bank;
+        mappedPages_[page] = source.bytes + i * PAGE_SIZE;
+        updateDescriptor(page);
+    }
+    target.selected = bank;
+}
+
+auto SystemMemory::selectedBank(BankWindow window) const->BankId
+{
+    return windowAt(window).selected;
+}
+
+auto SystemMemory::bankAt(TargetAddress address) const->BankId
+{
+    return pageBanks_[pageOf(address)];
+}
+
+auto SystemMemory::deviceAt(TargetAddress address) const->const DeviceBinding *
+{
+    auto handlers = pages_[pageOf(address)].handlers;
+    return handlers != nullptr ? handlers[pageOffsetOf(address)] : nullptr;
 }
 
 auto SystemMemory::readByte(TargetAddress address)->uint8_t
 {
-    auto page = pageOf(address);
-    auto flags = pageFlags_[page];
+    auto &page = pages_[pageOf(address)];
+    auto offset = pageOffsetOf(address);
 
-    if ((flags & ReadableFlag) != 0) {
-        return memory_[address];
+    if (page.read != nullptr) {
+        return page.read[offset];
     }
 
-    if ((flags & MixedFlag) != 0) {
-        auto handlers = mixedPageHandlerMap_.find(page);
-        if (handlers != end(mixedPageHandlerMap_)) {
-            auto handler = handlers->second[pageOffsetOf(address)];
-            if (handler != nullptr) {
-                return handler->read(address);
-            }
+    if (page.handlers != nullptr) {
+        auto device = page.handlers[offset];
+        if (device != nullptr) {
+            return device->read(device->device, address);
         }
     }
 
@@ -79,12 +211,347 @@ auto SystemMemory::readWord(TargetAddress address)->uint16_t
     return (high << 8) | low;
 }
 
-auto SystemMemory::pageOf(TargetAddress address)->PageIndex
+auto SystemMemory::writeByte(TargetAddress address, uint8_t data)->void
+{
+    auto &page = pages_[pageOf(address)];
+    auto offset = pageOffsetOf(address);
+
+    if (page.write != nullptr) {
+        page.write[offset] = data;
+        return;
+    }
+
+    if (page.handlers != nullptr) {
+        auto device = page.handlers[offset];
+        if (device != nullptr) {
+            device->write(device->device, address, data);
+        }
+    }
+}
+
+auto SystemMemory::writeWord(TargetAddress address, uint16_t data)->void
+{
+    writeByte(address, data & 0xFF);
+    writeByte(address + 1, data >> 8);
+}
+
+auto SystemMemory::readBlock(TargetAddress address, uint8_t *data, size_t length)->void
+{
+    while (length > 0) {
+        auto run = plainRun(address, length, false);
+        if (run > 0) {
+            memcpy(data, pages_[pageOf(address)].read + pageOffsetOf(address), run);
+        }
+        else {
+            run = min(length, static_cast<size_t>(PAGE_SIZE - pageOffsetOf(address)));
+            for (auto i = size_t{ 0 }; i < run; i++) {
+                data[i] = readByte(static_cast<TargetAddress>(address + i));
+            }
+        }
+
+        address = static_cast<TargetAddress>(address + run);
+        data += run;
+        length -= run;
+    }
+}
+
+auto SystemMemory::writeBlock(TargetAddress address, const uint8_t *data, size_t length)->void
+{
+    while (length > 0) {
+        auto run = plainRun(address, length, true);
+        if (run > 0) {
+            memcpy(pages_[pageOf(address)].write + pageOffsetOf(address), data, run);
+        }
+        else {
+            run = min(length, static_cast<size_t>(PAGE_SIZE - pageOffsetOf(address)));
+            for (auto i = size_t{ 0 }; i < run; i++) {
+                writeByte(static_cast<TargetAddress>(address + i), data[i]);
+            }
+        }
+
+        address = static_cast<TargetAddress>(address + run);
+        data += run;
+        length -= run;
+    }
+}
+
+auto SystemMemory::fill(TargetAddress address, uint8_t value, size_t length)->void
+{
+    while (length > 0) {
+        auto run = plainRun(address, length, true);
+        if (run > 0) {
+            memset(pages_[pageOf(address)].write + pageOffsetOf(address), value, run);
+        }
+        else {
+            run = min(length, static_cast<size_t>(PAGE_SIZE - pageOffsetOf(address)));
+            for (auto i = size_t{ 0 }; i < run; i++) {
+                writeByte(static_cast<TargetAddress>(address + i), value);
+            }
+        }
+
+        address = static_cast<TargetAddress>(address + run);
+        length -= run;
+    }
+}
+
+auto SystemMemory::isPlain(TargetAddress address, size_t length, bool writing) const->bool
+{
+    if (length == 0 || length > static_cast<size_t>(SIZE - address)) {
+        return false;
+    }
+
+    auto last = pageOf(static_cast<TargetAddress>(address + length - 1));
+    for (auto page = pageOf(address); page <= last; page++) {
+        if ((writing ? pages_[page].write : pages_[page].read) == nullptr) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto SystemMemory::isROM(TargetAddress address) const->bool
+{
+    return pageFlags_[pageOf(address)] == ReadableFlag;
+}
+
+auto SystemMemory::peekByte(TargetAddress address) const->uint8_t
+{
+    auto read = pages_[pageOf(address)].read;
+    return read != nullptr ? read[pageOffsetOf(address)] : 0xFF;
+}
+
+auto SystemMemory::ioHandlers() const->vector<pair<TargetAddress, IOHandler *>>
+{
+    auto handlers = vector<pair<TargetAddress, IOHandler *>>{};
+
+    for (auto page = 0; page < PAGES; page++) {
+        if (!mixedPageHandlers_[page]) {
+            continue;
+        }
+
+        auto &pageHandlers = *mixedPageHandlers_[page];
+        auto pageBase = static_cast<TargetAddress>(page * PAGE_SIZE);
+        for (auto offset = 0; offset < PAGE_SIZE; offset++) {
+            auto device = pageHandlers[offset];
+            auto handler = device != nullptr ? device->handler : nullptr;
+            if (handler == nullptr) {
+                continue;
+            }
+
+            auto address = static_cast<TargetAddress>(pageBase + offset);
+            auto known = find_if(begin(handlers), end(handlers), [handler](auto &known) {
+                return known.second == handler;
+            });
+
+            if (known == end(handlers)) {
+                handlers.emplace_back(address, handler);
+            }
+            else if (address < known->first) {
+                known->first = address;
+            }
+        }
+    }
+
+    sort(begin(handlers), end(handlers));
+    return handlers;
+}
+
+auto SystemMemory::saveState(SaveStateWriter *writer) const->void
+{
+    writer->beginSection(MemoryMapSectionId, 1);
+    for (auto flags : pageFlags_) {
+        writer->write8(flags);
+    }
+    writer->endSection();
+
+    // Mixed pages are saved whole; only their RAM bytes are restored.
+    auto pages = vector<PageIndex>{};
+    for (auto page = 0; page < PAGES; page++) {
+        if (pageFlags_[page] == ReadWriteableFlag || (pageFlags_[page] & MixedFlag) != 0) {
+            pages.push_back(page);
+        }
+    }
+
+    writer->beginSection(RAMSectionId, 1);
+    auto payloadStart = writer->offset();
+    auto indexEnd = payloadStart + 8 + pages.size();
+    auto dataStart = pages.empty() ? indexEnd : (indexEnd + HOST_PAGE_SIZE - 1) / HOST_PAGE_SIZE * HOST_PAGE_SIZE;
+
+    writer->write32(static_cast<uint32_t>(pages.size()));
+    writer->write32(static_cast<uint32_t>(dataStart - payloadStart));
+    for (auto page : pages) {
+        writer->write8(static_cast<uint8_t>(page));
+    }
+    if (!pages.empty()) {
+        writer->alignTo(HOST_PAGE_SIZE);
+    }
+    for (auto page : pages) {
+        writer->write(&memory_[page * PAGE_SIZE], PAGE_SIZE);
+    }
+    writer->endSection();
+
+    // Which bank each window has switched in, then every RAM bank's bytes
+    if (!windows_.empty()) {
+        writer->beginSection(BankSectionId, 1);
+        writer->write32(static_cast<uint32_t>(windows_.size()));
+        for (auto &window : windows_) {
+            writer->write32(window.selected);
+        }
+        writer->write32(static_cast<uint32_t>(banks_.size()));
+        for (auto &bank : banks_) {
+            if (bank.type == RAM) {
+                writer->write(bank.bytes, windows_[bank.window].length);
+            }
+        }
+        writer->endSection();
+    }
+
+    auto blob = vector<uint8_t>{};
+    for (auto &device : ioHandlers()) {
+        blob.clear();
+        device.second->saveState(&blob);
+
+        writer->beginSection(DeviceSectionId, 1);
+        writer->write16(device.first);
+        writer->write16(0);
+        writer->write32(static_cast<uint32_t>(blob.size()));
+        writer->write(blob.data(), blob.size());
+        writer->endSection();
+    }
+}
+
+auto SystemMemory::restoreState(const SaveStateReader &reader)->void
+{
+    // Validate everything before touching memory or devices.
+    auto mapSection = reader.findSection(MemoryMapSectionId);
+    if (mapSection == nullptr) {
+        oss() << "Save state has no memory map." << throwError;
+    }
+
+    // Bank windows match whichever banks they have switched in
+    auto mapReader = SectionReader{ *mapSection };
+    for (auto page = 0; page < PAGES; page++) {
+        auto flags = mapReader.read8();
+        auto installed = pageFlags_[page];
+        if ((installed & BankedFlag) != 0) {
+            flags &= BankedFlag;
+            installed = BankedFlag;
+        }
+
+        if (flags != installed) {
+            oss()
+                << "Save state memory map does not match installed hardware at page "
+                << setw(2) << hex << setfill('0') << page
+                << "."
+                << throwError;
+        }
+    }
+
+    auto ramPages = vector<pair<PageIndex, const uint8_t *>>{};
+    auto ramSection = reader.findSection(RAMSectionId);
+    if (ramSection != nullptr) {
+        auto ramReader = SectionReader{ *ramSection };
+        auto count = ramReader.read32();
+        auto dataOffset = ramReader.read32();
+        auto indices = ramReader.bytes(count);
+
+        ramReader.seek(dataOffset);
+        for (auto i = 0u; i < count; i++) {
+            ramPages.emplace_back(indices[i], ramReader.bytes(PAGE_SIZE));
+        }
+    }
+
+    auto selections = vector<BankId>{};
+    auto ramBanks = vector<pair<Bank *, const uint8_t *>>{};
+    auto bankSection = reader.findSection(BankSectionId);
+    if (bankSection != nullptr) {
+        auto bankReader = SectionReader{ *bankSection };
+        if (bankReader.read32() != windows_.size()) {
+            oss() << "Save state bank windows do not match installed hardware." << throwError;
+        }
+
+        for (auto window = BankWindow{ 0 }; window < windows_.size(); window++) {
+            auto bank = bankReader.read32();
+            if (bank != NO_BANK && (bank > banks_.size() || banks_[bank - 1].window != window)) {
+                oss() << "Save state selects bank " << bank << ", which window " << window << " does not have." << throwError;
+            }
+            selections.push_back(bank);
+        }
+
+        if (bankReader.read32() != banks_.size()) {
+            oss() << "Save state banks do not match installed hardware." << throwError;
+        }
+        for (auto &bank : banks_) {
+            if (bank.type == RAM) {
+                ramBanks.emplace_back(&bank, bankReader.bytes(windows_[bank.window].length));
+            }
+        }
+    }
+
+    auto devices = ioHandlers();
+    auto blobs = vector<pair<IOHandler *, SaveStateReader::Section>>{};
+    for (auto index = 0; ; index++) {
+        auto devSection = reader.findSection(DeviceSectionId, index);
+        if (devSection == nullptr) {
+            break;
+        }
+
+        auto devReader = SectionReader{ *devSection };
+        auto address = devReader.read16();
+        devReader.read16();
+        auto size = devReader.read32();
+        auto blob = SaveStateReader::Section{ DeviceSectionId, devSection->version, devReader.bytes(size), size };
+
+        // Devices which are no longer installed are ignored
+        auto device = find_if(begin(devices), end(devices), [address](auto &device) {
+            return device.first == address;
+        });
+        if (device != end(devices)) {
+            blobs.emplace_back(device->second, blob);
+        }
+    }
+
+    // Every saved RAM page is copied out now, touching all of its payload. A
+    // guest has 64 KB at most, so that takes microseconds, and RAM stays
+    // ordinary memory rather than pages pointing into the file.
+    for (auto &ramPage : ramPages) {
+        auto page = ramPage.first;
+        auto base = page * PAGE_SIZE;
+
+        if (pageFlags_[page] == ReadWriteableFlag) {
+            memcpy(&memory_[base], ramPage.second, PAGE_SIZE);
+        }
+        else if (mixedPageHandlers_[page]) {
+            auto &pageHandlers = *mixedPageHandlers_[page];
+            for (auto offset = 0; offset < PAGE_SIZE; offset++) {
+                if (pageHandlers[offset] == &ramBinding_) {
+                    memory_[base + offset] = ramPage.second[offset];
+                }
+            }
+        }
+    }
+
+    for (auto &ramBank : ramBanks) {
+        memcpy(ramBank.first->bytes, ramBank.second, windows_[ramBank.first->window].length);
+    }
+
+    for (auto window = BankWindow{ 0 }; window < selections.size(); window++) {
+        if (selections[window] != NO_BANK) {
+            selectBank(window, selections[window]);
+        }
+    }
+
+    for (auto &blob : blobs) {
+        blob.first->restoreState(blob.second.data, blob.second.size);
+    }
+}
+
+auto SystemMemory::pageOf(TargetAddress address) const->PageIndex
 {
     return address / PAGE_SIZE;
 }
 
-auto SystemMemory::pageOffsetOf(TargetAddress address)->PageOffset
+auto SystemMemory::pageOffsetOf(TargetAddress address) const->PageOffset
 {
     return address % PAGE_SIZE;
 }
@@ -104,6 +571,9 @@ auto SystemMemory::pageTypeToFlags(PageType type)->PageFlags
     case IO:
     case Mixed:
         return MixedFlag;
+
+    case Banked:
+        return BankedFlag;
     }
 
     assert(false);
@@ -127,12 +597,15 @@ auto SystemMemory::pageTypeToString(PageType type)->string
 
     case Mixed:
         return "Mixed";
+
+    case Banked:
+        return "Bank window";
     }
 
     return "Unknown";
 }
 
-auto SystemMemory::installRange(TargetAddress baseAddress, size_t length, PageType type, IOHandler *handler)->void
+auto SystemMemory::installRange(TargetAddress baseAddress, size_t length, PageType type, const DeviceBinding *binding)->void
 {
     if (length == 0) {
         oss()
@@ -173,35 +646,39 @@ auto SystemMemory::installRange(TargetAddress baseAddress, size_t length, PageTy
     auto overlaps = false;
 
     while (startPage < endPage && !overlaps) {
-        overlaps = !installPage(startPage, startOffset, PAGE_SIZE, ROM, &romHandler_);
+        overlaps = !installPage(startPage, startOffset, PAGE_SIZE, type, binding);
         startPage++;
         startOffset = 0;
     }
 
     if (!overlaps) {
         assert(startPage == endPage);
-        overlaps = !installPage(startPage, startOffset, endOffset, ROM, &romHandler_);
+        overlaps = !installPage(startPage, startOffset, endOffset, type, binding);
     }
 
     if (overlaps) {
         oss()
-            << "ROM at address "
+            << pageTypeToString(type)
+            << " at address "
             << setw(4) << hex << setfill('0') << baseAddress
             << " overlaps already installed virtual hardware."
             << throwError;
     }
 }
 
-auto SystemMemory::installPage(PageIndex page, PageOffset startOffset, PageOffset endOffset, PageType type, IOHandler *handler)->bool
+auto SystemMemory::installPage(PageIndex page, PageOffset startOffset, PageOffset endOffset, PageType type, const DeviceBinding *binding)->bool
 {
     if (startOffset == endOffset) {
         // empty region
         return true;
     }
 
-    // Best case: the range to install covers the entire page and the page is currently empty.
-    if (startOffset == 0 && endOffset == PAGE_SIZE && pageFlags_[page] == EmptyFlag) {
-        pageFlags_[page] = pageTypeToFlags(type);
+    // Best case: the range to install covers the entire page, the page is currently empty
+    // and it's plain memory. Devices always get a handler table, even for a whole page.
+    auto flags = pageTypeToFlags(type);
+    if (startOffset == 0 && endOffset == PAGE_SIZE && pageFlags_[page] == EmptyFlag && (flags & MixedFlag) == 0) {
+        pageFlags_[page] = flags;
+        updateDescriptor(page);
         return true;
     }
 
@@ -212,8 +689,12 @@ auto SystemMemory::installPage(PageIndex page, PageOffset startOffset, PageOffse
 
     if (!overlaps) {
         pageFlags_[page] = MixedFlag;
+        if (!mixedPageHandlers_[page]) {
+            mixedPageHandlers_[page].reset(new MixedPageHandlers());
+        }
+        updateDescriptor(page);
 
-        auto &pageHandlers = mixedPageHandlerMap_[page];
+        auto &pageHandlers = *mixedPageHandlers_[page];
         auto rangeStart = begin(pageHandlers) + startOffset;
         auto rangeEnd = begin(pageHandlers) + endOffset;
 
@@ -223,7 +704,7 @@ auto SystemMemory::installPage(PageIndex page, PageOffset startOffset, PageOffse
        
         overlaps = usedEntry != begin(pageHandlers) + endOffset;
         if (!overlaps) {
-            fill(rangeStart, rangeEnd, handler);
+            std::fill(rangeStart, rangeEnd, binding);
         }
     }
 
@@ -264,3 +745,91 @@ auto SystemMemory::RAMHandler::write(TargetAddress addr, uint8_t data)->void
     memory_[addr] = data;
 }
 
+auto SystemMemory::installDevice(TargetAddress baseAddress, TargetAddressSize length, const DeviceBinding &binding)->void
+{
+    deviceBindings_.push_back(binding);
+    installRange(baseAddress, length, IO, &deviceBindings_.back());
+}
+
+auto SystemMemory::asHandler(IOHandler *device)->IOHandler *
+{
+    return device;
+}
+
+auto SystemMemory::asHandler(void *device)->IOHandler *
+{
+    return nullptr;
+}
+
+auto SystemMemory::updateDescriptor(PageIndex page)->void
+{
+    auto flags = pageFlags_[page];
+    auto bytes = mappedPages_[page] != nullptr ? mappedPages_[page] : &memory_[page * PAGE_SIZE];
+    auto &descriptor = pages_[page];
+
+    descriptor.read = (flags & ReadableFlag) != 0 ? bytes : nullptr;
+    descriptor.write = (flags & WriteableFlag) != 0 ? bytes : nullptr;
+    descriptor.handlers = mixedPageHandlers_[page] ? mixedPageHandlers_[page]->data() : nullptr;
+}
+
+auto SystemMemory::mapROMFile(const string &path, size_t offset, size_t *length)->const uint8_t *
+{
+    auto file = std::unique_ptr<MappedFile>(new MappedFile(path));
+
+    if (offset > file->size()) {
+        oss() << "ROM offset " << offset << " is past the end of " << path << "." << throwError;
+    }
+
+    if (*length == SIZE_MAX) {
+        *length = file->size() - offset;
+    }
+    else if (*length > file->size() - offset) {
+        oss() << "ROM file " << path << " is too short for " << *length << " bytes from offset " << offset << "." << throwError;
+    }
+
+    auto contents = file->data() + offset;
+    romFiles_.push_back(move(file));
+    return contents;
+}
+
+auto SystemMemory::windowAt(BankWindow window) const->const Window &
+{
+    if (window >= windows_.size()) {
+        oss() << "There is no bank window " << window << "." << throwError;
+    }
+    return windows_[window];
+}
+
+// Banks mapped from files are never writeable, so their bytes are only read
+// through the pointer, whatever its constness
+//
+auto SystemMemory::addBank(BankWindow window, PageType type, vector<uint8_t> storage, const uint8_t *bytes)->BankId
+{
+    banks_.push_back(Bank{ window, type, const_cast<uint8_t *>(bytes), move(storage) });
+    auto &bank = banks_.back();
+    if (bank.bytes == nullptr) {
+        bank.bytes = bank.storage.data();
+    }
+    return static_cast<BankId>(banks_.size());
+}
+
+auto SystemMemory::plainRun(TargetAddress address, size_t length, bool writing) const->size_t
+{
+    auto limit = min(length, static_cast<size_t>(SIZE - address));
+    auto run = size_t{ 0 };
+    auto next = static_cast<const uint8_t *>(nullptr);
+
+    // Neighbouring plain pages make one run as long as their bytes follow on
+    // in host memory, as they do in memory_ and within a mapped file
+    while (run < limit) {
+        auto &page = pages_[pageOf(static_cast<TargetAddress>(address + run))];
+        auto bytes = writing ? page.write : page.read;
+        if (bytes == nullptr || (run > 0 && bytes != next)) {
+            break;
+        }
+        next = bytes + PAGE_SIZE;
+        run += PAGE_SIZE - pageOffsetOf(static_cast<TargetAddress>(address + run));
+    }
+
+    return min(run, limit);
+}
@@ -2,11 +2,18 @@
 
 #include <stdint.h>
 #include <array>
+#include <deque>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "types.h"
 
+class MappedFile;
+class SaveStateReader;
+class SaveStateWriter;
+
 //
 // SystemMemory represents the memory of the running 6502 system. It contains
 // - any loaded ROM images, to which virtual writes will be ignored
@@ -31,9 +38,38 @@ public:
         virtual ~IOHandler();
         virtual auto read(TargetAddress addr)->uint8_t = 0;
         virtual auto write(TargetAddress addr, uint8_t data)->void = 0;
+
+        // Devices with internal state override these to be included in save states.
+        virtual auto saveState(std::vector<uint8_t> *blob) const->void;
+        virtual auto restoreState(const uint8_t *blob, size_t size)->void;
     };
 
+    // A device as the memory map calls it: read and write are plain functions
+    // taking the device. Devices installed with installStaticIO are bound to
+    // functions calling their own read and write directly, which the compiler
+    // can inline; IOHandlers from installIO are bound to functions making the
+    // virtual call.
+    struct DeviceBinding
+    {
+        using Read = uint8_t(*)(void *device, TargetAddress addr);
+        using Write = void(*)(void *device, TargetAddress addr, uint8_t data);
+
+        Read read;
+        Write write;
+        void *device;
+
+        // The device as an IOHandler, for save states; null if it isn't one
+        IOHandler *handler;
+    };
 
+    // Bank switching: a window is a run of whole pages which banks, each the
+    // size of the window, are switched into. Switching only repoints the
+    // window's page descriptors. Bank ids are unique across windows, so a
+    // bank and an address identify the code there.
+    using BankWindow = uint32_t;
+    using BankId = uint32_t;
+
+    enum : BankId { NO_BANK = 0 };
 
     // Mixed means requires special handling. It can mean RAM and ROM, any partially filled
     // page (so configuration should try to avoid those), or any page that includes IO
@@ -44,6 +80,7 @@ public:
         ReadableFlag = 0x02,
         ReadWriteableFlag = 0x03,
         MixedFlag = 0x04, 
+        BankedFlag = 0x08,
     };
 
     enum PageType {
@@ -51,32 +88,151 @@ public:
         RAM,
         ROM,
         IO,
-        Mixed
+        Mixed,
+        Banked
     };
 
     SystemMemory();
+    ~SystemMemory();
 
     // setup
     auto installROM(TargetAddress baseAddress, const std::vector<uint8_t> &contents)->void;
+
+    // Installs length bytes of a file, from offset, as ROM. The file is mapped
+    // read-only and whole pages of ROM are read straight from the mapping, so
+    // nothing is loaded until the guest touches it and machines loading the
+    // same file share its pages; pages shared with other hardware are copied
+    // in as installROM does. length defaults to the rest of the file. The file
+    // must not change while it is installed.
+    auto installROMFile(const std::string &path, TargetAddress baseAddress, size_t offset = 0, size_t length = SIZE_MAX)->void;
     auto installRAM(TargetAddress baseAddress, TargetAddressSize length)->void;
     auto installIO(TargetAddress baseAddress, TargetAddressSize length, IOHandler *handler)->void;
 
+    // Installs a device of a concrete type, for devices built into the
+    // machine. Device needs read and write member functions like IOHandler's,
+    // which are called non-virtually, so Device must be the object's most
+    // derived type. Devices that are IOHandlers are included in save states.
+    template<typename Device>
+    auto installStaticIO(TargetAddress baseAddress, TargetAddressSize length, Device *device)->void;
+
+    // The device serving an address in a mixed page, or null for plain memory
+    // and unmapped addresses. The translator can call it directly.
+    auto deviceAt(TargetAddress address) const->const DeviceBinding *;
+
+    // Reserves a bank window; it reads as unmapped until a bank is selected
+    auto installBankWindow(TargetAddress baseAddress, TargetAddressSize length)->BankWindow;
+    auto addROMBank(BankWindow window, const std::vector<uint8_t> &contents)->BankId;
+    auto addROMBankFile(BankWindow window, const std::string &path, size_t offset = 0)->BankId;
+    auto addRAMBank(BankWindow window)->BankId;
+    auto selectBank(BankWindow window, BankId bank)->void;
+    auto selectedBank(BankWindow window) const->BankId;
+
+    // The bank switched in at address, or NO_BANK if it isn't in a window
+    auto bankAt(TargetAddress address) const->BankId;
+
     auto readByte(TargetAddress address)->uint8_t;
     auto readWord(TargetAddress address)->uint16_t;
 
+    // Stores to ROM and to unmapped addresses are ignored; stores to devices
+    // go to their handlers.
+    auto writeByte(TargetAddress address, uint8_t data)->void;
+    auto writeWord(TargetAddress address, uint16_t data)->void;
+
+    // Bulk transfers, for loaders and DMA style devices. Runs of plain memory
+    // are copied whole; only mixed pages go byte by byte through their
+    // handlers. Addresses wrap at the top of memory as they do on the 6502.
+    auto readBlock(TargetAddress address, uint8_t *data, size_t length)->void;
+    auto writeBlock(TargetAddress address, const uint8_t *data, size_t length)->void;
+    auto fill(TargetAddress address, uint8_t value, size_t length)->void;
+
+    // Whether length bytes from address, short of the top of memory, are all
+    // plain memory that can be read, or written if writing, so that a block
+    // transfer over them calls no device
+    auto isPlain(TargetAddress address, size_t length, bool writing) const->bool;
+
+    // Whether address is in a whole page of ROM outside any bank window, so
+    // that what it reads can never change
+    auto isROM(TargetAddress address) const->bool;
+
+    // Reads a byte of RAM or ROM without calling any device, for debuggers
+    // and profilers; anything else reads as 0xFF. Safe in a signal handler.
+    auto peekByte(TargetAddress address) const->uint8_t;
+
+    // Installed IO devices, each listed once with the first address it handles
+    auto ioHandlers() const->std::vector<std::pair<TargetAddress, IOHandler *>>;
+
+    // save states
+    auto saveState(SaveStateWriter *writer) const->void;
+    auto restoreState(const SaveStateReader &reader)->void;
+
 private:
     using Memory = std::array<uint8_t, SIZE>;
     using PageFlagsArray = std::array<PageFlags, PAGES>;
-    using MixedPageHandlers = std::array<IOHandler *, PAGE_SIZE>;
-    using MixedPageHandlerMap = std::unordered_map<PageIndex, MixedPageHandlers>;
+    using MixedPageHandlers = std::array<const DeviceBinding *, PAGE_SIZE>;
+    using MixedPageHandlerTables = std::array<std::unique_ptr<MixedPageHandlers>, PAGES>;
+
+    // How to reach a page's bytes. A page which is all readable memory has
+    // read pointing at its host bytes, and likewise write for writeable
+    // memory; a mixed page has handlers pointing at its table of per-byte
+    // devices. Every access is then at most two indexed loads.
+    struct PageDescriptor
+    {
+        const uint8_t *read;
+        uint8_t *write;
+        const DeviceBinding **handlers;
+    };
 
-    auto pageOf(TargetAddress address)->PageIndex;
-    auto pageOffsetOf(TargetAddress address)->PageOffset;
+    using PageDescriptors = std::array<PageDescriptor, PAGES>;
+    using MappedPages = std::array<uint8_t *, PAGES>;
+    using PageBanks = std::array<BankId, PAGES>;
+
+    struct Window
+    {
+        TargetAddress base;
+        TargetAddressSize length;
+        BankId selected;
+    };
+
+    struct Bank
+    {
+        BankWindow window;
+        PageType type;
+        uint8_t *bytes;
+
+        // The bank's bytes unless they are mapped from a file
+        std::vector<uint8_t> storage;
+    };
+
+    auto pageOf(TargetAddress address) const->PageIndex;
+    auto pageOffsetOf(TargetAddress address) const->PageOffset;
     auto pageTypeToFlags(PageType type)->PageFlags;
     auto pageTypeToString(PageType type)->std::string;
 
-    auto installRange(TargetAddress baseAddress, size_t length, PageType type, IOHandler *handler)->void;
-    auto installPage(PageIndex page, PageOffset startOffset, PageOffset endOffset, PageType type, IOHandler *handler)->bool;
+    auto installRange(TargetAddress baseAddress, size_t length, PageType type, const DeviceBinding *binding)->void;
+    auto installPage(PageIndex page, PageOffset startOffset, PageOffset endOffset, PageType type, const DeviceBinding *binding)->bool;
+    auto installDevice(TargetAddress baseAddress, TargetAddressSize length, const DeviceBinding &binding)->void;
+
+    template<typename Device>
+    static auto readDevice(void *device, TargetAddress addr)->uint8_t;
+    template<typename Device>
+    static auto writeDevice(void *device, TargetAddress addr, uint8_t data)->void;
+
+    static auto asHandler(IOHandler *device)->IOHandler *;
+    static auto asHandler(void *device)->IOHandler *;
+    auto updateDescriptor(PageIndex page)->void;
+
+    // Maps a file and checks it holds length bytes from offset; length may
+    // be SIZE_MAX for the rest of the file. The mapping lasts as long as the
+    // memory does.
+    auto mapROMFile(const std::string &path, size_t offset, size_t *length)->const uint8_t *;
+
+    auto windowAt(BankWindow window) const->const Window &;
+    auto addBank(BankWindow window, PageType type, std::vector<uint8_t> storage, const uint8_t *bytes)->BankId;
+
+    // Length of the run of plain memory from address that can be read (or
+    // written) directly, as one block of host memory, up to length and the
+    // top of memory; zero if address is not in plain memory
+    auto plainRun(TargetAddress address, size_t length, bool writing) const->size_t;
 
     class ROMHandler : public IOHandler {
     public:
@@ -98,7 +254,41 @@ private:
 
     Memory memory_;
     PageFlagsArray pageFlags_;
-    MixedPageHandlerMap mixedPageHandlerMap_;
+    PageDescriptors pages_;
+    MixedPageHandlerTables mixedPageHandlers_;
+
+    // Where pages held outside memory_, ROM mapped from files and switched
+    // banks, live on the host, or null for pages in memory_. Only pages whose
+    // flags make them writeable are written through.
+    MappedPages mappedPages_;
+    std::vector<std::unique_ptr<MappedFile>> romFiles_;
+
+    std::vector<Window> windows_;
+    std::deque<Bank> banks_;
+    PageBanks pageBanks_;
     ROMHandler romHandler_;
     RAMHandler ramHandler_;
+    DeviceBinding romBinding_;
+    DeviceBinding ramBinding_;
+
+    // One per installed device; a deque so that bindings never move
+    std::deque<DeviceBinding> deviceBindings_;
 };
+
+template<typename Device>
+auto SystemMemory::installStaticIO(TargetAddress baseAddress, TargetAddressSize length, Device *device)->void
+{
+    installDevice(baseAddress, length, DeviceBinding{ &readDevice<Device>, &writeDevice<Device>, device, asHandler(device) });
+}
+
+template<typename Device>
+auto SystemMemory::readDevice(void *device, TargetAddress addr)->uint8_t
+{
+    return static_cast<Device *>(device)->Device::read(addr);
+}
+
+template<typename Device>
+auto SystemMemory::writeDevice(void *device, TargetAddress addr, uint8_t data)->void
+{
+    static_cast<Device *>(device)->Device::write(addr, data);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cpustate.h"
+
+// Why translated code returned to the dispatcher, when it is for anything
+// but reaching the end of a block. Translated code never throws; it sets the
+// reason, with cpu.pc at the guest instruction concerned, and leaves through
+// the exit stub like any other block.
+enum ExitReason : uint16_t
+{
+    ExitNone,
+
+    // cpu.pc is at an opcode with no translation
+    ExitInvalidOpcode,
+
+    // cpu.pc is the return address of a BRK, for the dispatcher to enter the
+    // IRQ handler with
+    ExitBreak,
+};
+
+// Key of an entry in the translator's IO site table; zero for none
+enum : uint32_t { NO_IO_SITE = 0 };
+
+//
+// VMContext is the state translated code runs against. While a block runs EBP
+// points here, and guest A and P are cached in BL and BH; the exit stub writes
+// them back before returning to the dispatcher.
+//
+struct VMContext
+{
+    CpuState cpu;
+
+    // Guest instructions retired
+    uint64_t instructions;
+
+    // The cycle of the next scheduled event; translated code must be back in
+    // the dispatcher once cpu.cycles reaches it
+    uint64_t deadline;
+
+    // Set by translated code leaving a block early, and cleared by the
+    // dispatcher once it has dealt with it
+    uint16_t exitReason;
+
+    // The IO site of the device access in progress, stored by translated code
+    // just before it calls a memory helper and cleared by the helper
+    uint32_t ioSite;
+
+    // Host stack pointer saved by the entry stub
+    uintptr_t hostStack;
+};
@@ -0,0 +1,250 @@
+#include "batch.h"
+
+#include "exceptions.h"
+#include "workstealingpool.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+using std::atomic;
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::exception;
+using std::fixed;
+using std::ifstream;
+using std::ios_base;
+using std::istringstream;
+using std::lock_guard;
+using std::mutex;
+using std::ofstream;
+using std::ostream;
+using std::setprecision;
+using std::string;
+using std::vector;
+
+using Clock = std::chrono::steady_clock;
+using oss = std::ostringstream;
+
+namespace
+{
+    auto csvField(const string &text)->string
+    {
+        if (text.find_first_of(",\"\n") == string::npos) {
+            return text;
+        }
+
+        auto quoted = string{ "\"" };
+        for (auto ch : text) {
+            if (ch == '"') {
+                quoted += '"';
+            }
+            quoted += ch;
+        }
+        return quoted + "\"";
+    }
+
+    auto jsonString(const string &text)->string
+    {
+        auto quoted = string{ "\"" };
+        for (auto ch : text) {
+            switch (ch) {
+            case '"':
+                quoted += "\\\"";
+                break;
+
+            case '\\':
+                quoted += "\\\\";
+                break;
+
+            case '\n':
+                quoted += "\\n";
+                break;
+
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    auto escape = oss{};
+                    escape << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int{ ch };
+                    quoted += escape.str();
+                }
+                else {
+                    quoted += ch;
+                }
+            }
+        }
+        return quoted + "\"";
+    }
+
+    auto directoryOf(const string &path)->string
+    {
+        auto slash = path.find_last_of("/\\");
+        return slash == string::npos ? string{ "." } : path.substr(0, slash);
+    }
+
+    auto runJob(const BatchJob &job, ResultSink *sink)->bool
+    {
+        auto outcome = RunOutcome{};
+
+        try {
+            Machine machine(job.options.machine);
+            outcome = machine.run(job.options.limits);
+        }
+        catch (const exception &err) {
+            // The machine couldn't be built, e.g. a missing ROM
+            outcome = RunOutcome{};
+            outcome.stop = RunOutcome::Error;
+            outcome.error = err.what();
+        }
+
+        auto passed = false;
+        if (outcome.stop == RunOutcome::Trapped) {
+            passed = !job.options.hasPass || outcome.context.cpu.pc == job.options.pass;
+        }
+        else {
+            passed = outcome.stop != RunOutcome::Error && !job.options.hasPass;
+        }
+
+        sink->write(job.name, passed, outcome);
+        return passed;
+    }
+}
+
+auto readManifest(const string &path, const JobOptions &defaults)->vector<BatchJob>
+{
+    auto file = ifstream{ path };
+    if (!file) {
+        oss() << "Could not open " << path << "." << throwError;
+    }
+
+    auto baseDir = directoryOf(path);
+    auto jobs = vector<BatchJob>{};
+    auto line = string{};
+    auto lineNumber = 0;
+
+    while (getline(file, line)) {
+        lineNumber++;
+
+        auto words = vector<string>{};
+        auto stm = istringstream{ line };
+        auto word = string{};
+        while (stm >> word) {
+            words.push_back(word);
+        }
+
+        if (words.empty() || words[0][0] == '#') {
+            continue;
+        }
+
+        try {
+            auto args = vector<string>(words.begin() + 1, words.end());
+            jobs.push_back(BatchJob{ words[0], parseJobOptions(args, defaults, baseDir) });
+        }
+        catch (const exception &err) {
+            oss() << path << ":" << lineNumber << ": " << err.what() << throwError;
+        }
+    }
+
+    return jobs;
+}
+
+ResultSink::ResultSink(ostream *stm, ResultFormat format)
+    : stm_(stm)
+    , format_(format)
+{
+    if (format_ == CSVResults) {
+        *stm_ << "name,result,reason,cycles,instructions,seconds,a,x,y,s,p,pc" << endl;
+    }
+}
+
+auto ResultSink::write(const string &name, bool passed, const RunOutcome &outcome)->void
+{
+    auto &cpu = outcome.context.cpu;
+    auto record = oss{};
+
+    if (format_ == CSVResults) {
+        record
+            << csvField(name) << ","
+            << (passed ? "pass" : "fail") << ","
+            << csvField(outcome.describe()) << ","
+            << cpu.cycles << ","
+            << outcome.context.instructions << ","
+            << fixed << setprecision(6) << outcome.seconds << ","
+            << unsigned{ cpu.a } << ","
+            << unsigned{ cpu.x } << ","
+            << unsigned{ cpu.y } << ","
+            << unsigned{ cpu.s } << ","
+            << unsigned{ cpu.p } << ","
+            << cpu.pc;
+    }
+    else {
+        record
+            << "{\"name\":" << jsonString(name)
+            << ",\"result\":\"" << (passed ? "pass" : "fail") << "\""
+            << ",\"reason\":" << jsonString(outcome.describe())
+            << ",\"cycles\":" << cpu.cycles
+            << ",\"instructions\":" << outcome.context.instructions
+            << ",\"seconds\":" << fixed << setprecision(6) << outcome.seconds
+            << ",\"a\":" << unsigned{ cpu.a }
+            << ",\"x\":" << unsigned{ cpu.x }
+            << ",\"y\":" << unsigned{ cpu.y }
+            << ",\"s\":" << unsigned{ cpu.s }
+            << ",\"p\":" << unsigned{ cpu.p }
+            << ",\"pc\":" << cpu.pc
+            << ",\"jit\":" << outcome.stats.toJSON()
+            << "}";
+    }
+
+    lock_guard<mutex> hold(lock_);
+    *stm_ << record.str() << '\n';
+}
+
+auto runBatch(const Options &options)->int
+{
+    auto jobs = readManifest(options.manifest, options.job);
+
+    auto resultsFile = ofstream{};
+    auto results = static_cast<ostream *>(&cout);
+    if (!options.results.empty()) {
+        resultsFile.open(options.results, ios_base::out | ios_base::trunc);
+        if (!resultsFile) {
+            oss() << "Could not create " << options.results << "." << throwError;
+        }
+        results = &resultsFile;
+    }
+
+    auto threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+    atomic<size_t> passed(0);
+    auto start = Clock::now();
+
+    ResultSink sink(results, options.format);
+    {
+        WorkStealingPool pool(threads);
+        for (auto &job : jobs) {
+            pool.submit([&job, &sink, &passed] {
+                if (runJob(job, &sink)) {
+                    passed++;
+                }
+            });
+        }
+        pool.wait();
+    }
+    results->flush();
+
+    auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    cerr
+        << jobs.size() << " jobs, "
+        << passed << " passed, "
+        << jobs.size() - passed << " failed in "
+        << fixed << setprecision(3) << seconds << " s on "
+        << threads << " threads ("
+        << setprecision(1) << (seconds > 0 ? jobs.size() / seconds : 0.0) << " jobs/s)" << endl;
+
+    return passed == jobs.size() ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "options.h"
+
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct BatchJob
+{
+    std::string name;
+    JobOptions options;
+};
+
+// Reads a manifest: one job per line, a name followed by job options. Blank
+// lines and lines starting with # are ignored.
+auto readManifest(const std::string &path, const JobOptions &defaults)->std::vector<BatchJob>;
+
+//
+// ResultSink writes one record per finished job, as CSV or JSON lines, in the
+// order jobs finish. It may be called from any thread.
+//
+class ResultSink
+{
+public:
+    ResultSink(std::ostream *stm, ResultFormat format);
+
+    auto write(const std::string &name, bool passed, const RunOutcome &outcome)->void;
+
+private:
+    std::mutex lock_;
+    std::ostream *stm_;
+    ResultFormat format_;
+};
+
+// Runs every job in the manifest; returns the process exit code
+auto runBatch(const Options &options)->int;
@@ -0,0 +1,202 @@
+// jitrun.cpp : Headless command line runner for the 6502 JIT.
+//
+
+#include "batch.h"
+#include "exceptions.h"
+#include "guestprofiler.h"
+#include "machine.h"
+#include "options.h"
+#include "perfmap.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::cerr;
+using std::condition_variable;
+using std::cout;
+using std::endl;
+using std::exception;
+using std::fixed;
+using std::hex;
+using std::ios_base;
+using std::lock_guard;
+using std::mutex;
+using std::ofstream;
+using std::ostream;
+using std::runtime_error;
+using std::setfill;
+using std::setprecision;
+using std::setw;
+using std::string;
+using std::thread;
+using std::unique_ptr;
+using std::unique_lock;
+using std::vector;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    auto printState(const VMContext &context)->void
+    {
+        auto &cpu = context.cpu;
+        cout
+            << hex << setfill('0') << std::uppercase
+            << "registers: A=" << setw(2) << unsigned{ cpu.a }
+            << " X=" << setw(2) << unsigned{ cpu.x }
+            << " Y=" << setw(2) << unsigned{ cpu.y }
+            << " S=" << setw(2) << unsigned{ cpu.s }
+            << " P=" << setw(2) << unsigned{ cpu.p }
+            << " PC=" << setw(4) << cpu.pc
+            << std::dec << std::nouppercase << endl;
+    }
+
+    // Lines of the profile report given to each of instructions and subroutines
+    const size_t PROFILE_TOP = 20;
+
+    //
+    // StatsMonitor writes the translator statistics of a running machine from
+    // a thread of its own, every interval seconds until it is destroyed.
+    //
+    class StatsMonitor
+    {
+    public:
+        StatsMonitor(const Jitter6502 *jitter, ostream *out, double interval)
+            : jitter_(jitter)
+            , out_(out)
+            , interval_(interval)
+            , finished_(false)
+            , thread_([this] { monitor(); })
+        {
+        }
+
+        ~StatsMonitor()
+        {
+            {
+                lock_guard<mutex> hold(lock_);
+                finished_ = true;
+            }
+            wake_.notify_one();
+            thread_.join();
+        }
+
+    private:
+        auto monitor()->void
+        {
+            unique_lock<mutex> hold(lock_);
+            while (!wake_.wait_for(hold, std::chrono::duration<double>(interval_), [this] { return finished_; })) {
+                *out_ << jitter_->stats().toJSON() << endl;
+            }
+        }
+
+        const Jitter6502 *jitter_;
+        ostream *out_;
+        double interval_;
+        bool finished_;
+        mutex lock_;
+        condition_variable wake_;
+        thread thread_;
+    };
+
+    auto runSingle(const Options &options)->int
+    {
+        auto &job = options.job;
+        Machine machine(job.machine);
+
+        auto profiler = unique_ptr<GuestProfiler>{};
+        if (options.profile != 0) {
+            profiler.reset(new GuestProfiler(&machine.jitter(), &machine.memory()));
+            profiler->start(options.profile);
+        }
+
+        auto statsFile = ofstream{};
+        auto statsOut = static_cast<ostream *>(&cout);
+        if (!options.stats.empty() && options.stats != "-") {
+            statsFile.open(options.stats, ios_base::out | ios_base::trunc);
+            if (!statsFile) {
+                oss() << "Could not create " << options.stats << "." << throwError;
+            }
+            statsOut = &statsFile;
+        }
+
+        auto monitor = unique_ptr<StatsMonitor>{};
+        if (options.statsInterval > 0) {
+            monitor.reset(new StatsMonitor(&machine.jitter(), statsOut, options.statsInterval));
+        }
+
+        auto outcome = machine.run(job.limits);
+        monitor.reset();
+        if (profiler) {
+            profiler->stop();
+        }
+
+        auto &context = outcome.context;
+        auto mips = outcome.seconds > 0 ? context.instructions / outcome.seconds / 1e6 : 0.0;
+
+        cout << "stopped: " << outcome.describe() << endl;
+        cout << "cycles: " << context.cpu.cycles << endl;
+        cout << "instructions: " << context.instructions << endl;
+        cout << "elapsed: " << fixed << setprecision(6) << outcome.seconds << " s" << endl;
+        cout << "guest MIPS: " << fixed << setprecision(2) << mips << endl;
+        if (job.machine.pretranslate) {
+            cout << "pretranslated: " << outcome.stats.pretranslatedBlocks << " blocks in "
+                << fixed << setprecision(6) << outcome.stats.pretranslateNanoseconds / 1e9 << " s" << endl;
+        }
+        printState(context);
+
+        if (profiler) {
+            cout << endl;
+            profiler->report(cout, PROFILE_TOP);
+        }
+
+        if (!options.stats.empty()) {
+            *statsOut << outcome.stats.toJSON() << endl;
+        }
+
+        if (outcome.stop == RunOutcome::Error) {
+            return 1;
+        }
+        if (job.hasPass && (outcome.stop != RunOutcome::Trapped || context.cpu.pc != job.pass)) {
+            return 1;
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    auto options = Options{};
+    try {
+        options = parseOptions(vector<string>(argv + 1, argv + argc));
+    }
+    catch (const runtime_error &err) {
+        cerr << "jitrun: " << err.what() << endl;
+        usage();
+        return 2;
+    }
+
+    try {
+        if (options.perf != 0) {
+            PerfMap::enable(options.perf);
+        }
+        if (!options.manifest.empty()) {
+            return runBatch(options);
+        }
+        return runSingle(options);
+    }
+    catch (const exception &err) {
+        cerr << "jitrun: " << err.what() << endl;
+        return 1;
+    }
+}
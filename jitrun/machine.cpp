@@ -0,0 +1,130 @@
+#include "machine.h"
+
+#include "exceptions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using std::hex;
+using std::min;
+using std::runtime_error;
+using std::setfill;
+using std::setw;
+using std::string;
+
+using Clock = std::chrono::steady_clock;
+using oss = std::ostringstream;
+
+namespace
+{
+    // Size of the code cache address space reserved for each machine
+    const uint32_t CODE_CACHE_SIZE = 16 * 1024 * 1024;
+
+    // With a time budget, the clock is checked after every slice of this many cycles
+    const uint64_t TIME_SLICE_CYCLES = 100000;
+}
+
+auto RunOutcome::describe() const->string
+{
+    switch (stop) {
+    case CycleBudget:
+        return "cycle budget reached";
+
+    case TimeBudget:
+        return "time budget reached";
+
+    case Trapped: {
+        auto text = oss{};
+        text << "trapped at $" << setw(4) << setfill('0') << hex << std::uppercase << context.cpu.pc;
+        return text.str();
+    }
+
+    case Error:
+        return error;
+    }
+
+    return "unknown";
+}
+
+Machine::Machine(const MachineConfig &config)
+    : vm_(CODE_CACHE_SIZE)
+    , assembler_(&vm_)
+    , memory_()
+    , jitter_(&vm_, &assembler_, &memory_, config.cpu)
+{
+    for (auto &rom : config.roms) {
+        memory_.installROMFile(rom.path, rom.base);
+    }
+    for (auto &ram : config.ram) {
+        memory_.installRAM(ram.base, ram.length);
+    }
+
+    jitter_.reset();
+    if (config.hasEntry) {
+        jitter_.context().cpu.pc = config.entry;
+    }
+    if (config.pretranslate) {
+        jitter_.pretranslate();
+    }
+}
+
+auto Machine::run(const RunLimits &limits)->RunOutcome
+{
+    auto &context = jitter_.context();
+    auto outcome = RunOutcome{};
+    auto start = Clock::now();
+
+    outcome.stop = RunOutcome::CycleBudget;
+
+    try {
+        auto status = CycleLimitReached;
+        if (limits.seconds <= 0) {
+            status = jitter_.run(limits.cycles);
+        }
+        else {
+            while (context.cpu.cycles < limits.cycles) {
+                status = jitter_.run(min(limits.cycles, context.cpu.cycles + TIME_SLICE_CYCLES));
+                if (status != CycleLimitReached) {
+                    break;
+                }
+
+                if (std::chrono::duration<double>(Clock::now() - start).count() >= limits.seconds) {
+                    outcome.stop = RunOutcome::TimeBudget;
+                    break;
+                }
+            }
+        }
+
+        if (status == Trapped) {
+            outcome.stop = RunOutcome::Trapped;
+        }
+        else if (status == InvalidOpcode) {
+            auto text = oss{};
+            text << "invalid opcode at $" << setw(4) << setfill('0') << hex << std::uppercase << context.cpu.pc;
+            outcome.stop = RunOutcome::Error;
+            outcome.error = text.str();
+        }
+    }
+    catch (const runtime_error &err) {
+        outcome.stop = RunOutcome::Error;
+        outcome.error = err.what();
+    }
+
+    outcome.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    outcome.context = context;
+    outcome.stats = jitter_.stats();
+    return outcome;
+}
+
+auto Machine::jitter()->Jitter6502 &
+{
+    return jitter_;
+}
+
+auto Machine::memory()->SystemMemory &
+{
+    return memory_;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "assembler_x86.h"
+#include "jitter6502.h"
+#include "jitvm.h"
+#include "systemmemory.h"
+#include "types.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct ROMImage
+{
+    std::string path;
+    TargetAddress base;
+};
+
+struct RAMRange
+{
+    TargetAddress base;
+    TargetAddressSize length;
+};
+
+struct MachineConfig
+{
+    std::vector<ROMImage> roms;
+    std::vector<RAMRange> ram;
+    bool hasEntry = false;
+    TargetAddress entry = 0;
+    CpuModel cpu = CPU_NMOS;
+
+    // Translate the code reachable in ROM before running, rather than as the
+    // guest gets to it
+    bool pretranslate = false;
+};
+
+struct RunLimits
+{
+    uint64_t cycles = UINT64_MAX;
+
+    // Wall clock limit in seconds; zero for none
+    double seconds = 0;
+};
+
+struct RunOutcome
+{
+    enum Stop {
+        CycleBudget,
+        TimeBudget,
+        Trapped,
+        Error,
+    };
+
+    Stop stop;
+    std::string error;
+    VMContext context;
+    double seconds;
+    JitStats stats;
+
+    auto describe() const->std::string;
+};
+
+//
+// Machine is one complete guest: code cache, memory and translator. Machines
+// share nothing, so any number of them can run on separate threads.
+//
+class Machine
+{
+public:
+    Machine(const MachineConfig &config);
+
+    auto run(const RunLimits &limits)->RunOutcome;
+    auto jitter()->Jitter6502 &;
+    auto memory()->SystemMemory &;
+
+private:
+    JitVM vm_;
+    AssemblerX86 assembler_;
+    SystemMemory memory_;
+    Jitter6502 jitter_;
+};
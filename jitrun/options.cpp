@@ -0,0 +1,269 @@
+#include "options.h"
+
+#include "exceptions.h"
+#include "perfmap.h"
+
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using std::cerr;
+using std::endl;
+using std::exception;
+using std::string;
+using std::vector;
+
+using oss = std::ostringstream;
+
+namespace
+{
+    auto parseHex(const string &text, uint32_t limit)->uint32_t
+    {
+        auto digits = text;
+        if (digits.size() > 0 && digits[0] == '$') {
+            digits = digits.substr(1);
+        }
+        else if (digits.size() > 1 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+            digits = digits.substr(2);
+        }
+
+        auto end = size_t{};
+        auto value = 0ul;
+        try {
+            value = std::stoul(digits, &end, 16);
+        }
+        catch (const exception &) {
+            end = 0;
+        }
+
+        if (digits.empty() || end != digits.size() || value > limit) {
+            oss() << "'" << text << "' is not a valid address or length." << throwError;
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    auto parseNumber(const string &option, const string &text)->double
+    {
+        auto end = size_t{};
+        auto value = 0.0;
+        try {
+            value = std::stod(text, &end);
+        }
+        catch (const exception &) {
+            end = 0;
+        }
+
+        if (end == 0 || end != text.size() || value < 0) {
+            oss() << option << " expects a non-negative number." << throwError;
+        }
+        return value;
+    }
+
+    auto isAbsolute(const string &path)->bool
+    {
+        return (!path.empty() && (path[0] == '/' || path[0] == '\\')) || (path.size() > 1 && path[1] == ':');
+    }
+
+    // Applies one job option; returns false if option isn't a job option
+    auto parseJobOption(const string &option, const string &arg, const string &baseDir, JobOptions *job)->bool
+    {
+        if (option == "--rom") {
+            auto at = arg.rfind('@');
+            if (at == string::npos) {
+                oss() << "--rom expects FILE@ADDR." << throwError;
+            }
+
+            auto path = arg.substr(0, at);
+            if (!baseDir.empty() && !isAbsolute(path)) {
+                path = baseDir + "/" + path;
+            }
+            job->machine.roms.push_back(ROMImage{ path, static_cast<TargetAddress>(parseHex(arg.substr(at + 1), 0xFFFF)) });
+        }
+        else if (option == "--ram") {
+            auto colon = arg.find(':');
+            if (colon == string::npos) {
+                oss() << "--ram expects ADDR:LENGTH." << throwError;
+            }
+            auto base = parseHex(arg.substr(0, colon), 0xFFFF);
+            auto length = parseHex(arg.substr(colon + 1), 0x10000);
+            job->machine.ram.push_back(RAMRange{ static_cast<TargetAddress>(base), static_cast<TargetAddressSize>(length) });
+        }
+        else if (option == "--entry") {
+            job->machine.hasEntry = true;
+            job->machine.entry = static_cast<TargetAddress>(parseHex(arg, 0xFFFF));
+        }
+        else if (option == "--cpu") {
+            if (arg == "nmos") {
+                job->machine.cpu = CPU_NMOS;
+            }
+            else if (arg == "nmos-undocumented") {
+                job->machine.cpu = CPU_NMOS_UNDOCUMENTED;
+            }
+            else if (arg == "65c02") {
+                job->machine.cpu = CPU_65C02;
+            }
+            else {
+                oss() << "--cpu expects nmos, nmos-undocumented or 65c02." << throwError;
+            }
+        }
+        else if (option == "--translate") {
+            if (arg == "lazy") {
+                job->machine.pretranslate = false;
+            }
+            else if (arg == "ahead") {
+                job->machine.pretranslate = true;
+            }
+            else {
+                oss() << "--translate expects lazy or ahead." << throwError;
+            }
+        }
+        else if (option == "--pass") {
+            job->hasPass = true;
+            job->pass = static_cast<TargetAddress>(parseHex(arg, 0xFFFF));
+        }
+        else if (option == "--cycles") {
+            job->limits.cycles = static_cast<uint64_t>(parseNumber(option, arg));
+        }
+        else if (option == "--seconds") {
+            job->limits.seconds = parseNumber(option, arg);
+        }
+        else {
+            return false;
+        }
+
+        return true;
+    }
+}
+
+auto usage()->void
+{
+    cerr
+        << "usage: jitrun [options]" << endl
+        << "       jitrun --batch MANIFEST [options]" << endl
+        << "  --rom FILE@ADDR     load a ROM image at ADDR" << endl
+        << "  --ram ADDR:LENGTH   install LENGTH bytes of RAM at ADDR" << endl
+        << "  --entry ADDR        start at ADDR rather than the RESET vector" << endl
+        << "  --cpu MODEL         nmos (default), nmos-undocumented or 65c02" << endl
+        << "  --translate WHEN    lazy (default) as the guest runs, or ahead to translate" << endl
+        << "                      the code reachable in ROM before it starts" << endl
+        << "  --pass ADDR         succeed only if the guest traps at ADDR" << endl
+        << "  --cycles N          stop after N guest cycles" << endl
+        << "  --seconds S         stop after S seconds" << endl
+        << "Batch mode:" << endl
+        << "  --batch MANIFEST    run each job in MANIFEST; one job per line, a name" << endl
+        << "                      followed by the options above" << endl
+        << "  --threads N         worker threads (default: one per core)" << endl
+        << "  --results FILE      write results to FILE rather than stdout" << endl
+        << "  --format csv|jsonl  result format (default: csv)" << endl
+        << "Profiling:" << endl
+        << "  --perf map|jitdump  describe generated code to perf in /tmp/perf-PID.map," << endl
+        << "                      and with jitdump also in ./jit-PID.dump" << endl
+        << "  --profile HZ        sample the guest HZ times a second of CPU time and" << endl
+        << "                      report the hottest 6502 addresses and subroutines" << endl
+        << "  --stats FILE        write translator statistics as JSON to FILE, or - for" << endl
+        << "                      stdout; batch results in jsonl include them per job" << endl
+        << "  --stats-interval S  also write them every S seconds while the guest runs" << endl
+        << "Addresses and lengths are hex, optionally prefixed with $ or 0x." << endl
+        << "In batch mode, --cycles and --seconds are defaults for every job." << endl;
+}
+
+auto parseOptions(const vector<string> &args)->Options
+{
+    auto options = Options{};
+
+    for (auto i = size_t{ 0 }; i < args.size(); i++) {
+        auto &option = args[i];
+        if (i + 1 == args.size()) {
+            oss() << option << " requires an argument." << throwError;
+        }
+        auto &arg = args[++i];
+
+        if (parseJobOption(option, arg, "", &options.job)) {
+            continue;
+        }
+
+        if (option == "--batch") {
+            options.manifest = arg;
+        }
+        else if (option == "--threads") {
+            options.threads = static_cast<unsigned>(parseNumber(option, arg));
+        }
+        else if (option == "--results") {
+            options.results = arg;
+        }
+        else if (option == "--format") {
+            if (arg == "csv") {
+                options.format = CSVResults;
+            }
+            else if (arg == "jsonl") {
+                options.format = JSONLinesResults;
+            }
+            else {
+                oss() << "--format expects csv or jsonl." << throwError;
+            }
+        }
+        else if (option == "--perf") {
+            if (arg == "map") {
+                options.perf = PerfMap::MapFormat;
+            }
+            else if (arg == "jitdump") {
+                options.perf = PerfMap::MapFormat | PerfMap::JitDumpFormat;
+            }
+            else {
+                oss() << "--perf expects map or jitdump." << throwError;
+            }
+        }
+        else if (option == "--profile") {
+            options.profile = static_cast<unsigned>(parseNumber(option, arg));
+        }
+        else if (option == "--stats") {
+            options.stats = arg;
+        }
+        else if (option == "--stats-interval") {
+            options.statsInterval = parseNumber(option, arg);
+        }
+        else {
+            oss() << "Unknown option " << option << "." << throwError;
+        }
+    }
+
+    if (options.manifest.empty() && options.job.machine.roms.empty()) {
+        oss() << "At least one ROM image is required." << throwError;
+    }
+    if (!options.manifest.empty() && options.profile != 0) {
+        oss() << "--profile samples a single machine and cannot be used with --batch." << throwError;
+    }
+    if (!options.manifest.empty() && !options.stats.empty()) {
+        oss() << "--stats is for single runs; use --format jsonl for statistics per batch job." << throwError;
+    }
+    if (options.statsInterval > 0 && options.stats.empty()) {
+        oss() << "--stats-interval requires --stats." << throwError;
+    }
+
+    return options;
+}
+
+auto parseJobOptions(const vector<string> &args, const JobOptions &defaults, const string &baseDir)->JobOptions
+{
+    auto job = JobOptions{};
+    job.limits = defaults.limits;
+
+    for (auto i = size_t{ 0 }; i < args.size(); i++) {
+        auto &option = args[i];
+        if (i + 1 == args.size()) {
+            oss() << option << " requires an argument." << throwError;
+        }
+
+        if (!parseJobOption(option, args[i + 1], baseDir, &job)) {
+            oss() << "Unknown job option " << option << "." << throwError;
+        }
+        i++;
+    }
+
+    if (job.machine.roms.empty()) {
+        oss() << "At least one ROM image is required." << throwError;
+    }
+
+    return job;
+}
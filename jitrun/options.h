@@ -0,0 +1,52 @@
+#pragma once
+
+#include "machine.h"
+
+#include <string>
+#include <vector>
+
+enum ResultFormat
+{
+    CSVResults,
+    JSONLinesResults,
+};
+
+// What one run (or one batch job) needs
+struct JobOptions
+{
+    MachineConfig machine;
+    RunLimits limits;
+
+    // If set, the job passes only if it traps here
+    bool hasPass = false;
+    TargetAddress pass = 0;
+};
+
+struct Options
+{
+    JobOptions job;
+
+    // Batch mode
+    std::string manifest;
+    unsigned threads = 0;
+    std::string results;
+    ResultFormat format = CSVResults;
+
+    // PerfMap formats to record generated code in, if any
+    unsigned perf = 0;
+
+    // Guest profiler sampling rate in Hz; zero for off
+    unsigned profile = 0;
+
+    // Where to write translator statistics, - for stdout; and how often while
+    // the guest runs, in seconds, or zero for only at the end
+    std::string stats;
+    double statsInterval = 0;
+};
+
+auto usage()->void;
+auto parseOptions(const std::vector<std::string> &args)->Options;
+
+// Parses one manifest line's options on top of defaults; ROM paths are
+// relative to baseDir
+auto parseJobOptions(const std::vector<std::string> &args, const JobOptions &defaults, const std::string &baseDir)->JobOptions;
@@ -0,0 +1,119 @@
+#include "workstealingpool.h"
+
+using std::lock_guard;
+using std::mutex;
+using std::thread;
+using std::unique_lock;
+using std::unique_ptr;
+
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : unfinished_(0)
+    , queued_(0)
+    , nextQueue_(0)
+    , stopping_(false)
+{
+    if (threads == 0) {
+        threads = 1;
+    }
+
+    for (auto i = 0u; i < threads; i++) {
+        queues_.push_back(unique_ptr<Queue>(new Queue{}));
+    }
+    for (auto i = 0u; i < threads; i++) {
+        threads_.emplace_back(&WorkStealingPool::workerMain, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<mutex> hold(stateLock_);
+        stopping_ = true;
+    }
+    workAvailable_.notify_all();
+
+    for (auto &worker : threads_) {
+        worker.join();
+    }
+}
+
+auto WorkStealingPool::submit(Task task)->void
+{
+    auto index = nextQueue_++ % queues_.size();
+
+    // Count the task before it becomes visible, so the count never goes negative
+    unfinished_++;
+    {
+        lock_guard<mutex> hold(stateLock_);
+        queued_++;
+    }
+
+    {
+        lock_guard<mutex> hold(queues_[index]->lock);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    workAvailable_.notify_one();
+}
+
+auto WorkStealingPool::wait()->void
+{
+    unique_lock<mutex> hold(stateLock_);
+    allDone_.wait(hold, [this] { return unfinished_ == 0; });
+}
+
+auto WorkStealingPool::threads() const->unsigned
+{
+    return static_cast<unsigned>(threads_.size());
+}
+
+auto WorkStealingPool::workerMain(unsigned index)->void
+{
+    while (true) {
+        auto task = Task{};
+
+        if (!tryTake(index, &task)) {
+            unique_lock<mutex> hold(stateLock_);
+            workAvailable_.wait(hold, [this] { return stopping_ || queued_ != 0; });
+            if (stopping_ && queued_ == 0) {
+                return;
+            }
+            continue;
+        }
+
+        task();
+
+        if (--unfinished_ == 0) {
+            lock_guard<mutex> hold(stateLock_);
+            allDone_.notify_all();
+        }
+    }
+}
+
+auto WorkStealingPool::tryTake(unsigned index, Task *task)->bool
+{
+    auto count = static_cast<unsigned>(queues_.size());
+
+    for (auto i = 0u; i < count; i++) {
+        auto &queue = *queues_[(index + i) % count];
+        lock_guard<mutex> hold(queue.lock);
+
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        // Newest work from our own queue, oldest from anyone else's
+        if (i == 0) {
+            *task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            *task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        queued_--;
+        return true;
+    }
+
+    return false;
+}
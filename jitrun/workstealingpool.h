@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// WorkStealingPool runs tasks on a fixed set of threads. Each worker has its
+// own queue, which it works from the back; a worker whose queue runs dry takes
+// from the front of the others. Submitted work is dealt out round robin, so
+// workers mostly touch only their own queue and rarely contend.
+//
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    WorkStealingPool(unsigned threads);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    auto operator=(const WorkStealingPool &)->WorkStealingPool & = delete;
+
+    auto submit(Task task)->void;
+
+    // Blocks until every submitted task has finished
+    auto wait()->void;
+
+    auto threads() const->unsigned;
+
+private:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    auto workerMain(unsigned index)->void;
+    auto tryTake(unsigned index, Task *task)->bool;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    // Tasks submitted but not yet finished, and not yet started
+    std::atomic<size_t> unfinished_;
+    std::atomic<size_t> queued_;
+    std::atomic<unsigned> nextQueue_;
+
+    std::mutex stateLock_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;
+    bool stopping_;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+//
+// A minimal stand-in for the Visual Studio native unit test framework, so the
+// tests build and run under ctest where that framework isn't available. Only
+// the parts of the framework the tests use are provided.
+//
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Microsoft {
+namespace VisualStudio {
+namespace CppUnitTestFramework {
+
+    struct TestFailure
+    {
+        std::wstring message;
+    };
+
+    struct TestCase
+    {
+        const char *className;
+        const char *methodName;
+        std::function<void()> run;
+    };
+
+    inline auto registeredTests()->std::vector<TestCase> &
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline auto registerTest(const char *className, const char *methodName, std::function<void()> run)->void
+    {
+        registeredTests().push_back(TestCase{ className, methodName, run });
+    }
+
+    class Assert
+    {
+    public:
+        static auto IsTrue(bool condition, const wchar_t *message = nullptr)->void
+        {
+            if (!condition) {
+                Fail(message);
+            }
+        }
+
+        static auto IsFalse(bool condition, const wchar_t *message = nullptr)->void
+        {
+            IsTrue(!condition, message);
+        }
+
+        template<typename T>
+        static auto AreEqual(const T &expected, const T &actual, const wchar_t *message = nullptr)->void
+        {
+            if (!(expected == actual)) {
+                std::wostringstream text;
+                text << L"Expected <" << expected << L"> Actual <" << actual << L"> " << (message != nullptr ? message : L"");
+                throw TestFailure{ text.str() };
+            }
+        }
+
+        static auto Fail(const wchar_t *message = nullptr)->void
+        {
+            throw TestFailure{ message != nullptr ? message : L"Assert failed" };
+        }
+    };
+
+    template<typename T>
+    class TestClass
+    {
+    public:
+        using ThisClass = T;
+    };
+
+}
+}
+}
+
+#define TEST_CLASS(className) \
+    class className; \
+    inline const char *testClassName(className *) { return #className; } \
+    class className : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName) \
+    struct methodName##_Registration \
+    { \
+        methodName##_Registration() \
+        { \
+            ::Microsoft::VisualStudio::CppUnitTestFramework::registerTest( \
+                testClassName(static_cast<ThisClass *>(nullptr)), #methodName, [] { ThisClass test; test.methodName(); }); \
+        } \
+    }; \
+    inline static methodName##_Registration methodName##_registration_{}; \
+    void methodName()
@@ -0,0 +1,50 @@
+#include "CppUnitTest.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+using std::cout;
+using std::endl;
+using std::exception;
+using std::string;
+using std::wstring;
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+    auto narrow(const wstring &text)->string
+    {
+        auto result = string{};
+        for (auto ch : text) {
+            result += ch < 0x80 ? static_cast<char>(ch) : '?';
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    auto failures = 0;
+
+    for (auto &test : registeredTests()) {
+        auto name = string(test.className) + "::" + test.methodName;
+
+        try {
+            test.run();
+            cout << "[ PASS ] " << name << endl;
+        }
+        catch (const TestFailure &failure) {
+            cout << "[ FAIL ] " << name << ": " << narrow(failure.message) << endl;
+            failures++;
+        }
+        catch (const exception &ex) {
+            cout << "[ FAIL ] " << name << ": threw " << ex.what() << endl;
+            failures++;
+        }
+    }
+
+    cout << registeredTests().size() - failures << " passed, " << failures << " failed" << endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../jitlib/guestpctable.h"
+
+#include <stdint.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace jittests
+{
+    TEST_CLASS(GuestPCTableTest)
+    {
+    public:
+
+        TEST_METHOD(TestLookupWithinBlocks)
+        {
+            uint8_t code[64];
+            GuestPCTable table;
+
+            table.beginBlock(&code[0]);
+            table.addInstruction(&code[0], 0xF000);
+            table.addInstruction(&code[10], 0xF002);
+            table.addInstruction(&code[12], 0xF004);
+            table.endBlock(&code[20]);
+
+            table.beginBlock(&code[32]);
+            table.addInstruction(&code[32], 0xF100);
+            table.endBlock(&code[40]);
+
+            TargetAddress pc = 0;
+            TargetAddress block = 0;
+            Assert::IsTrue(table.lookup(&code[0], &pc, &block) && pc == 0xF000 && block == 0xF000, L"Block start should map to its first instruction");
+            Assert::IsTrue(table.lookup(&code[9], &pc, &block) && pc == 0xF000, L"Code should map to the instruction it was translated from");
+            Assert::IsTrue(table.lookup(&code[10], &pc, &block) && pc == 0xF002, L"Instruction start should map to that instruction");
+            Assert::IsTrue(table.lookup(&code[19], &pc, &block) && pc == 0xF004 && block == 0xF000, L"Block tail should map to its last instruction");
+            Assert::IsTrue(table.lookup(&code[35], &pc, &block) && pc == 0xF100 && block == 0xF100, L"Later blocks should be found");
+        }
+
+        TEST_METHOD(TestLookupOutsideBlocks)
+        {
+            uint8_t code[64];
+            GuestPCTable table;
+
+            table.beginBlock(&code[8]);
+            table.addInstruction(&code[8], 0xF000);
+            table.endBlock(&code[16]);
+
+            TargetAddress pc = 0;
+            TargetAddress block = 0;
+            Assert::IsFalse(table.lookup(&code[0], &pc, &block), L"Code before the first block should not be found");
+            Assert::IsFalse(table.lookup(&code[16], &pc, &block), L"Code after the last block should not be found");
+        }
+
+    };
+}
@@ -0,0 +1,606 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../jitlib/assembler_x86.h"
+#include "../jitlib/jitter6502.h"
+#include "../jitlib/jitvm.h"
+#include "../jitlib/systemmemory.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace jittests
+{
+    TEST_CLASS(Jitter6502Test)
+    {
+    public:
+
+        // Notes what the guest state looked like to it when it was called
+        class WitnessDevice : public SystemMemory::IOHandler
+        {
+        public:
+            WitnessDevice(Jitter6502 *jitter) : jitter_(jitter) {}
+
+            virtual auto read(TargetAddress addr)->uint8_t override
+            {
+                readPC = jitter_->currentPC();
+                readCycle = jitter_->currentCycle();
+                readAddress = addr;
+                return 0x80;
+            }
+
+            virtual auto write(TargetAddress addr, uint8_t data)->void override
+            {
+                writePC = jitter_->currentPC();
+                writeCycle = jitter_->currentCycle();
+                writeAddress = addr;
+                written = data;
+            }
+
+            TargetAddress readPC = 0;
+            TargetAddress writePC = 0;
+            uint64_t readCycle = 0;
+            uint64_t writeCycle = 0;
+            TargetAddress readAddress = 0;
+            TargetAddress writeAddress = 0;
+            uint8_t written = 0;
+
+        private:
+            Jitter6502 *jitter_;
+        };
+
+        // A ROM at $FF00 holding program, with the reset vector pointing at it
+        static std::vector<uint8_t> rom(std::vector<uint8_t> program)
+        {
+            program.resize(0x100, 0xEA);
+            program[0xFC] = 0x00;
+            program[0xFD] = 0xFF;
+            return program;
+        }
+
+        TEST_METHOD(TestIdleLoopSkipsToEvents)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // FF00: LDA #$01; JMP $FF00
+            memory.installROM(0xFF00, rom({ 0xA9, 0x01, 0x4C, 0x00, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+
+            std::vector<uint64_t> fired;
+            jitter.scheduler().schedule(1000, [&](uint64_t due) { fired.push_back(jitter.scheduler().now()); });
+            jitter.scheduler().schedule(2500, [&](uint64_t due) { fired.push_back(jitter.scheduler().now()); });
+
+            auto status = jitter.run(1000000);
+            auto &context = jitter.context();
+            auto stats = jitter.stats();
+
+            Assert::IsTrue(status == CycleLimitReached, L"An idle loop should run to the cycle limit");
+            Assert::IsTrue(context.cpu.cycles == 1000000 && context.instructions == 400000, L"Skipped trips should be counted as run");
+            Assert::IsTrue(fired == std::vector<uint64_t>({ 1000, 2500 }), L"Events should fire on the trip that reaches them");
+            Assert::IsTrue(stats.idleLoops == 1 && stats.dispatches == 3, L"The loop should run once per deadline, not once per trip");
+            Assert::IsTrue(context.cpu.a == 0x01 && context.cpu.pc == 0xFF00, L"The CPU should be left as the loop leaves it");
+
+            // FF00: LDA $10; BEQ $FF00; LDA $11; BEQ $FF00, with $10 = 1 and $11 = 0:
+            // each trip goes round by the second branch, never the first
+            SystemMemory twoWays;
+            twoWays.installRAM(0x0000, 0x100);
+            twoWays.installROM(0xFF00, rom({ 0xA5, 0x10, 0xF0, 0xFC, 0xA5, 0x11, 0xF0, 0xF8 }));
+            twoWays.writeByte(0x10, 0x01);
+            twoWays.writeByte(0x11, 0x00);
+
+            Jitter6502 twoWayJitter(&vm, &assembler, &twoWays);
+            twoWayJitter.reset();
+
+            twoWayJitter.run(1100);
+            Assert::IsTrue(twoWayJitter.context().cpu.cycles == 1100 && twoWayJitter.context().instructions == 400, L"A trip should cost what the way back taken costs");
+        }
+
+        TEST_METHOD(TestBanksKeepTheirTranslations)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // Each bank loads its own number and jumps to a trap at $FF00
+            memory.installROM(0xFF00, rom({ 0x4C, 0x00, 0xFF }));
+            auto window = memory.installBankWindow(0x8000, 0x100);
+            auto first = memory.addROMBank(window, rom({ 0xA9, 0x01, 0x4C, 0x00, 0xFF }));
+            auto second = memory.addROMBank(window, rom({ 0xA9, 0x02, 0x4C, 0x00, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            auto &context = jitter.context();
+            auto runBank = [&](SystemMemory::BankId bank) {
+                memory.selectBank(window, bank);
+                context.cpu.pc = 0x8000;
+                jitter.run(UINT64_MAX);
+                return context.cpu.a;
+            };
+
+            Assert::IsTrue(runBank(first) == 0x01 && runBank(second) == 0x02, L"Each bank should run its own code");
+            auto compiled = jitter.stats().blocksCompiled;
+            Assert::IsTrue(runBank(first) == 0x01 && runBank(second) == 0x02, L"Switching back should run the bank's code again");
+            Assert::IsTrue(compiled == 3 && jitter.stats().blocksCompiled == compiled, L"Switching back should reuse the bank's translations");
+        }
+
+        TEST_METHOD(TestInvalidOpcodeExits)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // FF00: LDA #$01; then an opcode with no translation
+            memory.installROM(0xFF00, rom({ 0xA9, 0x01, 0x02 }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(1000) == InvalidOpcode, L"An invalid opcode should stop the run");
+            Assert::IsTrue(context.cpu.pc == 0xFF02 && context.cpu.a == 0x01 && context.instructions == 1, L"The guest should stop at the opcode, with what ran before it retired");
+            Assert::IsTrue(context.exitReason == ExitNone, L"The dispatcher should clear the exit reason");
+
+            Assert::IsTrue(jitter.run(1000) == InvalidOpcode && context.cpu.pc == 0xFF02, L"Running again should stop at the opcode again");
+            Assert::IsTrue(jitter.run(1000) == InvalidOpcode && jitter.stats().blocksCompiled == 2, L"Stopping should reuse the translation");
+        }
+
+        TEST_METHOD(TestIRQ)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x200);
+
+            // FF00: LDA #$01; JMP $FF00, with the IRQ handler at
+            // FF10: LDA #$02; JMP $FF10
+            auto program = rom({ 0xA9, 0x01, 0x4C, 0x00, 0xFF });
+            program[0x10] = 0xA9;
+            program[0x11] = 0x02;
+            program[0x12] = 0x4C;
+            program[0x13] = 0x10;
+            program[0x14] = 0xFF;
+            program[0xFE] = 0x10;
+            program[0xFF] = 0xFF;
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            jitter.scheduler().schedule(100, [&](uint64_t) { jitter.setIRQ(true); });
+            jitter.run(50);
+            Assert::IsTrue(context.cpu.a == 0x01, L"Nothing should interrupt the guest before the IRQ");
+
+            // Masked until the guest clears I
+            jitter.run(200);
+            Assert::IsTrue(context.cpu.a == 0x01, L"IRQ should be masked by the I flag");
+
+            context.cpu.p &= ~M6502_INTERRUPT;
+            jitter.run(300);
+            Assert::IsTrue(context.cpu.a == 0x02 && (context.cpu.p & M6502_INTERRUPT) != 0, L"IRQ should enter the handler and set I");
+            Assert::IsTrue(context.cpu.s == 0xFA && memory.readWord(0x01FC) == 0xFF00, L"IRQ should push the return address");
+            Assert::IsTrue((memory.readByte(0x01FB) & M6502_BRK) == 0, L"IRQ should push P with B clear");
+        }
+
+        TEST_METHOD(TestDevicesSeeExactState)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x100);
+
+            // FF00: LDA #$01; STA $0010; LDA #$02; STA $D000; LDA $D001; JMP $FF10
+            // FF10: JMP $FF10
+            auto program = rom({ 0xA9, 0x01, 0x8D, 0x10, 0x00, 0xA9, 0x02, 0x8D, 0x00, 0xD0, 0xAD, 0x01, 0xD0, 0x4C, 0x10, 0xFF });
+            program[0x10] = 0x4C;
+            program[0x11] = 0x10;
+            program[0x12] = 0xFF;
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+
+            WitnessDevice device(&jitter);
+            memory.installIO(0xD000, 0x10, &device);
+
+            Assert::IsTrue(jitter.run(1000) == Trapped, L"The program should run to its trap");
+            Assert::IsTrue(memory.readByte(0x0010) == 0x01, L"STA should store A to RAM");
+            Assert::IsTrue(device.written == 0x02 && device.writePC == 0xFF07 && device.writeCycle == 11, L"A device write should see the PC and cycle of the access");
+            Assert::IsTrue(device.readPC == 0xFF0A && device.readCycle == 15, L"A device read should see the PC and cycle of the access");
+            Assert::IsTrue(device.writeAddress == 0xD000 && device.readAddress == 0xD001, L"Devices should be passed the address accessed");
+            Assert::IsTrue(jitter.context().cpu.a == 0x80 && (jitter.context().cpu.p & M6502_SIGN) != 0, L"LDA should load from the device and set flags");
+            Assert::IsTrue(jitter.currentCycle() == jitter.context().cpu.cycles, L"Outside device calls the context should be current");
+        }
+
+        TEST_METHOD(TestSubroutineCopyLoop)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x200);
+
+            // FF00: LDX #$00; JSR $FF10; JMP $FF05
+            // FF10: LDA $FF20,X; STA $0010,X; INX; CPX #$04; BNE $FF10; RTS
+            auto program = rom({ 0xA2, 0x00, 0x20, 0x10, 0xFF, 0x4C, 0x05, 0xFF });
+            auto copy = std::vector<uint8_t>{ 0xBD, 0x20, 0xFF, 0x9D, 0x10, 0x00, 0xE8, 0xE0, 0x04, 0xD0, 0xF5, 0x60, 0, 0, 0, 0, 0x11, 0x22, 0x33, 0x44 };
+            std::copy(begin(copy), end(copy), begin(program) + 0x10);
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(1000) == Trapped && context.cpu.pc == 0xFF05, L"The program should return to its trap");
+            Assert::IsTrue(memory.readWord(0x0010) == 0x2211 && memory.readWord(0x0012) == 0x4433, L"The loop should copy the table");
+            Assert::IsTrue(context.cpu.x == 0x04 && context.cpu.s == 0xFD && (context.cpu.p & M6502_ZERO) != 0, L"X, S and the flags should be as the loop leaves them");
+            Assert::IsTrue(context.cpu.cycles == 77 && context.instructions == 23, L"Taken branches should cost a cycle more");
+        }
+
+        TEST_METHOD(TestDecimalModeTranslatedSeparately)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // FF00: CLC; LDA #$19; ADC #$28; JMP $FF08
+            // FF08: JMP $FF08
+            memory.installROM(0xFF00, rom({ 0x18, 0xA9, 0x19, 0x69, 0x28, 0x4C, 0x08, 0xFF, 0x4C, 0x08, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            auto &context = jitter.context();
+            auto add = [&](bool decimal) {
+                context.cpu.pc = 0xFF00;
+                context.cpu.p = decimal ? context.cpu.p | M6502_DECIMAL : context.cpu.p & ~M6502_DECIMAL;
+                jitter.run(UINT64_MAX);
+                return context.cpu.a;
+            };
+
+            Assert::IsTrue(add(false) == 0x41 && jitter.stats().blocksCompiled == 2, L"With D clear ADC should add in binary");
+            Assert::IsTrue(add(true) == 0x47 && jitter.stats().blocksCompiled == 3, L"With D set ADC should add in decimal, in a translation of its own");
+            Assert::IsTrue(add(false) == 0x41 && add(true) == 0x47 && jitter.stats().blocksCompiled == 3, L"Both translations should be kept, and blocks without ADC shared");
+        }
+
+        TEST_METHOD(TestCpuModels)
+        {
+            auto run = [](CpuModel model, std::vector<uint8_t> program, VMContext *context) {
+                JitVM vm(1024 * 1024);
+                AssemblerX86 assembler(&vm);
+                SystemMemory memory;
+                memory.installRAM(0x0000, 0x200);
+                memory.installROM(0xFF00, rom(program));
+
+                Jitter6502 jitter(&vm, &assembler, &memory, model);
+                jitter.reset();
+                auto status = jitter.run(UINT64_MAX);
+                *context = jitter.context();
+                return status;
+            };
+            auto context = VMContext{};
+
+            // SED; CLC; LDA #$99; ADC #$01; JMP $FF06
+            auto decimal = std::vector<uint8_t>{ 0xF8, 0x18, 0xA9, 0x99, 0x69, 0x01, 0x4C, 0x06, 0xFF };
+            run(CPU_NMOS, decimal, &context);
+            Assert::IsTrue(context.cpu.a == 0x00 && (context.cpu.p & M6502_ZERO) == 0, L"The NMOS 6502 should set Z from the binary sum");
+            run(CPU_65C02, decimal, &context);
+            Assert::IsTrue(context.cpu.a == 0x00 && (context.cpu.p & M6502_ZERO) != 0, L"The 65C02 should set Z from the decimal sum");
+
+            // SED; CLC; LDA #$00; SBC #$0A; JMP $FF06, subtracting a digit that is not BCD
+            auto notBCD = std::vector<uint8_t>{ 0xF8, 0x18, 0xA9, 0x00, 0xE9, 0x0A, 0x4C, 0x06, 0xFF };
+            run(CPU_NMOS, notBCD, &context);
+            Assert::IsTrue(context.cpu.a == 0x9F && (context.cpu.p & M6502_CARRY) == 0, L"The NMOS 6502 should correct each digit that borrows");
+            run(CPU_65C02, notBCD, &context);
+            Assert::IsTrue(context.cpu.a == 0x8F && (context.cpu.p & M6502_CARRY) == 0, L"The 65C02 should correct the whole difference");
+
+            // LDA #$42; STA $10; LAX $10; JMP $FF06
+            auto lax = std::vector<uint8_t>{ 0xA9, 0x42, 0x85, 0x10, 0xA7, 0x10, 0x4C, 0x06, 0xFF };
+            Assert::IsTrue(run(CPU_NMOS, lax, &context) == InvalidOpcode && context.cpu.pc == 0xFF04, L"Undocumented opcodes should be invalid unless asked for");
+            Assert::IsTrue(run(CPU_NMOS_UNDOCUMENTED, lax, &context) == Trapped && context.cpu.x == 0x42, L"LAX should load A and X");
+
+            // LDX #$03; PHX; PLY; STZ $10; LDA #$0F; TSB $10; LDA $10; BRA $FF0C
+            auto cmos = std::vector<uint8_t>{ 0xA2, 0x03, 0xDA, 0x7A, 0x64, 0x10, 0xA9, 0x0F, 0x04, 0x10, 0xA5, 0x10, 0x80, 0xFE };
+            Assert::IsTrue(run(CPU_NMOS, cmos, &context) == InvalidOpcode && context.cpu.pc == 0xFF02, L"The NMOS 6502 has no PHX");
+            Assert::IsTrue(run(CPU_65C02, cmos, &context) == Trapped && context.cpu.y == 0x03 && context.cpu.a == 0x0F, L"The 65C02 instructions should be translated");
+        }
+
+        TEST_METHOD(TestIdleLoopWithNothingScheduledTraps)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installROM(0xFF00, rom({ 0xA9, 0x01, 0x4C, 0x00, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped, L"An idle loop nothing can wake should trap");
+        }
+
+        TEST_METHOD(TestBlockMoveLoops)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x600);
+            for (auto i = 0; i < 0x100; i++) {
+                memory.writeByte(static_cast<TargetAddress>(0x0180 + i), static_cast<uint8_t>(i ^ 0x5A));
+            }
+
+            // FF00: LDX #$00; LDA $0180,X; STA $0300,X; INX; BNE $FF02
+            // FF0B: LDA #$00; STA $10; LDA #$04; STA $11; LDY #$80; LDA #$E5
+            // FF17: STA ($10),Y; INY; BNE $FF17; NOP; JMP $FF1D
+            memory.installROM(0xFF00, rom({
+                0xA2, 0x00, 0xBD, 0x80, 0x01, 0x9D, 0x00, 0x03, 0xE8, 0xD0, 0xF7,
+                0xA9, 0x00, 0x85, 0x10, 0xA9, 0x04, 0x85, 0x11, 0xA0, 0x80, 0xA9, 0xE5,
+                0x91, 0x10, 0xC8, 0xD0, 0xFB, 0xEA, 0x4C, 0x1D, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.pc == 0xFF1D, L"The program should run to its trap");
+            auto copied = true;
+            for (auto i = 0; i < 0x100; i++) {
+                copied = copied && memory.readByte(static_cast<TargetAddress>(0x0300 + i)) == (i ^ 0x5A);
+            }
+            Assert::IsTrue(copied, L"The copy loop should copy the page");
+            Assert::IsTrue(memory.readByte(0x047F) == 0x00 && memory.readByte(0x0480) == 0xE5 && memory.readByte(0x04FF) == 0xE5, L"The fill loop should fill from Y");
+            Assert::IsTrue(context.cpu.x == 0x00 && context.cpu.y == 0x00 && context.cpu.a == 0xE5 && (context.cpu.p & (M6502_ZERO | M6502_SIGN)) == M6502_ZERO, L"Registers and flags should be as the last trips leave them");
+
+            // Taken branches, and loads indexed across a page, cost a cycle more
+            Assert::IsTrue(context.cpu.cycles == 5139 && context.instructions == 1417, L"Moving at once should take the cycles the loops would");
+            Assert::IsTrue(jitter.stats().blockMoveBytes == 0x180, L"Both loops should be moved at once");
+
+            // With the fill pointing at a device, the loop runs a trip at a time
+            WitnessDevice device(&jitter);
+            memory.installIO(0xD000, 0x100, &device);
+            memory.writeByte(0x0011, 0xD0);
+            context.cpu.pc = 0xFF13;
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.cycles == 5139 + 1416, L"The program should run to its trap again");
+            Assert::IsTrue(device.written == 0xE5 && device.writePC == 0xFF17 && context.cpu.y == 0x00, L"The device should see the fill's stores");
+            Assert::IsTrue(jitter.stats().blockMoveBytes == 0x180, L"Only the first fill should be moved at once");
+        }
+
+        TEST_METHOD(TestWordOperations)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x100);
+            memory.writeWord(0x0010, 0xFFF0);
+            memory.writeWord(0x0012, 0x1230);
+            memory.writeWord(0x0014, 0x0000);
+            memory.writeByte(0x0016, 0x01);
+
+            // FF00: LDA $14; SEC; SBC #$01; STA $14; LDA $15; SBC #$00; STA $15; LDA $16; SBC #$00; STA $16
+            // FF13: CLC; LDA $10; ADC #$34; STA $10; LDA $11; ADC #$12; STA $11
+            // FF20: LDA $10; CMP $12; LDA $11; SBC $13; JMP $FF28
+            memory.installROM(0xFF00, rom({
+                0xA5, 0x14, 0x38, 0xE9, 0x01, 0x85, 0x14, 0xA5, 0x15, 0xE9, 0x00, 0x85, 0x15, 0xA5, 0x16, 0xE9, 0x00, 0x85, 0x16,
+                0x18, 0xA5, 0x10, 0x69, 0x34, 0x85, 0x10, 0xA5, 0x11, 0x69, 0x12, 0x85, 0x11,
+                0xA5, 0x10, 0xC5, 0x12, 0xA5, 0x11, 0xE5, 0x13, 0x4C, 0x28, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.pc == 0xFF28, L"The program should run to its trap");
+            Assert::IsTrue(memory.readWord(0x0014) == 0xFFFF && memory.readByte(0x0016) == 0x00, L"The borrow should ripple through all three bytes");
+            Assert::IsTrue(memory.readWord(0x0010) == 0x1224, L"The carry should ripple from the low byte to the high");
+            Assert::IsTrue(context.cpu.a == 0xFF && (context.cpu.p & (M6502_CARRY | M6502_ZERO | M6502_OVERFLOW | M6502_SIGN)) == M6502_SIGN, L"The compare should leave A and the flags of its high byte");
+            Assert::IsTrue(context.cpu.cycles == 59 && context.instructions == 22, L"Fused instructions should take their own cycles");
+            Assert::IsTrue(jitter.stats().wordOperations == 3, L"Each chain should be translated as one");
+        }
+
+        TEST_METHOD(TestNativeLoops)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // FF00: LDX #$10; DEX; BNE $FF02; JMP $FF05
+            memory.installROM(0xFF00, rom({ 0xA2, 0x10, 0xCA, 0xD0, 0xFD, 0x4C, 0x05, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.x == 0x00, L"The loop should count down to its trap");
+            Assert::IsTrue(context.cpu.cycles == 84 && context.instructions == 34, L"Each trip round should add its cycles");
+            Assert::IsTrue(jitter.stats().dispatches == 1 && jitter.stats().nativeLoops == 1, L"The loop should stay in its block");
+
+            // Stopping at the deadline leaves the loop where leaving the block
+            // each trip would have
+            jitter.reset();
+            context.cpu.cycles = 0;
+            Assert::IsTrue(jitter.run(40) == CycleLimitReached && context.cpu.cycles == 42 && context.cpu.x == 0x08 && context.cpu.pc == 0xFF02, L"The loop should leave at the deadline");
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.cycles == 84 && context.cpu.x == 0x00, L"The loop should carry on from the deadline");
+        }
+
+        TEST_METHOD(TestNativeLoopAfterLongPrefix)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+
+            // FF00: NOP x 10; LDX #$10; DEX; BNE $FF0C; JMP $FF0F
+            auto program = std::vector<uint8_t>(10, 0xEA);
+            auto rest = std::vector<uint8_t>{ 0xA2, 0x10, 0xCA, 0xD0, 0xFD, 0x4C, 0x0F, 0xFF };
+            program.insert(end(program), begin(rest), end(rest));
+            memory.installROM(0xFF00, rom(program));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            // The cycles ahead of the loop, more than a trip's, count towards
+            // the deadline as they would leaving the block each trip
+            Assert::IsTrue(jitter.run(40) == CycleLimitReached && context.cpu.cycles == 42 && context.cpu.x == 0x0C && context.cpu.pc == 0xFF0C, L"The loop should leave at the deadline");
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.cycles == 104 && context.cpu.x == 0x00, L"The loop should carry on from the deadline");
+            Assert::IsTrue(jitter.stats().nativeLoops == 2, L"The loop should stay in its block each time");
+        }
+
+        TEST_METHOD(TestBlockMoveAfterBlockStart)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x400);
+
+            // FF00: NOP x 10; LDY #$00; LDA #$E5; STA $0300,Y; INY; BNE $FF0E; JMP $FF14
+            auto program = std::vector<uint8_t>(10, 0xEA);
+            auto rest = std::vector<uint8_t>{ 0xA0, 0x00, 0xA9, 0xE5, 0x99, 0x00, 0x03, 0xC8, 0xD0, 0xFA, 0x4C, 0x14, 0xFF };
+            program.insert(end(program), begin(rest), end(rest));
+            memory.installROM(0xFF00, rom(program));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            // The fill alone would end before the deadline, but not with the
+            // 24 cycles ahead of it, so it goes a trip at a time
+            Assert::IsTrue(jitter.run(2570) == CycleLimitReached && context.cpu.cycles == 2574 && context.cpu.y == 0xFF && context.cpu.pc == 0xFF0E, L"The fill should stop at the deadline");
+            Assert::IsTrue(jitter.stats().blockMoveBytes == 0, L"The fill should not be moved at once past the deadline");
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.cycles == 2583 && memory.readByte(0x03FF) == 0xE5, L"The fill should carry on from the deadline");
+        }
+
+        TEST_METHOD(TestBlockMoveSparesTranslatedCode)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x400);
+
+            // 0300: JMP $FF03
+            memory.writeByte(0x0300, 0x4C);
+            memory.writeByte(0x0301, 0x03);
+            memory.writeByte(0x0302, 0xFF);
+
+            // FF00: JMP $0300; LDY #$00; LDA #$E5; STA $0300,Y; INY; BNE $FF07; JMP $FF0D
+            memory.installROM(0xFF00, rom({ 0x4C, 0x00, 0x03, 0xA0, 0x00, 0xA9, 0xE5, 0x99, 0x00, 0x03, 0xC8, 0xD0, 0xFA, 0x4C, 0x0D, 0xFF }));
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && memory.readByte(0x0300) == 0xE5 && memory.readByte(0x03FF) == 0xE5, L"The fill should run to the end");
+            Assert::IsTrue(jitter.stats().blockMoveBytes == 0, L"A fill over translated code should go a trip at a time");
+        }
+
+        TEST_METHOD(TestNativeLoopTakesIRQ)
+        {
+            // Raises IRQ when 3 is written to it
+            class RaisingDevice : public SystemMemory::IOHandler
+            {
+            public:
+                RaisingDevice(Jitter6502 *jitter) : jitter_(jitter) {}
+                virtual auto read(TargetAddress addr)->uint8_t override { return 0; }
+                virtual auto write(TargetAddress addr, uint8_t data)->void override
+                {
+                    if (data == 0x03) {
+                        jitter_->setIRQ(true);
+                    }
+                }
+
+            private:
+                Jitter6502 *jitter_;
+            };
+
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x200);
+
+            // FF00: CLI; LDX #$05; STX $D000; DEX; BNE $FF03; JMP $FF09
+            // FF40: JMP $FF40
+            auto program = rom({ 0x58, 0xA2, 0x05, 0x8E, 0x00, 0xD0, 0xCA, 0xD0, 0xFA, 0x4C, 0x09, 0xFF });
+            program[0x40] = 0x4C;
+            program[0x41] = 0x40;
+            program[0x42] = 0xFF;
+            program[0xFE] = 0x40;
+            program[0xFF] = 0xFF;
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            RaisingDevice device(&jitter);
+            memory.installIO(0xD000, 0x10, &device);
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.pc == 0xFF40, L"The IRQ handler should be entered");
+            Assert::IsTrue(context.cpu.x == 0x02 && memory.readWord(0x01FC) == 0xFF03, L"The IRQ should be taken at the end of the trip raising it");
+        }
+
+        TEST_METHOD(TestROMReadsFolded)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x100);
+            memory.writeByte(0x0010, 0x10);
+            memory.writeWord(0x0012, 0xFF20);
+
+            // FF00: LDA $FF80; LDX $FF81; ORA $0010; JMP ($FF82)
+            // FF10: JMP ($0012)
+            // FF20: JMP $FF20
+            // FF80: $42, $07, .word $FF10
+            auto program = rom({ 0xAD, 0x80, 0xFF, 0xAE, 0x81, 0xFF, 0x0D, 0x10, 0x00, 0x6C, 0x82, 0xFF });
+            auto rest = std::vector<uint8_t>{ 0x6C, 0x12, 0x00 };
+            std::copy(begin(rest), end(rest), begin(program) + 0x10);
+            rest = { 0x4C, 0x20, 0xFF };
+            std::copy(begin(rest), end(rest), begin(program) + 0x20);
+            rest = { 0x42, 0x07, 0x10, 0xFF };
+            std::copy(begin(rest), end(rest), begin(program) + 0x80);
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.pc == 0xFF20, L"Both indirect jumps should be followed");
+            Assert::IsTrue(context.cpu.a == 0x52 && context.cpu.x == 0x07, L"Reads of ROM and RAM should both load");
+            Assert::IsTrue(context.cpu.cycles == 22 && context.instructions == 5, L"Folded reads should cost their cycles");
+            Assert::IsTrue(jitter.stats().romReadsFolded == 4, L"Only the reads of ROM should be folded");
+        }
+
+        TEST_METHOD(TestPretranslate)
+        {
+            JitVM vm(1024 * 1024);
+            AssemblerX86 assembler(&vm);
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x1000);
+
+            // FF00: JSR $FF10; BEQ $FF08; JMP ($FF80)
+            // FF08: JMP $FF08
+            // FF10: LDA #$00; RTS
+            // FF20: SED; JMP $FF30
+            // FF30: ADC #$01; JMP $0200
+            // FF80: .word $FF20
+            auto program = rom({ 0x20, 0x10, 0xFF, 0xF0, 0x03, 0x6C, 0x80, 0xFF, 0x4C, 0x08, 0xFF });
+            auto rest = std::vector<uint8_t>{ 0xA9, 0x00, 0x60 };
+            std::copy(begin(rest), end(rest), begin(program) + 0x10);
+            rest = { 0xF8, 0x4C, 0x30, 0xFF };
+            std::copy(begin(rest), end(rest), begin(program) + 0x20);
+            rest = { 0x69, 0x01, 0x4C, 0x00, 0x02 };
+            std::copy(begin(rest), end(rest), begin(program) + 0x30);
+            rest = { 0x20, 0xFF };
+            std::copy(begin(rest), end(rest), begin(program) + 0x80);
+            memory.installROM(0xFF00, program);
+
+            Jitter6502 jitter(&vm, &assembler, &memory);
+            jitter.reset();
+            auto &context = jitter.context();
+
+            Assert::IsTrue(jitter.pretranslate() == 6, L"Every block reachable in ROM, and none in RAM, should be translated");
+            Assert::IsTrue(jitter.pretranslate() == 0, L"Blocks already translated should not be again");
+            Assert::IsTrue(jitter.stats().pretranslatedBlocks == 6, L"Pretranslated blocks should be counted");
+
+            Assert::IsTrue(jitter.run(UINT64_MAX) == Trapped && context.cpu.pc == 0xFF08, L"The program should run to its trap");
+            Assert::IsTrue(jitter.stats().dispatcherMisses == 0 && jitter.stats().blocksCompiled == 6, L"Running should translate nothing more");
+        }
+    };
+}
@@ -0,0 +1,48 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../jitlib/opcodes.h"
+
+#include <stdint.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace jittests
+{
+    TEST_CLASS(OpcodesTest)
+    {
+    public:
+
+        TEST_METHOD(TestDocumentedOpcodes)
+        {
+            auto documented = 0;
+            for (auto &info : OPCODES) {
+                if (info.flow != FlowInvalid) {
+                    documented++;
+                    Assert::IsTrue(info.cycles >= 2 && info.cycles <= 7, L"Documented opcodes take 2 to 7 cycles");
+                }
+            }
+            Assert::IsTrue(documented == 151, L"The NMOS 6502 documents 151 opcodes");
+
+            Assert::IsTrue(OPCODES[0x20].flow == FlowCall && OPCODES[0x60].flow == FlowReturn, L"JSR and RTS should be a call and a return");
+            Assert::IsTrue(OPCODES[0xE8].registersRead == M6502_X && OPCODES[0xE8].registersWritten == M6502_X, L"INX should read and write X");
+            Assert::IsTrue(OPCODES[0x91].registersRead == (M6502_A | M6502_Y) && OPCODES[0x91].access == AccessWrite, L"STA (zp),Y should read A and Y and write memory");
+        }
+
+        TEST_METHOD(TestDisassemble)
+        {
+            const uint8_t lda[] = { 0xBD, 0x34, 0x12 };
+            const uint8_t bne[] = { 0xD0, 0xFC, 0x00 };
+            const uint8_t jmp[] = { 0x6C, 0xFC, 0xFF };
+            const uint8_t invalid[] = { 0x02, 0x00, 0x00 };
+
+            Assert::IsTrue(disassemble(0x0200, lda) == "LDA $1234,X", L"Absolute indexed operands should be shown");
+            Assert::IsTrue(disassemble(0x0200, bne) == "BNE $01FE", L"Branches should show their target");
+            Assert::IsTrue(disassemble(0x0200, jmp) == "JMP ($FFFC)", L"Indirect operands should be bracketed");
+            Assert::IsTrue(disassemble(0x0200, invalid) == "???", L"Invalid opcodes should be marked");
+
+            const uint8_t jmpIndexed[] = { 0x7C, 0x34, 0x12 };
+            Assert::IsTrue(disassemble(0x0200, jmpIndexed, CPU_65C02) == "JMP ($1234,X)", L"The 65C02's modes should be shown");
+            Assert::IsTrue(disassemble(0x0200, invalid, CPU_65C02) == "NOP #$00", L"The 65C02 has no invalid opcodes");
+        }
+    };
+}
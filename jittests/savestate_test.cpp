@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../jitlib/savestate.h"
+#include "../jitlib/systemmemory.h"
+
+#include <stdexcept>
+#include <stdio.h>
+#include <vector>
+
+using std::runtime_error;
+using std::vector;
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace jittests
+{
+    TEST_CLASS(SaveStateTest)
+    {
+    public:
+
+        TEST_METHOD(TestCpuRoundTrip)
+        {
+            SystemMemory memory;
+            vector<uint8_t> ROM;
+            ROM.resize(512);
+            memory.installROM(0xFE00, ROM);
+
+            auto saved = CpuState{ 0x12, 0x34, 0x56, 0xFD, 0x24, 0xFE00, 0x123456789ull };
+            saveMachineState(PATH, saved, memory);
+
+            auto restored = CpuState{};
+            loadMachineState(PATH, &restored, &memory);
+            remove(PATH);
+
+            Assert::IsTrue(restored.a == saved.a && restored.x == saved.x && restored.y == saved.y, L"Registers should round trip");
+            Assert::IsTrue(restored.s == saved.s && restored.p == saved.p, L"Stack and flags should round trip");
+            Assert::IsTrue(restored.pc == saved.pc && restored.cycles == saved.cycles, L"PC and cycles should round trip");
+        }
+
+        TEST_METHOD(TestMismatchedMemoryMap)
+        {
+            SystemMemory memory;
+            vector<uint8_t> ROM;
+            ROM.resize(512);
+            memory.installROM(0xFE00, ROM);
+
+            saveMachineState(PATH, CpuState{}, memory);
+
+            SystemMemory other;
+            auto restored = CpuState{};
+            auto threw = false;
+            try {
+                loadMachineState(PATH, &restored, &other);
+            }
+            catch (runtime_error) {
+                threw = true;
+            }
+            remove(PATH);
+
+            Assert::IsTrue(threw, L"Restoring into different hardware should throw exception");
+        }
+
+        TEST_METHOD(TestRAMRoundTrip)
+        {
+            // $D000-$D07F is RAM sharing its page with ROM, so the page is mixed
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x800);
+            memory.installRAM(0xD000, 0x80);
+            memory.installROM(0xD080, vector<uint8_t>(0x80, 0xEA));
+            memory.writeByte(0x0010, 0x11);
+            memory.writeByte(0x07FF, 0x22);
+            memory.writeByte(0xD040, 0x33);
+
+            saveMachineState(PATH, CpuState{}, memory);
+
+            memory.fill(0x0000, 0x00, 0x800);
+            memory.writeByte(0xD040, 0x00);
+
+            auto restored = CpuState{};
+            loadMachineState(PATH, &restored, &memory);
+            remove(PATH);
+
+            Assert::IsTrue(memory.readByte(0x0010) == 0x11 && memory.readByte(0x07FF) == 0x22, L"RAM pages should round trip");
+            Assert::IsTrue(memory.readByte(0xD040) == 0x33, L"RAM in a mixed page should round trip");
+            Assert::IsTrue(memory.readByte(0xD0C0) == 0xEA, L"ROM in a mixed page should be left alone");
+        }
+
+        TEST_METHOD(TestUnknownSectionsSkipped)
+        {
+            SystemMemory memory;
+
+            {
+                SaveStateWriter writer(PATH);
+                writer.beginSection(saveStateId('F', 'U', 'T', 'R'), 7);
+                writer.write32(0xDEADBEEF);
+                writer.write8(1);
+                writer.endSection();
+
+                writer.beginSection(CpuSectionId, 1);
+                for (auto i = 0; i < 16; i++) {
+                    writer.write8(i == 0 ? 0x42 : 0);
+                }
+                writer.endSection();
+
+                memory.saveState(&writer);
+                writer.close();
+            }
+
+            auto restored = CpuState{};
+            loadMachineState(PATH, &restored, &memory);
+            remove(PATH);
+
+            Assert::IsTrue(restored.a == 0x42, L"Unknown sections should be skipped");
+        }
+
+        TEST_METHOD(TestBankRoundTrip)
+        {
+            SystemMemory memory;
+            auto window = memory.installBankWindow(0x8000, 0x400);
+            auto rom = memory.addROMBank(window, vector<uint8_t>(0x400, 0xEA));
+            auto ram = memory.addRAMBank(window);
+            memory.selectBank(window, ram);
+            memory.writeByte(0x8123, 0x5A);
+
+            saveMachineState(PATH, CpuState{}, memory);
+
+            memory.writeByte(0x8123, 0x00);
+            memory.selectBank(window, rom);
+
+            auto restored = CpuState{};
+            loadMachineState(PATH, &restored, &memory);
+            remove(PATH);
+
+            Assert::IsTrue(memory.selectedBank(window) == ram, L"The selected bank should round trip");
+            Assert::IsTrue(memory.readByte(0x8123) == 0x5A, L"RAM banks should round trip");
+        }
+
+    private:
+        static constexpr const char *PATH = "savestate_test.j6s";
+    };
+}
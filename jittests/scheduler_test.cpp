@@ -0,0 +1,79 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+#include "../jitlib/scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace jittests
+{
+    TEST_CLASS(SchedulerTest)
+    {
+    public:
+
+        TEST_METHOD(TestEventsFireInCycleOrder)
+        {
+            uint64_t cycles = 0;
+            Scheduler scheduler([&] { return cycles; });
+            std::vector<int> fired;
+
+            scheduler.schedule(300, [&](uint64_t) { fired.push_back(3); });
+            scheduler.schedule(100, [&](uint64_t) { fired.push_back(1); });
+            scheduler.schedule(200, [&](uint64_t) { fired.push_back(2); });
+            scheduler.schedule(200, [&](uint64_t) { fired.push_back(4); });
+            Assert::IsTrue(scheduler.nextDeadline() == 100, L"The earliest event should set the deadline");
+
+            cycles = 99;
+            scheduler.runDue();
+            Assert::IsTrue(fired.empty(), L"Events should not fire before they are due");
+
+            cycles = 205;
+            scheduler.runDue();
+            Assert::IsTrue(fired == std::vector<int>({ 1, 2, 4 }), L"Due events should fire by cycle, then in the order they were scheduled");
+            Assert::IsTrue(scheduler.nextDeadline() == 300 && scheduler.pending() == 1, L"Later events should stay pending");
+        }
+
+        TEST_METHOD(TestCancel)
+        {
+            uint64_t cycles = 0;
+            Scheduler scheduler([&] { return cycles; });
+            auto fired = 0;
+
+            auto first = scheduler.schedule(100, [&](uint64_t) { fired += 1; });
+            scheduler.schedule(200, [&](uint64_t) { fired += 10; });
+            scheduler.cancel(first);
+            scheduler.cancel(first);
+            Assert::IsTrue(scheduler.pending() == 1, L"A cancelled event should no longer be pending");
+            Assert::IsTrue(scheduler.nextDeadline() == 200, L"A cancelled event should not set the deadline");
+
+            cycles = 1000;
+            scheduler.runDue();
+            scheduler.cancel(first);
+            Assert::IsTrue(fired == 10, L"Only the remaining event should fire");
+            Assert::IsTrue(scheduler.pending() == 0 && scheduler.nextDeadline() == UINT64_MAX, L"Nothing should be left pending");
+        }
+
+        TEST_METHOD(TestRescheduleFromCallback)
+        {
+            uint64_t cycles = 0;
+            Scheduler scheduler([&] { return cycles; });
+            std::vector<uint64_t> due;
+
+            // A periodic timer, rescheduling itself against the cycle it was
+            // due at rather than the cycle it fired on
+            Scheduler::Callback tick = [&](uint64_t at) {
+                due.push_back(at);
+                scheduler.schedule(at + 50, tick);
+            };
+            scheduler.schedule(50, tick);
+
+            cycles = 160;
+            scheduler.runDue();
+            Assert::IsTrue(due == std::vector<uint64_t>({ 50, 100, 150 }), L"Events falling due during runDue should fire too");
+            Assert::IsTrue(scheduler.nextDeadline() == 200, L"The next tick should be pending");
+            Assert::IsTrue(scheduler.now() == 160, L"now() should read the clock");
+        }
+    };
+}
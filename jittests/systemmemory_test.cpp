@@ -3,6 +3,7 @@
 #include "../jitlib/systemmemory.h"
 
 #include <stdexcept>
+#include <stdio.h>
 #include <vector>
 
 using std::runtime_error;
@@ -57,5 +58,241 @@ namespace jittests
             Assert::IsTrue(threw, L"Overlapping install ranges should throw exception");
         }
 
+        TEST_METHOD(TestRAMWrites)
+        {
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x200);
+
+            memory.writeByte(0x0010, 0x42);
+            memory.writeWord(0x00FF, 0x1234);
+
+            Assert::IsTrue(memory.readByte(0x0010) == 0x42, L"RAM should hold a written byte");
+            Assert::IsTrue(memory.readByte(0x00FF) == 0x34 && memory.readByte(0x0100) == 0x12, L"Words should be written low byte first across pages");
+        }
+
+        TEST_METHOD(TestROMIgnoresWrites)
+        {
+            SystemMemory memory;
+            vector<uint8_t> ROM(0x180, 0xEA);
+            memory.installROM(0xF000, ROM);
+            memory.installRAM(0xF180, 0x80);
+
+            memory.writeByte(0xF000, 0x00);
+            memory.writeByte(0xF17F, 0x00);
+            memory.writeByte(0xF180, 0x55);
+
+            Assert::IsTrue(memory.readByte(0xF000) == 0xEA, L"Stores to a ROM page should be ignored");
+            Assert::IsTrue(memory.readByte(0xF17F) == 0xEA, L"Stores to ROM in a mixed page should be ignored");
+            Assert::IsTrue(memory.readByte(0xF180) == 0x55, L"RAM in a mixed page should be writeable");
+        }
+
+        TEST_METHOD(TestIOHandlers)
+        {
+            SystemMemory memory;
+            LatchDevice device;
+            memory.installIO(0xD000, 0x10, &device);
+
+            memory.writeByte(0xD005, 0x77);
+
+            Assert::IsTrue(device.lastAddress == 0xD005 && device.latch == 0x77, L"Stores to a device should reach its handler");
+            Assert::IsTrue(memory.readByte(0xD00F) == 0x77, L"Loads from a device should come from its handler");
+            Assert::IsTrue(memory.readByte(0xD010) == 0xFF, L"Unmapped addresses should read as 0xFF");
+        }
+
+        TEST_METHOD(TestStaticIOHandlers)
+        {
+            SystemMemory memory;
+            PlainLatch plain;
+            LatchDevice device;
+            memory.installStaticIO(0xD000, 0x10, &plain);
+            memory.installStaticIO(0xD010, 0x10, &device);
+
+            memory.writeByte(0xD001, 0x11);
+            memory.writeByte(0xD011, 0x22);
+
+            Assert::IsTrue(memory.readByte(0xD000) == 0x11 && memory.readByte(0xD01F) == 0x22, L"Devices installed by type should be read and written");
+            Assert::IsTrue(memory.deviceAt(0xD000) != nullptr && memory.deviceAt(0xD020) == nullptr, L"Device bindings should be found by address");
+
+            auto handlers = memory.ioHandlers();
+            Assert::IsTrue(handlers.size() == 1 && handlers[0].first == 0xD010, L"Only IOHandlers should be listed for save states");
+        }
+
+        TEST_METHOD(TestBlockTransfers)
+        {
+            SystemMemory memory;
+            vector<uint8_t> ROM(0x80, 0xEA);
+            memory.installROM(0xC000, ROM);
+            memory.installRAM(0xC080, 0x280);
+
+            vector<uint8_t> pattern(0x300);
+            for (auto i = size_t{ 0 }; i < pattern.size(); i++) {
+                pattern[i] = static_cast<uint8_t>(i * 7);
+            }
+            memory.writeBlock(0xC000, pattern.data(), pattern.size());
+
+            vector<uint8_t> copy(0x300);
+            memory.readBlock(0xC000, copy.data(), copy.size());
+
+            auto matches = true;
+            for (auto i = size_t{ 0 }; i < copy.size(); i++) {
+                matches = matches && copy[i] == (i < 0x80 ? 0xEA : pattern[i]);
+            }
+            Assert::IsTrue(matches, L"Block transfers should write RAM, skip ROM and read back both");
+        }
+
+        TEST_METHOD(TestIsROM)
+        {
+            SystemMemory memory;
+            memory.installROM(0xC000, vector<uint8_t>(0x180, 0xEA));
+            memory.installRAM(0xC180, 0x80);
+            auto window = memory.installBankWindow(0x8000, 0x1000);
+            memory.selectBank(window, memory.addROMBank(window, vector<uint8_t>(0x1000, 0x11)));
+
+            Assert::IsTrue(memory.isROM(0xC000) && memory.isROM(0xC0FF), L"A whole page of ROM should be ROM");
+            Assert::IsTrue(!memory.isROM(0xC100) && !memory.isROM(0xC180), L"A page shared with RAM should not be ROM");
+            Assert::IsTrue(!memory.isROM(0x8000), L"ROM switched into a bank window should not be ROM");
+            Assert::IsTrue(!memory.isROM(0x0000), L"Unmapped memory should not be ROM");
+        }
+
+        TEST_METHOD(TestFillWraps)
+        {
+            SystemMemory memory;
+            memory.installRAM(0x0000, 0x100);
+            memory.installRAM(0xFF00, 0x100);
+
+            memory.fill(0xFF80, 0xAA, 0x100);
+
+            Assert::IsTrue(memory.readByte(0xFF7F) == 0x00 && memory.readByte(0xFF80) == 0xAA, L"Fill should start at its address");
+            Assert::IsTrue(memory.readByte(0xFFFF) == 0xAA && memory.readByte(0x007F) == 0xAA, L"Fill should wrap at the top of memory");
+            Assert::IsTrue(memory.readByte(0x0080) == 0x00, L"Fill should stop after its length");
+        }
+
+        TEST_METHOD(TestInstallROMFile)
+        {
+            vector<uint8_t> image(0x400);
+            for (auto i = size_t{ 0 }; i < image.size(); i++) {
+                image[i] = static_cast<uint8_t>(i ^ (i >> 8));
+            }
+            auto file = fopen(ROM_PATH, "wb");
+            fwrite(image.data(), 1, image.size(), file);
+            fclose(file);
+
+            // The file stays mapped, and on Windows cannot be removed, until
+            // the memory installing it is gone
+            {
+                // Two whole pages mapped from the file, then half a page shared
+                // with RAM, which has to be copied
+                SystemMemory memory;
+                memory.installROMFile(ROM_PATH, 0xE000, 0x100, 0x280);
+                memory.installRAM(0xE280, 0x80);
+                memory.writeByte(0xE000, 0x00);
+                memory.writeByte(0xE280, 0x5A);
+
+                vector<uint8_t> contents(0x300);
+                memory.readBlock(0xE000, contents.data(), contents.size());
+
+                auto matches = true;
+                for (auto i = size_t{ 0 }; i < 0x280; i++) {
+                    matches = matches && contents[i] == image[0x100 + i];
+                }
+                Assert::IsTrue(matches, L"ROM should read back the file from the offset given");
+                Assert::IsTrue(contents[0x280] == 0x5A && memory.readByte(0xE27F) == image[0x37F], L"RAM should share the last ROM page");
+                Assert::IsTrue(memory.peekByte(0xE101) == image[0x201], L"Mapped pages should be visible to peekByte");
+
+                auto threw = false;
+                try {
+                    memory.installROMFile(ROM_PATH, 0xF000, 0x300, 0x200);
+                }
+                catch (runtime_error) {
+                    threw = true;
+                }
+                Assert::IsTrue(threw, L"Installing more than the file holds should throw exception");
+
+                SystemMemory whole;
+                whole.installROMFile(ROM_PATH, 0xFC00);
+                Assert::IsTrue(whole.readWord(0xFFFE) == (image[0x3FE] | image[0x3FF] << 8), L"The whole file should be installed by default");
+            }
+            remove(ROM_PATH);
+        }
+
+        TEST_METHOD(TestBankSwitching)
+        {
+            SystemMemory memory;
+            memory.installRAM(0x7F00, 0x100);
+            auto window = memory.installBankWindow(0x8000, 0x2000);
+            auto first = memory.addROMBank(window, vector<uint8_t>(0x2000, 0x11));
+            auto second = memory.addROMBank(window, vector<uint8_t>(0x2000, 0x22));
+            auto ram = memory.addRAMBank(window);
+
+            Assert::IsTrue(memory.readByte(0x8000) == 0xFF && memory.bankAt(0x8000) == SystemMemory::NO_BANK, L"A window should read as unmapped until a bank is selected");
+
+            memory.selectBank(window, second);
+            Assert::IsTrue(memory.readByte(0x9FFF) == 0x22 && memory.bankAt(0x9FFF) == second, L"The selected bank should fill the window");
+            Assert::IsTrue(memory.bankAt(0x7FFF) == SystemMemory::NO_BANK && memory.bankAt(0xA000) == SystemMemory::NO_BANK, L"Memory outside the window should not be banked");
+
+            memory.writeByte(0x8000, 0x99);
+            memory.selectBank(window, ram);
+            memory.writeByte(0x8000, 0x33);
+            memory.selectBank(window, first);
+            Assert::IsTrue(memory.readByte(0x8000) == 0x11, L"ROM banks should ignore writes");
+            memory.selectBank(window, ram);
+            Assert::IsTrue(memory.readByte(0x8000) == 0x33, L"RAM banks should keep their contents while switched out");
+
+            vector<uint8_t> edge(2);
+            memory.readBlock(0x7FFF, edge.data(), edge.size());
+            Assert::IsTrue(edge[0] == 0x00 && edge[1] == 0x33, L"Block reads should cross into a window");
+
+            auto throws = [&](auto install) {
+                try {
+                    install();
+                }
+                catch (runtime_error) {
+                    return true;
+                }
+                return false;
+            };
+            Assert::IsTrue(throws([&] { memory.installRAM(0x9000, 0x100); }), L"Installing over a window should throw exception");
+            Assert::IsTrue(throws([&] { memory.installBankWindow(0xC080, 0x100); }), L"A window of part pages should throw exception");
+            Assert::IsTrue(throws([&] { memory.addROMBank(window, vector<uint8_t>(0x1000)); }), L"A bank of the wrong size should throw exception");
+
+            auto other = memory.installBankWindow(0xC000, 0x100);
+            Assert::IsTrue(throws([&] { memory.selectBank(other, first); }), L"Selecting another window's bank should throw exception");
+        }
+
+    private:
+        static constexpr const char *ROM_PATH = "systemmemory_test.rom";
+
+        struct PlainLatch
+        {
+            auto read(TargetAddress addr)->uint8_t
+            {
+                return latch;
+            }
+
+            auto write(TargetAddress addr, uint8_t data)->void
+            {
+                latch = data;
+            }
+
+            uint8_t latch = 0;
+        };
+
+        class LatchDevice : public SystemMemory::IOHandler
+        {
+        public:
+            virtual auto read(TargetAddress addr)->uint8_t override
+            {
+                return latch;
+            }
+
+            virtual auto write(TargetAddress addr, uint8_t data)->void override
+            {
+                lastAddress = addr;
+                latch = data;
+            }
+
+            TargetAddress lastAddress = 0;
+            uint8_t latch = 0;
+        };
     };
 }